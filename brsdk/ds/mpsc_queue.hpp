@@ -0,0 +1,125 @@
+/**
+ * MIT License
+ *
+ * Copyright © 2021 <Jerry.Yu>.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the “Software”), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * @file mpsc_queue.hpp
+ * @brief 侵入式无锁多生产者单消费者队列
+ * @author Jerry.Yu (jerry.yu512@outlook.com)
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright MIT License
+ *
+ */
+#pragma once
+#include <stddef.h>
+#include <atomic>
+#include "brsdk/mix/noncopyable.hpp"
+
+namespace brsdk {
+
+namespace ds {
+
+/**
+ * @brief 队列节点，入队对象需要继承该节点
+ *
+ */
+struct MpscQueueNode {
+    std::atomic<MpscQueueNode*> mpsc_next_{nullptr};
+};
+
+/**
+ * @brief 侵入式无锁多生产者单消费者队列(Dmitry Vyukov)
+ * @details
+ * - push 可在任意线程调用，一次原子交换，无等待
+ * - pop/empty 只能在消费者线程调用
+ * - 节点内存由使用者管理，队列不分配内存
+ *
+ * @tparam T 节点类型，必须继承 @c MpscQueueNode
+ */
+template <typename T>
+class MpscQueue : noncopyable {
+public:
+    MpscQueue() : head_(&stub_), tail_(&stub_) {}
+
+    // 入队，多线程安全
+    void push(T* node) {
+        push_node(static_cast<MpscQueueNode*>(node));
+    }
+
+    /**
+     * @brief 出队，仅消费者线程调用
+     *
+     * @return T* 队首节点，队列为空或者生产者入队尚未完成时返回nullptr
+     */
+    T* pop(void) {
+        MpscQueueNode* tail = tail_;
+        MpscQueueNode* next = tail->mpsc_next_.load(std::memory_order_acquire);
+
+        // 跳过哨兵节点
+        if (tail == &stub_) {
+            if (nullptr == next) {
+                return nullptr;
+            }
+            tail_ = next;
+            tail = next;
+            next = next->mpsc_next_.load(std::memory_order_acquire);
+        }
+
+        if (next) {
+            tail_ = next;
+            return static_cast<T*>(tail);
+        }
+
+        // 有生产者正在入队，节点还未链接上
+        if (tail != head_.load(std::memory_order_acquire)) {
+            return nullptr;
+        }
+
+        // 最后一个节点，需要把哨兵重新入队才能取出
+        push_node(&stub_);
+        next = tail->mpsc_next_.load(std::memory_order_acquire);
+        if (next) {
+            tail_ = next;
+            return static_cast<T*>(tail);
+        }
+
+        return nullptr;
+    }
+
+    // 队列是否为空，仅消费者线程调用
+    // 生产者入队后该接口立即可见(顺序一致)，即使节点还未能pop出来
+    bool empty(void) const {
+        return tail_ == &stub_ && head_.load() == &stub_;
+    }
+
+private:
+    void push_node(MpscQueueNode* node) {
+        node->mpsc_next_.store(nullptr, std::memory_order_relaxed);
+        MpscQueueNode* prev = head_.exchange(node);
+        prev->mpsc_next_.store(node, std::memory_order_release);
+    }
+
+    alignas(64) std::atomic<MpscQueueNode*> head_;  ///< 生产者端
+    alignas(64) MpscQueueNode* tail_;               ///< 消费者端
+    MpscQueueNode stub_;                            ///< 哨兵节点
+};
+
+} // namespace ds
+
+} // namespace brsdk
@@ -0,0 +1,202 @@
+/**
+ * MIT License
+ *
+ * Copyright © 2021 <Jerry.Yu>.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the “Software”), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * @file inline_function.hpp
+ * @brief
+ * @author Jerry.Yu (jerry.yu512@outlook.com)
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright MIT License
+ *
+ */
+#pragma once
+
+#include <assert.h>
+#include <stddef.h>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace brsdk {
+
+template <typename Signature, size_t Capacity = 64>
+class InlineFunction;
+
+/**
+ * @brief 只移动的可调用对象，替代热路径上的std::function
+ * @details
+ * - 不超过Capacity字节且移动不抛异常的可调用对象直接存放在对象内部，不分配内存；
+ *   更大的对象退化为堆上分配
+ * - 只移动，可以捕获unique_ptr等只移动的对象
+ * - 由空的函数指针或者std::function构造时为空
+ *
+ * @tparam R 返回值
+ * @tparam Args 参数
+ * @tparam Capacity 内联存储字节数，默认可容纳成员函数指针+shared_ptr+std::string的bind结果
+ */
+template <typename R, typename... Args, size_t Capacity>
+class InlineFunction<R(Args...), Capacity> {
+public:
+    InlineFunction() noexcept : ops_(nullptr) {}
+    InlineFunction(std::nullptr_t) noexcept : ops_(nullptr) {}
+
+    template <typename F, class = typename std::enable_if<
+                              !std::is_same<typename std::decay<F>::type, InlineFunction>::value>::type>
+    InlineFunction(F&& f) : ops_(nullptr) {
+        assign(std::forward<F>(f));
+    }
+
+    InlineFunction(InlineFunction&& that) noexcept : ops_(nullptr) {
+        swap_in(that);
+    }
+
+    InlineFunction(const InlineFunction&) = delete;
+    InlineFunction& operator=(const InlineFunction&) = delete;
+
+    ~InlineFunction() {
+        reset();
+    }
+
+    InlineFunction& operator=(InlineFunction&& that) noexcept {
+        if (this != &that) {
+            reset();
+            swap_in(that);
+        }
+        return *this;
+    }
+
+    InlineFunction& operator=(std::nullptr_t) noexcept {
+        reset();
+        return *this;
+    }
+
+    template <typename F, class = typename std::enable_if<
+                              !std::is_same<typename std::decay<F>::type, InlineFunction>::value>::type>
+    InlineFunction& operator=(F&& f) {
+        reset();
+        assign(std::forward<F>(f));
+        return *this;
+    }
+
+    explicit operator bool() const noexcept { return ops_ != nullptr; }
+
+    // 与std::function一致，const对象也按非const调用可调用对象
+    R operator()(Args... args) const {
+        assert(ops_);
+        return ops_->invoke(const_cast<void*>(static_cast<const void*>(&storage_)), std::forward<Args>(args)...);
+    }
+
+    // 可调用对象是否内联存储
+    bool is_inline(void) const noexcept { return ops_ && ops_->inlined; }
+
+    static constexpr size_t capacity(void) { return Capacity; }
+
+private:
+    using Storage = typename std::aligned_storage<Capacity, alignof(void*)>::type;
+
+    // 按可调用对象类型生成的操作表
+    struct Ops {
+        R (*invoke)(void* storage, Args&&... args);
+        void (*move)(void* dst, void* src);     ///< 移动到dst并销毁src
+        void (*destroy)(void* storage);
+        bool inlined;
+    };
+
+    template <typename F>
+    struct InlineOps {
+        static F* get(void* s) { return static_cast<F*>(s); }
+        static R invoke(void* s, Args&&... args) { return (*get(s))(std::forward<Args>(args)...); }
+        static void move(void* dst, void* src) {
+            ::new (dst) F(std::move(*get(src)));
+            get(src)->~F();
+        }
+        static void destroy(void* s) { get(s)->~F(); }
+        static const Ops* ops(void) {
+            static const Ops o = {&invoke, &move, &destroy, true};
+            return &o;
+        }
+    };
+
+    template <typename F>
+    struct HeapOps {
+        static F*& get(void* s) { return *static_cast<F**>(s); }
+        static R invoke(void* s, Args&&... args) { return (*get(s))(std::forward<Args>(args)...); }
+        static void move(void* dst, void* src) { ::new (dst) F*(get(src)); }
+        static void destroy(void* s) { delete get(s); }
+        static const Ops* ops(void) {
+            static const Ops o = {&invoke, &move, &destroy, false};
+            return &o;
+        }
+    };
+
+    template <typename F>
+    static bool is_null(const F&) { return false; }
+    template <typename T>
+    static bool is_null(T* p) { return p == nullptr; }
+    template <typename S>
+    static bool is_null(const std::function<S>& f) { return !f; }
+
+    template <typename F>
+    void assign(F&& f) {
+        using Fn = typename std::decay<F>::type;
+        if (is_null(f)) {
+            return;
+        }
+
+        // 按是否放得下分派，放不下的类型不实例化内联构造
+        using Fits = std::integral_constant<bool, sizeof(Fn) <= Capacity && alignof(Fn) <= alignof(Storage)
+                                                      && std::is_nothrow_move_constructible<Fn>::value>;
+        emplace<Fn>(std::forward<F>(f), Fits());
+    }
+
+    template <typename Fn, typename F>
+    void emplace(F&& f, std::true_type) {
+        ::new (static_cast<void*>(&storage_)) Fn(std::forward<F>(f));
+        ops_ = InlineOps<Fn>::ops();
+    }
+
+    template <typename Fn, typename F>
+    void emplace(F&& f, std::false_type) {
+        ::new (static_cast<void*>(&storage_)) Fn*(new Fn(std::forward<F>(f)));
+        ops_ = HeapOps<Fn>::ops();
+    }
+
+    void swap_in(InlineFunction& that) noexcept {
+        if (that.ops_) {
+            that.ops_->move(&storage_, &that.storage_);
+            ops_ = that.ops_;
+            that.ops_ = nullptr;
+        }
+    }
+
+    void reset(void) noexcept {
+        if (ops_) {
+            const Ops* ops = ops_;
+            ops_ = nullptr;
+            ops->destroy(&storage_);
+        }
+    }
+
+    Storage storage_;       ///< 内联存储，放不下时存放堆对象指针
+    const Ops* ops_;        ///< 操作表，为空表示没有可调用对象
+};
+
+}  // namespace brsdk
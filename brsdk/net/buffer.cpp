@@ -29,6 +29,7 @@
 #include "buffer.hpp"
 #include <errno.h>
 #include <sys/uio.h>
+#include <memory>
 #include "socket/socket_util.hpp"
 
 namespace brsdk {
@@ -37,28 +38,80 @@ namespace net {
 
 const size_t NetBuffer::kCheapPrepend;
 const size_t NetBuffer::kInitialSize;
+const size_t NetBuffer::kSpillSize;
+const size_t NetBuffer::kMaxReadSize;
+const uint8_t NetBuffer::kGrowAfter;
+const uint8_t NetBuffer::kShrinkAfter;
+
+namespace {
+
+// 每个事件循环线程一块暂存区，首次使用时分配，不清零
+char* spill_buffer(void) {
+	static thread_local std::unique_ptr<char[]> t_spill;
+	if (!t_spill) {
+		t_spill.reset(new char[NetBuffer::kSpillSize]);
+	}
+	return t_spill.get();
+}
+
+} // namespace
+
+ssize_t NetBuffer::read_fd(int fd, int* savedErrno, bool* more) {
+	if (readable_bytes() == 0 && small_streak_ >= kShrinkAfter
+		&& buffer_.size() > kCheapPrepend + kInitialSize) {
+		// 空闲一段时间，归还扩大过的内存
+		std::vector<char>(kCheapPrepend + kInitialSize).swap(buffer_);
+		readerIdx_ = kCheapPrepend;
+		writerIdx_ = kCheapPrepend;
+		small_streak_ = 0;
+	}
 
-ssize_t NetBuffer::read_fd(int fd, int* savedErrno) {
-	char extrabuf[65536] = {0};
 	struct iovec vec[2];
 	const size_t writable = writable_bytes();
 
 	vec[0].iov_base = (void*)(begin() + writerIdx_);
 	vec[0].iov_len = writable;
-	vec[1].iov_base = extrabuf;
-	vec[1].iov_len = sizeof(extrabuf);
+	vec[1].iov_base = spill_buffer();
+	vec[1].iov_len = kSpillSize;
 
 	// 空间足够则使用buffer，否则加上额外内存
-	const int iovcnt = (writable < sizeof(extrabuf)) ? 2 : 1;
+	const int iovcnt = (writable < kSpillSize) ? 2 : 1;
 	const ssize_t n = sock_readv(fd, vec, iovcnt);
 
+	if (more) {
+		// 短读说明内核缓冲区已读空
+		size_t capacity = (iovcnt == 2) ? writable + kSpillSize : writable;
+		*more = (n > 0 && static_cast<size_t>(n) == capacity);
+	}
+
 	if (n < 0) {
 		*savedErrno = errno;
-	} else if (static_cast<size_t>(n) <= writable) {
-		writerIdx_ += n;
+		return n;
+	}
+
+	const size_t len = static_cast<size_t>(n);
+	if (len <= writable) {
+		writerIdx_ += len;
+		spill_streak_ = 0;
 	} else {
 		writerIdx_ = buffer_.size();
-		append(extrabuf, n - writable);
+		if (spill_streak_ < kGrowAfter) {
+			spill_streak_++;
+		}
+		if (spill_streak_ >= kGrowAfter) {
+			// 持续溢出，按本次读取量预留空间
+			ensure_writable_bytes(std::max(len - writable, std::min(len * 2, kMaxReadSize)));
+		}
+		append(static_cast<const char*>(vec[1].iov_base), len - writable);
+	}
+
+	// 小于buffer容量1/8的读取计为小读
+	if (len * 8 < buffer_.size() - kCheapPrepend) {
+		if (small_streak_ < kShrinkAfter) {
+			small_streak_++;
+		}
+	} else {
+		small_streak_ = 0;
 	}
 
 	return n;
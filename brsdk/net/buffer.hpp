@@ -31,6 +31,7 @@
 #include "brsdk/mix/copyable.hpp"
 #include "brsdk/mix/types.hpp"
 #include "brsdk/str/string_piece.hpp"
+#include "brsdk/str/scan.hpp"
 #include "brsdk/defs/defs.hpp"
 #include "endian.hpp"
 #include <algorithm>
@@ -62,11 +63,23 @@ public:
 	static const size_t kCheapPrepend = 8;
 	// 初始大小
 	static const size_t kInitialSize = 1024;
+	// read_fd溢出时使用的线程私有暂存区大小
+	static const size_t kSpillSize = 65536;
+	// 自适应读取时缓冲区增长的上限
+	static const size_t kMaxReadSize = 1024 * 1024;
+	// 连续溢出多少次后扩大缓冲区
+	static const uint8_t kGrowAfter = 2;
+	// 连续小读多少次后收缩缓冲区
+	static const uint8_t kShrinkAfter = 64;
 
 	explicit NetBuffer(size_t initial_size = kInitialSize) :
 		buffer_(kCheapPrepend + kInitialSize),
 		readerIdx_(kCheapPrepend),
-		writerIdx_(kCheapPrepend)
+		writerIdx_(kCheapPrepend),
+		spill_streak_(0),
+		small_streak_(0),
+		scanned_(0),
+		scan_key_(0)
 	{
 
 	}
@@ -75,6 +88,10 @@ public:
 		buffer_.swap(rhs.buffer_);
 		std::swap(readerIdx_, rhs.readerIdx_);
 		std::swap(writerIdx_, rhs.writerIdx_);
+		std::swap(spill_streak_, rhs.spill_streak_);
+		std::swap(small_streak_, rhs.small_streak_);
+		std::swap(scanned_, rhs.scanned_);
+		std::swap(scan_key_, rhs.scan_key_);
 	}
 
 	// 可读字节数
@@ -96,31 +113,61 @@ public:
 		return begin() + readerIdx_;
 	}
 
+	/**
+	 * @brief 从可读数据开头查找分隔符，可续查
+	 * @details 记录上次查找的位置，同一分隔符再次查找时只检查新追加的数据，
+	 *          等待分隔符的协议每次读事件不再从头扫描；不超过7字节的分隔符才记录
+	 *
+	 * @param delim 分隔符
+	 * @param len 分隔符长度
+	 * @return const char* 分隔符位置，未找到返回nullptr
+	 */
+	const char* find_delimiter(const char* delim, size_t len) const {
+		uint64_t key = scan_key(delim, len);
+		size_t readable = readable_bytes();
+		size_t from = (key != 0 && key == scan_key_) ? std::min(scanned_, readable) : 0;
+		const char* found = str::find_delimiter(peek() + from, begin_write(), delim, len);
+		if (key != 0) {
+			scan_key_ = key;
+			// 找到时停在分隔符处，未找到时末尾不足一个分隔符的位置还要再查
+			scanned_ = found ? static_cast<size_t>(found - peek()) : (readable >= len ? readable - len + 1 : 0);
+		}
+		return found;
+	}
+
+	const char* find_delimiter(const char* start, const char* delim, size_t len) const {
+		return str::find_delimiter(start, begin_write(), delim, len);
+	}
+
 	const char* find_CRLF(void) const {
-		const char temp[] = BRSDK_CRLF;
-		const char* crlf = std::search(peek(), begin_write(), temp, temp + 2);
-		return crlf == begin_write() ? nullptr : crlf;
+		return find_delimiter(BRSDK_CRLF, 2);
 	}
 
 	const char* find_CRLF(const char* start) const {
-		const char temp[] = BRSDK_CRLF;
-		const char* crlf = std::search(start, begin_write(), temp, temp + 2);
-		return crlf == begin_write() ? nullptr : crlf;
+		return str::find_crlf(start, begin_write());
+	}
+
+	const char* find_CRLFCRLF(void) const {
+		return find_delimiter(BRSDK_CRLF BRSDK_CRLF, 4);
+	}
+
+	const char* find_CRLFCRLF(const char* start) const {
+		return str::find_crlfcrlf(start, begin_write());
 	}
 
 	const char* find_EOL(void) const {
-		const void* eol = memchr(peek(), '\n', readable_bytes());
-		return static_cast<const char*>(eol);
+		return find_delimiter("\n", 1);
 	}
 
 	const char* find_EOL(const char* start) const {
-		const void* eol = memchr(start, '\n', readable_bytes());
+		const void* eol = memchr(start, '\n', begin_write() - start);
 		return static_cast<const char*>(eol);
 	}
 
 	void retrieve(size_t len) {
 		if (len < readable_bytes()) {
 			readerIdx_ += len;
+			scanned_ = scanned_ > len ? scanned_ - len : 0;
 		} else {
 			retrieve_all();
 		}
@@ -149,6 +196,7 @@ public:
 	void retrieve_all(void){
 		readerIdx_ = kCheapPrepend;
 		writerIdx_ = kCheapPrepend;
+		scanned_ = 0;
 	}
 
 	void append(const str::StringPiece& str) {
@@ -289,6 +337,7 @@ public:
 
 	void prepend(const void* data, size_t len) {
 		readerIdx_ -= len;
+		scanned_ = 0;
 		const char* d = static_cast<const char*>(data);
 		std::copy(d, d + len, begin() + readerIdx_);
 	}
@@ -306,14 +355,31 @@ public:
 
 	/**
 	 * @brief 读取数据到buffer内
+	 * @details
+	 * - 可写空间不足时多出的数据先读到线程私有的暂存区(不清零)，再追加到buffer
+	 * - 连续溢出时按最近一次读取量扩大buffer，后续读取直接落入buffer，省去一次拷贝
+	 * - buffer为空且连续多次读取都很小时收缩回初始大小，空闲连接不长期占用大块内存
 	 * 
 	 * @param fd fd
 	 * @param savedErrno read的错误码 @c errno
+	 * @param more 读满了本次提供的全部空间，fd中可能还有数据，可为空
 	 * @return ssize_t 
 	 */
-	ssize_t read_fd(int fd, int* savedErrno);
+	ssize_t read_fd(int fd, int* savedErrno, bool* more = nullptr);
 
 private:
+	// 续查用的分隔符标识，长度放在最高字节，超过7字节返回0不续查
+	static uint64_t scan_key(const char* delim, size_t len) {
+		if (0 == len || len > 7) {
+			return 0;
+		}
+		uint64_t key = static_cast<uint64_t>(len) << 56;
+		for (size_t i = 0; i < len; i++) {
+			key |= static_cast<uint64_t>(static_cast<uint8_t>(delim[i])) << (8 * i);
+		}
+		return key;
+	}
+
 	char *begin(void) {
 		return &*buffer_.begin();
 	}
@@ -341,6 +407,10 @@ private:
 	std::vector<char> buffer_;
 	size_t readerIdx_;
 	size_t writerIdx_;
+	uint8_t spill_streak_;	///< 连续溢出到暂存区的次数
+	uint8_t small_streak_;	///< 连续小读的次数
+	mutable size_t scanned_;	///< 可读数据开头已确认不含分隔符起点的字节数
+	mutable uint64_t scan_key_;	///< 上次查找的分隔符，0表示没有
 };
 
 } // namespace net
@@ -0,0 +1,223 @@
+/**
+ * MIT License
+ *
+ * Copyright © 2021 <Jerry.Yu>.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the “Software”), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * @file codec.cpp
+ * @brief tcp消息分帧编解码
+ * @author Jerry.Yu (jerry.yu512@outlook.com)
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright MIT License
+ *
+ */
+#include "codec.hpp"
+#include <assert.h>
+#include <string.h>
+#include <algorithm>
+#include "endian.hpp"
+#include "event/connection.hpp"
+#include "event/event_log.hpp"
+
+namespace brsdk {
+
+namespace net {
+
+const size_t FrameCodec::kDefaultMaxFrameSize;
+const size_t VarintCodec::kMaxVarintBytes;
+const size_t FrameCodec::kMaxReserveBytes;
+
+namespace {
+
+// 帧头可表示的最大长度
+size_t field_limit(int field_bytes) {
+	return field_bytes >= static_cast<int>(sizeof(size_t))
+		? static_cast<size_t>(-1)
+		: (static_cast<size_t>(1) << (8 * field_bytes)) - 1;
+}
+
+const char* error_string(FrameCodec::Error error) {
+	return error == FrameCodec::kFrameTooLarge ? "frame too large" : "bad header";
+}
+
+} // namespace
+
+FrameCodec::FrameCodec(const FrameCallback& cb, size_t max_frame_size)
+	: frameCallback_(cb),
+	  errorCallback_(nullptr),
+	  max_frame_size_(max_frame_size) {
+	// 帧视图的长度为int
+	assert(max_frame_size_ <= static_cast<size_t>(INT32_MAX));
+}
+
+void FrameCodec::OnMessage(const TcpConnectionPtr& conn, NetBuffer* buf, Timestamp receive_time) {
+	Frame frame;
+	Result result;
+	// 移出只移动读位置，不搬移数据，回调返回后逐帧移出
+	while ((result = parse(*buf, &frame)) == kComplete) {
+		if (frame.len > max_frame_size_) {
+			frame.error = kFrameTooLarge;
+			result = kError;
+			break;
+		}
+		frameCallback_(conn, str::StringPiece(buf->peek() + frame.offset, static_cast<int>(frame.len)), receive_time);
+		buf->retrieve(frame.size);
+		frame = Frame();
+	}
+
+	if (result == kError) {
+		LOG_ERROR << "FrameCodec [" << conn->name() << "] - " << error_string(frame.error);
+		buf->retrieve_all();
+		if (errorCallback_) {
+			errorCallback_(conn, frame.error);
+		} else {
+			conn->ForceClose();
+		}
+		return;
+	}
+
+	// 帧长已知时按剩余长度预留，减少帧体到达时的扩容搬移；
+	// 帧头长度来自对端，单次预留有上限，只声明不发送的帧不会占住大块内存
+	if (frame.size > buf->readable_bytes()) {
+		buf->ensure_writable_bytes(std::min(frame.size - buf->readable_bytes(), kMaxReserveBytes));
+	}
+}
+
+void FrameCodec::send(const TcpConnectionPtr& conn, const str::StringPiece& frame) const {
+	std::string out;
+	encode(frame, &out);
+	conn->send(out);
+}
+
+LengthFieldCodec::LengthFieldCodec(int field_bytes, const FrameCallback& cb, size_t max_frame_size)
+	: FrameCodec(cb, std::min(max_frame_size, field_limit(field_bytes))),
+	  field_bytes_(field_bytes) {
+	assert(field_bytes == 1 || field_bytes == 2 || field_bytes == 4 || field_bytes == 8);
+}
+
+void LengthFieldCodec::encode(const str::StringPiece& frame, std::string* out) const {
+	assert(static_cast<size_t>(frame.size()) <= max_frame_size());
+	uint64_t be64 = hostToNetwork64(static_cast<uint64_t>(frame.size()));
+	// 大端的低位字节在末尾
+	out->reserve(out->size() + field_bytes_ + frame.size());
+	out->append(reinterpret_cast<const char*>(&be64) + sizeof(be64) - field_bytes_, field_bytes_);
+	out->append(frame.data(), frame.size());
+}
+
+FrameCodec::Result LengthFieldCodec::parse(const NetBuffer& buf, Frame* frame) const {
+	const char* data = buf.peek();
+	size_t len = buf.readable_bytes();
+	size_t header = static_cast<size_t>(field_bytes_);
+	if (len < header) {
+		return kIncomplete;
+	}
+
+	uint64_t be64 = 0;
+	::memcpy(reinterpret_cast<char*>(&be64) + sizeof(be64) - header, data, header);
+	uint64_t body = networkToHost64(be64);
+	if (body > max_frame_size()) {
+		frame->error = kFrameTooLarge;
+		return kError;
+	}
+
+	frame->offset = header;
+	frame->len = static_cast<size_t>(body);
+	frame->size = header + frame->len;
+	return len < frame->size ? kIncomplete : kComplete;
+}
+
+VarintCodec::VarintCodec(const FrameCallback& cb, size_t max_frame_size)
+	: FrameCodec(cb, max_frame_size) {
+}
+
+void VarintCodec::encode(const str::StringPiece& frame, std::string* out) const {
+	char header[kMaxVarintBytes];
+	size_t n = 0;
+	uint64_t value = static_cast<uint64_t>(frame.size());
+	while (value >= 0x80) {
+		header[n++] = static_cast<char>((value & 0x7f) | 0x80);
+		value >>= 7;
+	}
+	header[n++] = static_cast<char>(value);
+	out->reserve(out->size() + n + frame.size());
+	out->append(header, n);
+	out->append(frame.data(), frame.size());
+}
+
+FrameCodec::Result VarintCodec::parse(const NetBuffer& buf, Frame* frame) const {
+	const char* data = buf.peek();
+	size_t len = buf.readable_bytes();
+	uint64_t value = 0;
+	size_t limit = std::min(len, kMaxVarintBytes);
+	for (size_t i = 0; i < limit; i++) {
+		uint8_t byte = static_cast<uint8_t>(data[i]);
+		value |= static_cast<uint64_t>(byte & 0x7f) << (7 * i);
+		if (value > max_frame_size()) {
+			// 不必等帧头收全
+			frame->error = kFrameTooLarge;
+			return kError;
+		}
+		if (0 == (byte & 0x80)) {
+			frame->offset = i + 1;
+			frame->len = static_cast<size_t>(value);
+			frame->size = frame->offset + frame->len;
+			return len < frame->size ? kIncomplete : kComplete;
+		}
+	}
+
+	if (len >= kMaxVarintBytes) {
+		frame->error = kBadHeader;
+		return kError;
+	}
+	return kIncomplete;
+}
+
+DelimiterCodec::DelimiterCodec(const std::string& delimiter, const FrameCallback& cb, size_t max_frame_size)
+	: FrameCodec(cb, max_frame_size),
+	  delimiter_(delimiter) {
+	assert(!delimiter_.empty());
+}
+
+void DelimiterCodec::encode(const str::StringPiece& frame, std::string* out) const {
+	out->reserve(out->size() + frame.size() + delimiter_.size());
+	out->append(frame.data(), frame.size());
+	out->append(delimiter_);
+}
+
+FrameCodec::Result DelimiterCodec::parse(const NetBuffer& buf, Frame* frame) const {
+	size_t dlen = delimiter_.size();
+	// 从上次查到的位置继续
+	const char* pos = buf.find_delimiter(delimiter_.data(), dlen);
+	if (pos) {
+		frame->offset = 0;
+		frame->len = static_cast<size_t>(pos - buf.peek());
+		frame->size = frame->len + dlen;
+		return kComplete;
+	}
+
+	// 分隔符之前的数据已经超长
+	if (buf.readable_bytes() >= max_frame_size() + dlen) {
+		frame->error = kFrameTooLarge;
+		return kError;
+	}
+	return kIncomplete;
+}
+
+} // namespace net
+
+} // namespace brsdk
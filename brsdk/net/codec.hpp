@@ -0,0 +1,190 @@
+/**
+ * MIT License
+ *
+ * Copyright © 2021 <Jerry.Yu>.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the “Software”), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * @file codec.hpp
+ * @brief tcp消息分帧编解码
+ * @author Jerry.Yu (jerry.yu512@outlook.com)
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright MIT License
+ *
+ */
+#pragma once
+
+#include "brsdk/mix/noncopyable.hpp"
+#include "brsdk/str/string_piece.hpp"
+#include "brsdk/time/timestamp.hpp"
+#include "brsdk/net/buffer.hpp"
+#include "brsdk/net/event/event_typedef.hpp"
+#include <stdint.h>
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace brsdk {
+
+namespace net {
+
+/**
+ * @brief 分帧编解码基类，解码结果以指向接收缓冲区的视图交给用户，不拷贝
+ * @details
+ * - 绑定为TcpServer/TcpClient的消息回调，一次读事件内的全部完整帧依次回调
+ * - 分隔符帧使用缓冲区的续查位置，未收全的帧不会在每次读事件时从头扫描
+ * - 帧视图只在回调期间有效，需要保留时自行拷贝
+ * - 已知长度但未收全的帧预留缓冲区空间(单次不超过 @c kMaxReserveBytes)，减少反复扩容
+ * - 帧长超过上限或者帧头非法时回调错误，默认记录日志并关闭连接
+ * - 编解码器本身不保存连接状态，可以被多个连接、多个loop共享
+ */
+class FrameCodec : noncopyable {
+public:
+	// 解码错误
+	enum Error {
+		kFrameTooLarge,	///< 帧长超过上限
+		kBadHeader,		///< 帧头非法
+	};
+
+	// 完整帧回调，frame仅在回调期间有效
+	using FrameCallback = std::function<void(const TcpConnectionPtr&, const str::StringPiece& frame, Timestamp)>;
+	// 解码错误回调，回调之后缓冲区中的数据被丢弃
+	using ErrorCallback = std::function<void(const TcpConnectionPtr&, Error)>;
+
+	// 默认最大帧长
+	static const size_t kDefaultMaxFrameSize = 64 * 1024 * 1024;
+	// 未收全的帧单次最多预留的缓冲区空间
+	static const size_t kMaxReserveBytes = 64 * 1024;
+
+	FrameCodec(const FrameCallback& cb, size_t max_frame_size);
+	virtual ~FrameCodec() = default;
+
+	size_t max_frame_size(void) const { return max_frame_size_; }
+	void SetErrorCallback(const ErrorCallback& cb) { errorCallback_ = cb; }
+
+	// 消息回调，绑定到TcpServer::SetMessageCallback
+	void OnMessage(const TcpConnectionPtr& conn, NetBuffer* buf, Timestamp receive_time);
+
+	// 编码一帧追加到out
+	virtual void encode(const str::StringPiece& frame, std::string* out) const = 0;
+	// 编码并发送一帧，帧头与帧体一次写出
+	void send(const TcpConnectionPtr& conn, const str::StringPiece& frame) const;
+
+protected:
+	// 单帧解析结果
+	enum Result {
+		kIncomplete,	///< 数据不足
+		kComplete,		///< 完整帧
+		kError,			///< 解码错误
+	};
+
+	/**
+	 * @brief 解析位置信息，帧位于peek() + offset，长度len，整帧(含帧头/分隔符)长度size
+	 * @details 数据不足时size为已知的整帧长度，未知为0
+	 */
+	struct Frame {
+		size_t offset = 0;	///< 帧内容偏移
+		size_t len = 0;		///< 帧内容长度
+		size_t size = 0;	///< 整帧长度
+		Error error = kBadHeader;	///< 错误原因
+	};
+
+	/**
+	 * @brief 从缓冲区可读数据开头解析一帧
+	 *
+	 * @param buf 接收缓冲区
+	 * @param frame 解析结果，位置相对于 @c buf.peek()
+	 * @return Result 解析状态
+	 */
+	virtual Result parse(const NetBuffer& buf, Frame* frame) const = 0;
+
+private:
+	FrameCallback frameCallback_;	///< 完整帧回调
+	ErrorCallback errorCallback_;	///< 解码错误回调
+	const size_t max_frame_size_;	///< 最大帧长
+};
+
+/**
+ * @brief 定长帧头编解码，帧头为1/2/4/8字节大端长度，长度不含帧头
+ */
+class LengthFieldCodec : public FrameCodec {
+public:
+	/**
+	 * @brief 构造
+	 *
+	 * @param field_bytes 帧头字节数，1/2/4/8
+	 * @param cb 完整帧回调
+	 * @param max_frame_size 最大帧长，同时受帧头可表示的范围限制
+	 */
+	LengthFieldCodec(int field_bytes, const FrameCallback& cb, size_t max_frame_size = kDefaultMaxFrameSize);
+
+	int field_bytes(void) const { return field_bytes_; }
+
+	void encode(const str::StringPiece& frame, std::string* out) const override;
+
+protected:
+	Result parse(const NetBuffer& buf, Frame* frame) const override;
+
+private:
+	const int field_bytes_;	///< 帧头字节数
+};
+
+/**
+ * @brief 变长帧头编解码，帧头为varint(每字节7位，低位在前，最高位表示后续还有字节)编码的长度
+ */
+class VarintCodec : public FrameCodec {
+public:
+	// varint最多字节数
+	static const size_t kMaxVarintBytes = 10;
+
+	explicit VarintCodec(const FrameCallback& cb, size_t max_frame_size = kDefaultMaxFrameSize);
+
+	void encode(const str::StringPiece& frame, std::string* out) const override;
+
+protected:
+	Result parse(const NetBuffer& buf, Frame* frame) const override;
+};
+
+/**
+ * @brief 分隔符编解码，帧以分隔符结束，回调的帧不含分隔符
+ * @details 常用"\n"按行、"\r\n"按CRLF行分帧；未收到分隔符前的数据超过最大帧长时报错
+ */
+class DelimiterCodec : public FrameCodec {
+public:
+	/**
+	 * @brief 构造
+	 *
+	 * @param delimiter 分隔符，非空
+	 * @param cb 完整帧回调
+	 * @param max_frame_size 最大帧长，不含分隔符
+	 */
+	DelimiterCodec(const std::string& delimiter, const FrameCallback& cb, size_t max_frame_size = kDefaultMaxFrameSize);
+
+	const std::string& delimiter(void) const { return delimiter_; }
+
+	void encode(const str::StringPiece& frame, std::string* out) const override;
+
+protected:
+	Result parse(const NetBuffer& buf, Frame* frame) const override;
+
+private:
+	const std::string delimiter_;	///< 分隔符
+};
+
+} // namespace net
+
+} // namespace brsdk
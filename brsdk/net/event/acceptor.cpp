@@ -46,6 +46,7 @@ Acceptor::Acceptor(EventLoop* loop, const Address& listenAddr, bool reuseport)
 	  idle_fd_(::open("/dev/null", O_RDONLY | O_CLOEXEC)) {
 	assert(idle_fd_ >= 0);
 	accept_socket_.SetReuseaddr(true);
+	accept_socket_.SetReusepot(reuseport);
 	accept_socket_.SetNonblock(true);
 	accept_socket_.BindAddress(listenAddr);
 	accept_channel_.SetReadCallback(std::bind(&Acceptor::HandleRead, this));
@@ -67,25 +68,38 @@ void Acceptor::listen(void) {
 
 void Acceptor::HandleRead(void) {
 	loop_->AssertInLoopThread();
-	Address peeraddr;
-	int connfd = accept_socket_.accept(peeraddr);
-	if (connfd >= 0) {
-		LOG_TRACE << "Accepts of " << peeraddr.ipport();
-		if (newConnectionCallback_) {
-			newConnectionCallback_(connfd, peeraddr);
-		} else {
-			LOG_TRACE << "Not need create new connection.";
-			sock_close(connfd);
+	// 一次读事件接受全连接队列里的所有连接，单轮设上限避免饿死其他通道
+	for (int i = 0; i < kMaxAcceptPerRound; i++) {
+		Address peeraddr;
+		// 连接由事件循环驱动，读写都不能阻塞
+		int connfd = accept_socket_.accept(peeraddr);
+		if (connfd >= 0) {
+			LOG_TRACE << "Accepts of " << peeraddr.ipport();
+			if (newConnectionCallback_) {
+				newConnectionCallback_(connfd, peeraddr);
+			} else {
+				LOG_TRACE << "Not need create new connection.";
+				sock_close(connfd);
+			}
+			continue;
+		}
+
+		int err = errno;
+		if (err == EAGAIN || err == EWOULDBLOCK) {
+			break;
 		}
-	} else {
 		LOG_SYSERR << "In Acceptor::HandleRead";
-		if (errno == EMFILE) {
-			LOG_DEBUG << strerror(errno);
+		if (err == EMFILE) {
+			LOG_DEBUG << strerror(err);
 			::close(idle_fd_);
 			idle_fd_ = ::accept(accept_socket_.fd(), nullptr, nullptr);
 			::close(idle_fd_);
 			idle_fd_ = ::open("/dev/null", O_RDONLY | O_CLOEXEC);
 		}
+		// 对端在accept前已经断开等瞬时错误继续接受，其余错误留到下一轮
+		if (err != ECONNABORTED && err != EINTR && err != EPROTO) {
+			break;
+		}
 	}
 }
 
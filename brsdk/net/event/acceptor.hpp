@@ -59,6 +59,9 @@ private:
 	// 读事件处理，对于接受器来说只有accept有连接才是读事件
 	void HandleRead(void);
 
+	// 单次读事件最多接受的连接数
+	static const int kMaxAcceptPerRound = 256;
+
 	EventLoop* loop_;
 	TcpSocket accept_socket_;		///< 接收器套接字
 	EventChannel accept_channel_;	///< 接收器通道
@@ -0,0 +1,107 @@
+/**
+ * MIT License
+ * 
+ * Copyright © 2021 <Jerry.Yu>.
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the “Software”), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * 
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ * 
+ * @file channel_table.hpp
+ * @brief fd索引的事件通道表
+ * @author Jerry.Yu (jerry.yu512@outlook.com)
+ * @version 1.0.0
+ * @date 2026-10-17
+ * 
+ * @copyright MIT License
+ * 
+ */
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+#include "brsdk/mix/noncopyable.hpp"
+
+namespace brsdk {
+
+namespace net {
+
+class EventChannel;
+
+/**
+ * @brief fd索引的事件通道表
+ * @details
+ * - fd是稠密的小整数，直接用数组下标定位，查找/注册/移除都是O(1)，接入新连接时不分配节点
+ * - 每个槽位带generation，注册与移除时递增，
+ *   轮询器把generation与fd一起交给内核，事件返回时校验，丢弃已经移除通道的过期事件
+ */
+class EventChannelTable : noncopyable {
+public:
+	EventChannelTable() : size_(0) {}
+
+	// 查找，不存在时返回nullptr
+	EventChannel* find(int fd) const {
+		return (fd >= 0 && static_cast<size_t>(fd) < slots_.size()) ? slots_[fd].channel : nullptr;
+	}
+
+	// 通道是否已经注册
+	bool contains(const EventChannel* channel, int fd) const {
+		return channel != nullptr && find(fd) == channel;
+	}
+
+	// fd当前的generation
+	uint32_t generation(int fd) const {
+		return (fd >= 0 && static_cast<size_t>(fd) < slots_.size()) ? slots_[fd].generation : 0;
+	}
+
+	// 注册，返回新的generation
+	uint32_t insert(int fd, EventChannel* channel) {
+		if (static_cast<size_t>(fd) >= slots_.size()) {
+			slots_.resize(static_cast<size_t>(fd) + 1 > slots_.size() * 2 ? static_cast<size_t>(fd) + 1 : slots_.size() * 2);
+		}
+		Slot& slot = slots_[fd];
+		if (nullptr == slot.channel) {
+			size_++;
+		}
+		slot.channel = channel;
+		return ++slot.generation;
+	}
+
+	// 移除，返回移除的数量
+	size_t erase(int fd) {
+		if (nullptr == find(fd)) {
+			return 0;
+		}
+		Slot& slot = slots_[fd];
+		slot.channel = nullptr;
+		slot.generation++;
+		size_--;
+		return 1;
+	}
+
+	// 已注册通道数
+	size_t size(void) const { return size_; }
+
+private:
+	struct Slot {
+		EventChannel* channel = nullptr;	///< 通道
+		uint32_t generation = 0;			///< 注册代数
+	};
+
+	std::vector<Slot> slots_;	///< fd索引的槽位
+	size_t size_;				///< 已注册通道数
+};
+
+} // namespace net
+
+} // namespace brsdk
@@ -0,0 +1,366 @@
+/**
+ * MIT License
+ *
+ * Copyright © 2021 <Jerry.Yu>.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the “Software”), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * @file co_connection.cpp
+ * @brief 连接协程，同步风格的连接处理
+ * @author Jerry.Yu (jerry.yu512@outlook.com)
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright MIT License
+ *
+ */
+#include "co_connection.hpp"
+#include <assert.h>
+#include <limits.h>
+#include <algorithm>
+#include <exception>
+#include <memory>
+#include "brsdk/co/_co.h"
+#include "brsdk/mix/noncopyable.hpp"
+#include "connection.hpp"
+#include "event_log.hpp"
+#include "event_loop.hpp"
+#include "tcp_client.hpp"
+#include "tcp_server.hpp"
+
+namespace brsdk {
+
+namespace net {
+
+using namespace std::placeholders;
+
+namespace {
+
+// 协程栈上限
+const size_t kCoMaxStack = 8 * 1024 * 1024;
+
+// 连接协程状态，保存在连接的context中
+struct CoTask : noncopyable, public std::enable_shared_from_this<CoTask> {
+	// 挂起原因
+	enum Wait {
+		kNone,		///< 运行中或者未挂起
+		kRead,		///< 等待输入
+		kWrite,		///< 等待发送完
+		kSleep,		///< 等待定时器
+	};
+
+	CoTask(EventLoop* l, const std::shared_ptr<CoConnectionHandler>& h) : loop(l), handler(h) {}
+
+	// 输入是否满足挂起时的条件
+	bool readable(NetBuffer* buf) const {
+		if (delim.empty()) {
+			return buf->readable_bytes() >= need;
+		}
+		return buf->readable_bytes() >= need || buf->find_delimiter(delim.data(), delim.size());
+	}
+
+	EventLoop* loop;			///< 连接所属loop
+	std::shared_ptr<CoConnectionHandler> handler;	///< 处理函数，所有连接共享
+	TcpConnectionPtr conn;		///< 协程启动前持有连接，启动后转到协程栈上
+	co_t* co = nullptr;			///< 协程，结束后为空
+	Wait wait = kNone;			///< 挂起原因
+	size_t need = 0;			///< kRead时需要的字节数，读分隔符时为溢出长度
+	str::StringPiece delim;		///< kRead时等待的分隔符，指向协程栈上的数据
+	bool fired = false;			///< co_sleep的定时器已触发
+	bool closed = false;		///< 连接已断开
+	bool done = false;			///< 处理函数已返回
+	bool throttled = false;		///< 输入积压暂停了读取
+};
+
+using CoTaskPtr = std::shared_ptr<CoTask>;
+
+/**
+ * @brief 每个loop线程一个调度器，只用底层的协程切换，何时恢复由loop的事件决定
+ */
+class CoLoop : noncopyable {
+public:
+	CoLoop() : sch_(nullptr), running_(nullptr) {
+		co_schedule_conf_t conf = {
+			ULONG_MAX,
+			kCoDefaultStack,
+			kCoMaxStack,
+			4096,
+			nullptr,
+			nullptr,
+			nullptr,
+		};
+		sch_ = co_creat(&conf, &CoLoop::entry, this);
+		assert(sch_);
+	}
+
+	~CoLoop() {
+		// 仍挂起的协程只释放栈
+		co_destroy(sch_);
+	}
+
+	static CoLoop* current(void) {
+		static thread_local std::unique_ptr<CoLoop> t_loop;
+		if (!t_loop) {
+			t_loop.reset(new CoLoop());
+		}
+		return t_loop.get();
+	}
+
+	CoTask* running(void) const { return running_; }
+
+	bool spawn(const CoTaskPtr& task, size_t stack_size) {
+		task->co = co_new(sch_, &CoLoop::run, stack_size, nullptr, task.get());
+		if (nullptr == task->co) {
+			return false;
+		}
+		resume(task);
+		return true;
+	}
+
+	void resume(const CoTaskPtr& task) {
+		if (nullptr == task->co) {
+			return;
+		}
+		if (running_) {
+			// 协程内同步触发的回调(如关闭连接)，回到loop后再恢复
+			task->loop->QueueInLoop(std::bind(&CoLoop::resume, this, task));
+			return;
+		}
+		// task可能在协程内被释放
+		CoTaskPtr guard(task);
+		running_ = task.get();
+		task->wait = CoTask::kNone;
+		co_resume(sch_, task->co);
+		running_ = nullptr;
+		if (task->done) {
+			// 协程已结束，栈已释放
+			task->co = nullptr;
+		}
+	}
+
+	void suspend(CoTask* task, CoTask::Wait wait) {
+		assert(task == running_);
+		task->wait = wait;
+		co_yield(sch_);
+	}
+
+private:
+	// 调度器不主动运行
+	static int entry(co_schedule_t*, void*) { return 0; }
+
+	static void run(co_schedule_t*, void* ud) {
+		CoTask* task = static_cast<CoTask*>(ud);
+		TcpConnectionPtr conn;
+		conn.swap(task->conn);
+		bool ok = true;
+		try {
+			(*task->handler)(conn);
+		} catch (const std::exception& e) {
+			LOG_ERROR << "CoConnection [" << conn->name() << "] - " << e.what();
+			ok = false;
+		} catch (...) {
+			LOG_ERROR << "CoConnection [" << conn->name() << "] - unknown exception";
+			ok = false;
+		}
+		if (task->throttled) {
+			// 之后的输入直接丢弃，继续读才能感知对端关闭
+			task->throttled = false;
+			conn->ThrottleRead(false);
+		}
+		task->done = true;
+		ok ? conn->shutdown() : conn->ForceClose();
+	}
+
+	co_schedule_t* sch_;	///< 底层调度器
+	CoTask* running_;		///< 正在运行的协程
+};
+
+CoTaskPtr task_of(const TcpConnectionPtr& conn) {
+	Any* context = conn->context();
+	if (!context->Is<CoTaskPtr>()) {
+		return CoTaskPtr();
+	}
+	return context->AnyCast<CoTaskPtr>();
+}
+
+// 当前协程，必须是conn自己的协程
+CoTask* current_task(const TcpConnectionPtr& conn) {
+	CoTask* task = CoLoop::current()->running();
+	assert(task);
+	assert(task == task_of(conn).get());
+	(void)conn;
+	return task;
+}
+
+// 挂起等待输入，积压暂停的读取在这里恢复
+void wait_read(CoTask* task, const TcpConnectionPtr& conn) {
+	if (task->throttled) {
+		task->throttled = false;
+		conn->ThrottleRead(false);
+	}
+	CoLoop::current()->suspend(task, CoTask::kRead);
+}
+
+void on_connection(const std::shared_ptr<CoConnectionHandler>& handler, size_t stack_size,
+				   const TcpConnectionPtr& conn) {
+	if (conn->connected()) {
+		CoTaskPtr task = std::make_shared<CoTask>(conn->GetLoop(), handler);
+		task->conn = conn;
+		conn->set_context(task);
+		if (!CoLoop::current()->spawn(task, stack_size)) {
+			LOG_ERROR << "CoConnection [" << conn->name() << "] - create coroutine failed";
+			conn->set_context(Any());
+			conn->ForceClose();
+		}
+		return;
+	}
+
+	CoTaskPtr task = task_of(conn);
+	if (!task) {
+		return;
+	}
+	task->closed = true;
+	if (CoTask::kRead == task->wait || CoTask::kWrite == task->wait) {
+		CoLoop::current()->resume(task);
+	}
+}
+
+void on_message(const TcpConnectionPtr& conn, NetBuffer* buf, Timestamp) {
+	CoTaskPtr task = task_of(conn);
+	if (!task || task->done) {
+		buf->retrieve_all();
+		return;
+	}
+	if (CoTask::kRead == task->wait) {
+		if (task->readable(buf)) {
+			CoLoop::current()->resume(task);
+		}
+		return;
+	}
+	// 协程在做别的事情，输入积压过多时暂停读取
+	if (!task->throttled && buf->readable_bytes() >= kCoReadLimit) {
+		task->throttled = true;
+		conn->ThrottleRead(true);
+	}
+}
+
+void on_write_complete(const TcpConnectionPtr& conn) {
+	CoTaskPtr task = task_of(conn);
+	if (task && CoTask::kWrite == task->wait) {
+		CoLoop::current()->resume(task);
+	}
+}
+
+void on_timer(const CoTaskPtr& task) {
+	task->fired = true;
+	if (CoTask::kSleep == task->wait) {
+		CoLoop::current()->resume(task);
+	}
+}
+
+} // namespace
+
+void co_serve(TcpServer* server, const CoConnectionHandler& handler, size_t stack_size) {
+	std::shared_ptr<CoConnectionHandler> h = std::make_shared<CoConnectionHandler>(handler);
+	server->SetConnectionCallback(std::bind(&on_connection, h, stack_size, _1));
+	server->SetMessageCallback(&on_message);
+	server->SetWriteCompleteCallback(&on_write_complete);
+}
+
+void co_serve(TcpClient* client, const CoConnectionHandler& handler, size_t stack_size) {
+	std::shared_ptr<CoConnectionHandler> h = std::make_shared<CoConnectionHandler>(handler);
+	client->SetConnectionCallback(std::bind(&on_connection, h, stack_size, _1));
+	client->SetMessageCallback(&on_message);
+	client->SetWriteCompleteCallback(&on_write_complete);
+}
+
+bool co_fill(const TcpConnectionPtr& conn, size_t n) {
+	CoTask* task = current_task(conn);
+	NetBuffer* buf = conn->input_buffer();
+	while (buf->readable_bytes() < n) {
+		if (task->closed) {
+			return false;
+		}
+		task->need = n;
+		task->delim.clear();
+		wait_read(task, conn);
+	}
+	return true;
+}
+
+std::string co_read(const TcpConnectionPtr& conn, size_t n) {
+	co_fill(conn, n);
+	NetBuffer* buf = conn->input_buffer();
+	size_t len = std::min(n, buf->readable_bytes());
+	std::string data(buf->peek(), len);
+	buf->retrieve(len);
+	return data;
+}
+
+bool co_read_until(const TcpConnectionPtr& conn, const str::StringPiece& delim, std::string* out, size_t max) {
+	assert(!delim.empty());
+	CoTask* task = current_task(conn);
+	NetBuffer* buf = conn->input_buffer();
+	size_t dlen = static_cast<size_t>(delim.size());
+	for (;;) {
+		const char* pos = buf->find_delimiter(delim.data(), dlen);
+		if (pos) {
+			size_t len = static_cast<size_t>(pos - buf->peek());
+			if (len > max) {
+				return false;
+			}
+			out->assign(buf->peek(), len);
+			buf->retrieve(len + dlen);
+			return true;
+		}
+		if (task->closed || buf->readable_bytes() >= max + dlen) {
+			return false;
+		}
+		task->need = max + dlen;
+		task->delim = delim;
+		wait_read(task, conn);
+	}
+}
+
+bool co_write(const TcpConnectionPtr& conn, const str::StringPiece& data) {
+	CoTask* task = current_task(conn);
+	if (task->closed || !conn->connected()) {
+		return false;
+	}
+	conn->send(data.data(), data.size());
+	while (conn->output_chain()->readable_bytes() > kCoWriteLimit) {
+		if (task->closed) {
+			return false;
+		}
+		CoLoop::current()->suspend(task, CoTask::kWrite);
+	}
+	return !task->closed;
+}
+
+void co_sleep(double seconds) {
+	CoLoop* sched = CoLoop::current();
+	CoTask* task = sched->running();
+	assert(task);
+	task->fired = false;
+	// 定时器持有协程状态，连接先释放也不影响
+	task->loop->RunAfter(seconds, std::bind(&on_timer, task->shared_from_this()));
+	while (!task->fired) {
+		sched->suspend(task, CoTask::kSleep);
+	}
+}
+
+} // namespace net
+
+} // namespace brsdk
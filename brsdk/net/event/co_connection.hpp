@@ -0,0 +1,135 @@
+/**
+ * MIT License
+ *
+ * Copyright © 2021 <Jerry.Yu>.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the “Software”), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * @file co_connection.hpp
+ * @brief 连接协程，同步风格的连接处理
+ * @author Jerry.Yu (jerry.yu512@outlook.com)
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright MIT License
+ *
+ */
+#pragma once
+
+#include <stddef.h>
+#include <functional>
+#include <string>
+#include "brsdk/str/string_piece.hpp"
+#include "event_typedef.hpp"
+
+namespace brsdk {
+
+namespace net {
+
+class TcpServer;
+class TcpClient;
+
+/**
+ * @brief 连接协程处理函数，连接建立后在协程中运行，返回后关闭连接
+ * @details
+ * - 每个连接一个协程，挂在连接所属loop线程的调度器上，不额外占用线程
+ * - co_read/co_write/co_sleep挂起当前协程，由读事件、写完成事件、定时器在loop中恢复，
+ *   挂起期间loop照常处理其他连接
+ * - 协程只在loop回调里恢复，同一loop上的协程不会并发，访问loop内的数据不需要加锁
+ * - 连接断开后挂起中的读写立即返回失败，已收到的数据仍可读完
+ * - 协程模式占用连接的context；处理函数抛出的异常被记录并强制关闭连接
+ * - 协程栈不会展开，loop退出时仍挂起的协程中的局部对象不析构，处理函数应在读写失败后返回
+ */
+using CoConnectionHandler = std::function<void(const TcpConnectionPtr&)>;
+
+// 连接协程默认栈大小
+const size_t kCoDefaultStack = 128 * 1024;
+// 发送队列超过该长度时co_write挂起，直到发送完
+const size_t kCoWriteLimit = 64 * 1024;
+// 协程没有在读时输入缓冲超过该长度暂停读取，再次读取时恢复
+const size_t kCoReadLimit = 4 * 1024 * 1024;
+
+/**
+ * @brief 服务端连接以协程方式处理，在start之前调用，替换连接、消息、写完成回调
+ *
+ * @param server 服务端
+ * @param handler 处理函数，每个连接一个协程
+ * @param stack_size 协程栈大小
+ */
+void co_serve(TcpServer* server, const CoConnectionHandler& handler, size_t stack_size = kCoDefaultStack);
+
+/**
+ * @brief 客户端连接以协程方式处理，在connect之前调用，重连后的新连接运行新的协程
+ *
+ * @param client 客户端
+ * @param handler 处理函数
+ * @param stack_size 协程栈大小
+ */
+void co_serve(TcpClient* client, const CoConnectionHandler& handler, size_t stack_size = kCoDefaultStack);
+
+// 以下接口只能在conn自己的协程中调用
+
+/**
+ * @brief 挂起直到输入缓冲区至少有n字节，数据留在 @c conn->input_buffer() 中，可以直接解析
+ *
+ * @param conn 连接
+ * @param n 字节数
+ * @return true 数据已足够
+ * @return false 连接已断开且数据不足
+ */
+bool co_fill(const TcpConnectionPtr& conn, size_t n);
+
+/**
+ * @brief 读取n字节
+ *
+ * @param conn 连接
+ * @param n 字节数
+ * @return std::string 数据，连接断开时不足n字节，为空表示读到结尾
+ */
+std::string co_read(const TcpConnectionPtr& conn, size_t n);
+
+/**
+ * @brief 读取到分隔符为止，分隔符被移出但不放入out
+ *
+ * @param conn 连接
+ * @param delim 分隔符，非空
+ * @param out 分隔符之前的数据
+ * @param max 分隔符之前的最大长度
+ * @return true 读到分隔符
+ * @return false 连接断开或者超过max，数据仍留在输入缓冲区
+ */
+bool co_read_until(const TcpConnectionPtr& conn, const str::StringPiece& delim, std::string* out,
+				   size_t max = 64 * 1024);
+
+/**
+ * @brief 发送数据，发送队列超过 @c kCoWriteLimit 时挂起到发送完
+ *
+ * @param conn 连接
+ * @param data 数据
+ * @return true 成功
+ * @return false 连接已断开
+ */
+bool co_write(const TcpConnectionPtr& conn, const str::StringPiece& data);
+
+/**
+ * @brief 挂起当前协程，由loop定时器恢复
+ *
+ * @param seconds 秒
+ */
+void co_sleep(double seconds);
+
+} // namespace net
+
+} // namespace brsdk
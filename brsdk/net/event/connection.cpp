@@ -30,13 +30,19 @@
 #include "event_loop.hpp"
 #include "connection.hpp"
 #include "event_channel.hpp"
+#include "tls.hpp"
 #include "brsdk/mix/weak_callback.hpp"
 #include <errno.h>
+#include <unistd.h>
+#include <algorithm>
 
 namespace brsdk {
 
 namespace net {
 
+const size_t TcpConnection::kTlsFileChunk;
+const size_t TcpConnection::kTlsFileBatch;
+
 void TcpConnection::DefaultConnectionCallback(const TcpConnectionPtr& conn) {
 	LOG_TRACE << conn->local_addr_.ipport() << " -> "
 			  << conn->peer_addr_.ipport() << " is "
@@ -56,7 +62,17 @@ TcpConnection::TcpConnection(EventLoop* loop, const std::string& name, int sockf
 	  channel_(new EventChannel(loop, sockfd)),
 	  local_addr_(local_addr),
 	  peer_addr_(peer_addr),
-	  high_water_mark_(64 * 1024 * 1024) {
+	  high_water_mark_(64 * 1024 * 1024),
+	  backpressure_high_(0),
+	  backpressure_low_(0),
+	  backpressure_(false),
+	  throttles_(0),
+	  paused_accounted_(false),
+	  paused_us_(0),
+	  edge_triggered_(false),
+	  read_budget_(kDefaultReadBudget),
+	  tls_files_bytes_(0),
+	  outbound_(nullptr) {
 	// 事件处理接口
 	channel_->SetReadCallback(std::bind(&TcpConnection::HandleRead, this, _1));
 	channel_->SetWriteCallback(std::bind(&TcpConnection::HandleWrite, this));
@@ -70,6 +86,8 @@ TcpConnection::~TcpConnection() {
 	LOG_DEBUG << "TcpConnection::destructor[" << name_
 			  << "] at " << this << " state=" << StateToString();
 	assert(state_ == kDisconnected);
+	DropOutbound();
+	DropTlsFiles();
 }
 
 bool TcpConnection::GetTcpInfo(struct tcp_info* info) const {
@@ -87,32 +105,191 @@ void TcpConnection::send(const void* message, int len) {
 		if (loop_->IsInLoopThread()) {
 			SendInLoop(message, len);
 		} else {
-			void (TcpConnection::*fp)(const std::string &message) = &TcpConnection::SendInLoop;
-			loop_->RunInLoop(std::bind(fp, this, std::string((const char*)message, len)));
+			OutboundMessage* out = new OutboundMessage();
+			out->data.assign(static_cast<const char*>(message), len);
+			PostOutbound(out);
 		}
 	}
 }
 
 void TcpConnection::send(const std::string& message) {
+	send(message.data(), static_cast<int>(message.size()));
+}
+
+void TcpConnection::send(NetBuffer* message) {
 	if (state_ == kConnected) {
 		if (loop_->IsInLoopThread()) {
-			SendInLoop(message);
+			SendInLoop(message->peek(), message->readable_bytes());
+			message->retrieve_all();
 		} else {
-			void (TcpConnection::*fp)(const std::string &message) = &TcpConnection::SendInLoop;
-			loop_->RunInLoop(std::bind(fp, this, message));
+			send(std::move(*message));
 		}
 	}
 }
 
-void TcpConnection::send(NetBuffer* message) {
+void TcpConnection::send(NetBuffer&& message) {
+	if (state_ != kConnected) {
+		return;
+	}
+
+	if (message.readable_bytes() < kCopyThreshold) {
+		send(message.peek(), static_cast<int>(message.readable_bytes()));
+		message.retrieve_all();
+	} else {
+		// 交换出内容，调用者得到新的空缓冲区
+		std::unique_ptr<NetBuffer> owned(new NetBuffer());
+		owned->swap(message);
+		send(std::move(owned));
+	}
+}
+
+void TcpConnection::send(std::unique_ptr<NetBuffer> message) {
+	if (state_ == kConnected && message && message->readable_bytes() > 0) {
+		if (loop_->IsInLoopThread()) {
+			SendBufferInLoop(std::move(message));
+		} else {
+			OutboundMessage* out = new OutboundMessage();
+			out->buffer = std::move(message);
+			PostOutbound(out);
+		}
+	}
+}
+
+void TcpConnection::send(const OutputChain::Block& message) {
+	if (state_ == kConnected && message && !message->empty()) {
+		if (loop_->IsInLoopThread()) {
+			SendBlockInLoop(message);
+		} else {
+			OutboundMessage* out = new OutboundMessage();
+			out->block = message;
+			PostOutbound(out);
+		}
+	}
+}
+
+void TcpConnection::send(const str::StringPiece& message, const OutputChain::ReleaseCallback& release) {
 	if (state_ == kConnected) {
 		if (loop_->IsInLoopThread()) {
-			SendInLoop(message->peek(), message->readable_bytes());
-			message->retrieve_all();
+			SendBorrowedInLoop(message, release);
+		} else {
+			OutboundMessage* out = new OutboundMessage();
+			out->borrowed = message;
+			out->release = release;
+			PostOutbound(out);
+		}
+	} else if (release) {
+		release();
+	}
+}
+
+void TcpConnection::SendFile(int fd, off_t offset, size_t len, const OutputChain::ReleaseCallback& release) {
+	if (state_ == kConnected) {
+		if (loop_->IsInLoopThread()) {
+			SendFileInLoop(fd, offset, len, release);
 		} else {
-			void (TcpConnection::*fp)(const std::string &message) = &TcpConnection::SendInLoop;
-			loop_->RunInLoop(std::bind(fp, this, message->retrieve_all_string()));
+			OutboundMessage* out = new OutboundMessage();
+			out->fd = fd;
+			out->offset = offset;
+			out->len = len;
+			out->release = release;
+			PostOutbound(out);
 		}
+	} else if (release) {
+		release();
+	}
+}
+
+void TcpConnection::PostOutbound(OutboundMessage* message) {
+	OutboundMessage* head = outbound_.load(std::memory_order_relaxed);
+	do {
+		message->next = head;
+	} while (!outbound_.compare_exchange_weak(head, message, std::memory_order_release,
+											  std::memory_order_relaxed));
+	// 栈原本为空时投递处理回调，之后的请求由同一次回调一起处理
+	if (nullptr == head) {
+		loop_->QueueInLoop(std::bind(&TcpConnection::DrainOutbound, shared_from_this()));
+	}
+}
+
+TcpConnection::OutboundMessage* TcpConnection::TakeOutbound(void) {
+	OutboundMessage* head = outbound_.exchange(nullptr, std::memory_order_acquire);
+	// 栈顶是最新的请求，反转为投递顺序
+	OutboundMessage* ordered = nullptr;
+	while (head) {
+		OutboundMessage* next = head->next;
+		head->next = ordered;
+		ordered = head;
+		head = next;
+	}
+	return ordered;
+}
+
+void TcpConnection::DrainOutbound(void) {
+	loop_->AssertInLoopThread();
+	if (state_ == kDisconnected) {
+		DropOutbound();
+		return;
+	}
+
+	// 全部请求先入发送队列，最后一次写出，多个小消息合并为一次writev
+	bool idle = !WritePending() && output_chain_.empty();
+	size_t oldlen = QueuedBytes();
+	OutboundMessage* message = TakeOutbound();
+	while (message) {
+		OutboundMessage* next = message->next;
+		if (state_ == kDisconnected) {
+			// 处理过程中连接出错断开
+			if (message->release) {
+				message->release();
+			}
+		} else if (tls_ && message->fd < 0) {
+			// 明文加密后入队
+			if (message->buffer) {
+				EncryptOrQueueInLoop(message->buffer->peek(), message->buffer->readable_bytes());
+			} else if (message->block) {
+				EncryptOrQueueInLoop(message->block->data(), message->block->size());
+			} else if (message->release || message->borrowed.size() > 0) {
+				EncryptOrQueueInLoop(message->borrowed.data(), static_cast<size_t>(message->borrowed.size()));
+			} else {
+				EncryptOrQueueInLoop(message->data.data(), message->data.size());
+			}
+			if (message->release) {
+				message->release();
+			}
+		} else if (message->buffer) {
+			if (message->buffer->readable_bytes() < kCopyThreshold) {
+				output_chain_.append(message->buffer->peek(), message->buffer->readable_bytes());
+			} else {
+				AppendBuffer(std::move(message->buffer), 0);
+			}
+		} else if (message->block) {
+			AppendBlock(message->block, 0);
+		} else if (message->fd >= 0) {
+			SendFileInLoop(message->fd, message->offset, message->len, message->release);
+		} else if (message->release || message->borrowed.size() > 0) {
+			// 队列非空时只会追加到队尾，顺序不变
+			SendBorrowedInLoop(message->borrowed, message->release);
+		} else if (message->data.size() < OutputChain::kCoalesceSize) {
+			output_chain_.append(message->data.data(), message->data.size());
+		} else {
+			output_chain_.append(std::move(message->data));
+		}
+		delete message;
+		message = next;
+	}
+
+	FlushQueued(idle, oldlen, true);
+}
+
+void TcpConnection::DropOutbound(void) {
+	OutboundMessage* message = TakeOutbound();
+	while (message) {
+		OutboundMessage* next = message->next;
+		if (message->release) {
+			message->release();
+		}
+		delete message;
+		message = next;
 	}
 }
 
@@ -123,50 +300,419 @@ void TcpConnection::SendInLoop(const std::string& message) {
 
 void TcpConnection::SendInLoop(const void* message, size_t len) {
 	loop_->AssertInLoopThread();
-	ssize_t nwrite = 0;
-	size_t remaining = len;
-	bool fault_error = false;
+	if (tls_) {
+		SendTlsInLoop(message, len);
+		return;
+	}
+	size_t nwrite = 0;
+	if (!WriteDirect(message, len, &nwrite)) {
+		return;
+	}
+
+	if (nwrite < len) {
+		// 剩下的部分放到发送队列内
+		size_t oldlen = QueuedBytes();
+		output_chain_.append(static_cast<const char*>(message) + nwrite, len - nwrite);
+		QueueOutput(oldlen);
+	}
+}
+
+void TcpConnection::SendBufferInLoop(std::unique_ptr<NetBuffer> message) {
+	loop_->AssertInLoopThread();
+	size_t len = message->readable_bytes();
+	if (tls_) {
+		SendTlsInLoop(message->peek(), len);
+		return;
+	}
+	size_t nwrite = 0;
+	if (!WriteDirect(message->peek(), len, &nwrite) || nwrite == len) {
+		return;
+	}
+
+	size_t oldlen = QueuedBytes();
+	AppendBuffer(std::move(message), nwrite);
+	QueueOutput(oldlen);
+}
+
+void TcpConnection::SendBlockInLoop(const OutputChain::Block& message) {
+	loop_->AssertInLoopThread();
+	size_t len = message->size();
+	if (tls_) {
+		SendTlsInLoop(message->data(), len);
+		return;
+	}
+	size_t nwrite = 0;
+	if (!WriteDirect(message->data(), len, &nwrite) || nwrite == len) {
+		return;
+	}
+
+	size_t oldlen = QueuedBytes();
+	AppendBlock(message, nwrite);
+	QueueOutput(oldlen);
+}
+
+void TcpConnection::AppendBlock(const OutputChain::Block& message, size_t offset) {
+	size_t len = message->size() - offset;
+	if (len < kCopyThreshold) {
+		// 小消息引用共享块时每条占一个iovec，积压时拷贝合并到队尾数据块
+		output_chain_.append(message->data() + offset, len);
+	} else {
+		output_chain_.append(message, offset, len);
+	}
+}
+
+void TcpConnection::AppendBuffer(std::unique_ptr<NetBuffer> message, size_t offset) {
+	NetBuffer* buffer = message.release();
+	str::StringPiece data(buffer->peek() + offset, static_cast<int>(buffer->readable_bytes() - offset));
+	output_chain_.append(data, [buffer] { delete buffer; });
+}
+
+void TcpConnection::SendBorrowedInLoop(const str::StringPiece& message, const OutputChain::ReleaseCallback& release) {
+	loop_->AssertInLoopThread();
+	size_t len = static_cast<size_t>(message.size());
+	size_t nwrite = 0;
+	if (tls_) {
+		// 加密后的数据与原内存无关，可以立即释放
+		SendTlsInLoop(message.data(), len);
+		if (release) {
+			release();
+		}
+		return;
+	}
+	if (!WriteDirect(message.data(), len, &nwrite) || nwrite == len) {
+		if (release) {
+			release();
+		}
+		return;
+	}
+
+	// 剩下的部分以借用方式入队，不拷贝
+	size_t oldlen = QueuedBytes();
+	output_chain_.append(str::StringPiece(message.data() + nwrite, static_cast<int>(len - nwrite)), release);
+	QueueOutput(oldlen);
+}
+
+void TcpConnection::SendFileInLoop(int fd, off_t offset, size_t len, const OutputChain::ReleaseCallback& release) {
+	loop_->AssertInLoopThread();
+	if (state_ == kDisconnected) {
+		LOG_WARN << "Disconnected, give up writing";
+		if (release) {
+			release();
+		}
+		return;
+	}
+
+	if (tls_) {
+		SendFileTlsInLoop(fd, offset, len, release);
+		return;
+	}
+
+	bool idle = !WritePending() && output_chain_.empty();
+	size_t oldlen = QueuedBytes();
+	output_chain_.AppendFile(fd, offset, len, release);
+	// 队列原本为空时先尝试直接发送
+	FlushQueued(idle, oldlen, true);
+}
+
+void TcpConnection::SendTlsInLoop(const void* message, size_t len) {
 	if (state_ == kDisconnected) {
 		LOG_WARN << "Disconnected, give up writing";
 		return;
 	}
 
-	if (!channel_->iswriting() && output_buffer_.readable_bytes() == 0) {
-		nwrite = socket_->write(message, len);
-		if (nwrite >= 0) {
-			// 剩下的部分
-			remaining = len - nwrite;
-			if (remaining == 0 && writeCompleteCallback_) {
+	bool idle = !WritePending() && output_chain_.empty();
+	size_t oldlen = QueuedBytes();
+	if (EncryptOrQueueInLoop(message, len)) {
+		FlushQueued(idle, oldlen, true);
+	}
+}
+
+void TcpConnection::SendFileTlsInLoop(int fd, off_t offset, size_t len, const OutputChain::ReleaseCallback& release) {
+	// 加密需要明文，不能sendfile/splice，按偏移分块读出；不可seek的fd读取会阻塞loop，不支持
+	if (::lseek(fd, 0, SEEK_CUR) < 0) {
+		LOG_SYSERR << "TcpConnection::SendFileTlsInLoop [" << name_ << "] - fd " << fd << " is not seekable";
+		if (release) {
+			release();
+		}
+		ForceClose();
+		return;
+	}
+	if (0 == len) {
+		if (release) {
+			release();
+		}
+		return;
+	}
+
+	bool idle = !WritePending() && output_chain_.empty();
+	size_t oldlen = QueuedBytes();
+	TlsFileSlice slice;
+	slice.fd = fd;
+	slice.offset = offset;
+	slice.len = len;
+	slice.release = release;
+	tls_files_.push_back(std::move(slice));
+	tls_files_bytes_ += len;
+	// 只加密第一批，其余等发送队列写空后补充
+	FlushQueued(idle, oldlen, true);
+}
+
+bool TcpConnection::EncryptInLoop(const void* message, size_t len) {
+	if (tls_->encrypt(message, len)) {
+		return true;
+	}
+	LOG_ERROR << "TcpConnection::EncryptInLoop [" << name_ << "] - " << tls_->error();
+	ForceClose();
+	return false;
+}
+
+bool TcpConnection::EncryptOrQueueInLoop(const void* message, size_t len) {
+	if (tls_files_.empty()) {
+		return EncryptInLoop(message, len);
+	}
+	if (tls_files_.back().fd >= 0) {
+		tls_files_.push_back(TlsFileSlice());
+	}
+	tls_files_.back().data.append(static_cast<const char*>(message), len);
+	tls_files_bytes_ += len;
+	return true;
+}
+
+bool TcpConnection::FillTlsInLoop(void) {
+	// 握手完成前加密的数据只会暂存，握手完成后再读取文件
+	if (tls_files_.empty() || !tls_->established() || state_ == kDisconnected) {
+		return false;
+	}
+
+	size_t before = output_chain_.readable_bytes();
+	std::unique_ptr<char[]> chunk;
+	while (!tls_files_.empty() && output_chain_.readable_bytes() - before < kTlsFileBatch) {
+		TlsFileSlice& slice = tls_files_.front();
+		if (slice.fd < 0) {
+			std::string data;
+			data.swap(slice.data);
+			tls_files_bytes_ -= data.size();
+			tls_files_.pop_front();
+			if (!EncryptInLoop(data.data(), data.size())) {
+				DropTlsFiles();
+				return false;
+			}
+			continue;
+		}
+
+		if (!chunk) {
+			chunk.reset(new char[kTlsFileChunk]);
+		}
+		ssize_t n = ::pread(slice.fd, chunk.get(), std::min(slice.len, kTlsFileChunk), slice.offset);
+		if (n < 0 && errno == EINTR) {
+			continue;
+		}
+		if (n <= 0) {
+			// 已经发出了部分内容，无法再保持数据完整，只能关闭
+			LOG_SYSERR << "TcpConnection::FillTlsInLoop [" << name_ << "] - " << slice.len << " bytes left";
+			DropTlsFiles();
+			ForceClose();
+			return false;
+		}
+		if (!EncryptInLoop(chunk.get(), static_cast<size_t>(n))) {
+			DropTlsFiles();
+			return false;
+		}
+		slice.offset += n;
+		slice.len -= static_cast<size_t>(n);
+		tls_files_bytes_ -= static_cast<size_t>(n);
+		if (0 == slice.len) {
+			OutputChain::ReleaseCallback release;
+			release.swap(slice.release);
+			tls_files_.pop_front();
+			if (release) {
+				release();
+			}
+		}
+	}
+	return output_chain_.readable_bytes() > before;
+}
+
+void TcpConnection::DropTlsFiles(void) {
+	std::deque<TlsFileSlice> files;
+	files.swap(tls_files_);
+	tls_files_bytes_ = 0;
+	for (size_t i = 0; i < files.size(); ++i) {
+		if (files[i].release) {
+			files[i].release();
+		}
+	}
+}
+
+void TcpConnection::FlushQueued(bool idle, size_t oldlen, bool notify) {
+	if ((output_chain_.empty() && tls_files_.empty()) || state_ == kDisconnected) {
+		return;
+	}
+	if (idle) {
+		if (!FlushOutput() && (errno == EPIPE || errno == ECONNRESET)) {
+			return;
+		}
+		ReleaseBackpressure();
+		if (output_chain_.empty() && tls_files_.empty()) {
+			if (notify && writeCompleteCallback_) {
 				loop_->QueueInLoop(std::bind(writeCompleteCallback_, shared_from_this()));
 			}
+			return;
+		}
+	}
+	QueueOutput(oldlen);
+}
+
+bool TcpConnection::WriteDirect(const void* message, size_t len, size_t* nwrite) {
+	*nwrite = 0;
+	if (state_ == kDisconnected) {
+		LOG_WARN << "Disconnected, give up writing";
+		return false;
+	}
+
+	// 已有数据排队时只能追加到队尾，保证顺序
+	if (WritePending() || !output_chain_.empty()) {
+		return true;
+	}
+
+	ssize_t n = socket_->write(message, len);
+	if (n < 0) {
+		LOG_SYSERR << "TcpConnection::SendInLoop";
+		if (errno == EPIPE || errno == ECONNRESET) {
+			return false;
+		}
+		return true;
+	}
+
+	*nwrite = static_cast<size_t>(n);
+	if (*nwrite == len && writeCompleteCallback_) {
+		loop_->QueueInLoop(std::bind(writeCompleteCallback_, shared_from_this()));
+	}
+	return true;
+}
+
+bool TcpConnection::FlushOutput(void) {
+	// 一次写出可能止于数据片类型的边界而发送缓冲区未满，
+	// 边沿触发时不会再有写事件，需要写到队列为空或者没有进展为止；
+	// TLS文件区间在队列写空后补充下一批
+	while (!output_chain_.empty() || FillTlsInLoop()) {
+		size_t before = output_chain_.readable_bytes();
+		int errno_back = 0;
+		if (output_chain_.WriteTo(socket_->fd(), &errno_back) < 0) {
+			errno = errno_back;
+			LOG_SYSERR << "TcpConnection::FlushOutput";
+			return false;
+		}
+		if (output_chain_.readable_bytes() == before) {
+			break;
+		}
+	}
+	return true;
+}
+
+void TcpConnection::QueueOutput(size_t oldlen) {
+	size_t newlen = QueuedBytes();
+	// 发送队列的数据过多需要进行通知应用层，排查原因
+	if (newlen >= high_water_mark_
+		&& oldlen < high_water_mark_
+		&& highWaterMarkCallback_) {
+		loop_->QueueInLoop(std::bind(highWaterMarkCallback_, shared_from_this(), newlen));
+	}
+	// 积压超过流控高水位，暂停读端，不再继续产生待发送数据
+	if (backpressure_high_ > 0 && newlen >= backpressure_high_ && !backpressure_) {
+		backpressure_ = true;
+		TcpConnectionPtr peer = backpressure_peer_.lock();
+		if (peer) {
+			peer->ThrottleRead(true);
 		} else {
-			nwrite = 0;
-			if (errno == EWOULDBLOCK) {
-				LOG_SYSERR << "TcpConnection::SendInLoop";
-				if (errno == EPIPE || errno == ECONNRESET) {
-					fault_error = true;
-				}
-			}
+			ThrottleReadInLoop(true);
 		}
 	}
+	if (!channel_->iswriting()) {
+		channel_->EnableWriting();
+	}
+}
+
+void TcpConnection::ReleaseBackpressure(bool force) {
+	if (!backpressure_ || (!force && QueuedBytes() > backpressure_low_)) {
+		return;
+	}
+
+	backpressure_ = false;
+	TcpConnectionPtr peer = backpressure_peer_.lock();
+	if (peer) {
+		peer->ThrottleRead(false);
+	} else {
+		ThrottleReadInLoop(false);
+	}
+}
+
+void TcpConnection::SetBackpressure(size_t high, size_t low) {
+	assert(state_ == kConnecting);
+	backpressure_high_ = high;
+	backpressure_low_ = std::min(low, high);
+}
+
+void TcpConnection::SetBackpressurePeer(const TcpConnectionPtr& peer) {
+	// 已暂停的读端先恢复，再切换
+	ReleaseBackpressure(true);
+	backpressure_peer_ = peer;
+}
+
+void TcpConnection::ThrottleRead(bool pause) {
+	loop_->RunInLoop(std::bind(&TcpConnection::ThrottleReadInLoop, shared_from_this(), pause));
+}
 
-	assert(remaining <= len);
-	if (!fault_error && remaining > 0) {
-		size_t oldlen = output_buffer_.readable_bytes();
-		// 发送缓冲区的数据过多需要进行通知应用层，排查原因
-		if ((oldlen + remaining) >= high_water_mark_
-			&& oldlen < high_water_mark_
-			&& highWaterMarkCallback_) {
-			loop_->QueueInLoop(std::bind(highWaterMarkCallback_, shared_from_this(), oldlen + remaining));
+void TcpConnection::ThrottleReadInLoop(bool pause) {
+	loop_->AssertInLoopThread();
+	if (pause) {
+		if (throttles_++ > 0 || state_ == kDisconnected) {
+			return;
 		}
-		// 剩下的部分放到发送缓冲区内
-		output_buffer_.append(static_cast<const char*>(message) + nwrite, remaining);
-		if (!channel_->iswriting()) {
-			channel_->EnableWriting();
+		paused_since_ = Timestamp::now();
+		paused_accounted_ = true;
+		loop_->AddReadPaused(1, 0);
+		if (channel_->isreading()) {
+			channel_->disableReading();
+		}
+		return;
+	}
+
+	if (throttles_ == 0 || --throttles_ > 0) {
+		return;
+	}
+
+	SettleReadPaused();
+	if (state_ == kDisconnected) {
+		return;
+	}
+	if (reading_ && !channel_->isreading()) {
+		channel_->EnableReading();
+		// 边沿触发下暂停期间到达的数据不会再有边沿，主动读一轮
+		if (edge_triggered_) {
+			loop_->QueueInLoop(std::bind(&TcpConnection::ContinueReadInLoop, shared_from_this()));
 		}
 	}
 }
 
+void TcpConnection::SettleReadPaused(void) {
+	// 断开后才请求的暂停没有计入统计
+	if (!paused_accounted_) {
+		return;
+	}
+	paused_accounted_ = false;
+	int64_t paused = Timestamp::now().microSecondsSinceEpoch() - paused_since_.microSecondsSinceEpoch();
+	paused_us_ += paused;
+	loop_->AddReadPaused(-1, paused);
+}
+
+int64_t TcpConnection::read_paused_us(void) const {
+	if (paused_accounted_) {
+		return paused_us_ + Timestamp::now().microSecondsSinceEpoch() - paused_since_.microSecondsSinceEpoch();
+	}
+	return paused_us_;
+}
+
 void TcpConnection::shutdown(void) {
 	if (state_ == kConnected) {
 		set_state(kDisconnecting);
@@ -177,8 +723,16 @@ void TcpConnection::shutdown(void) {
 // 关闭
 void TcpConnection::ShutDownInLoop(void) {
 	loop_->AssertInLoopThread();
+	// 有文件区间未加密完时等写完再关闭
+	if (!tls_files_.empty()) {
+		return;
+	}
+	// TLS连接先发送close_notify，写出后再关闭写端
+	if (tls_ && !WritePending() && tls_->close()) {
+		FlushQueued(true, 0, false);
+	}
 	// 有数据需要发送就不能关闭掉
-	if (!channel_->iswriting()) {
+	if (!WritePending()) {
 		socket_->ShutdownWrite();
 	}
 }
@@ -204,6 +758,26 @@ void TcpConnection::ForceCloseWithDelay(double seconds) {
 	}
 }
 
+void TcpConnection::SetEdgeTriggered(bool on, size_t read_budget) {
+	assert(state_ == kConnecting);
+	edge_triggered_ = on && loop_->SupportsEdgeTriggered();
+	read_budget_ = read_budget > 0 ? read_budget : kDefaultReadBudget;
+	channel_->SetEdgeTriggered(edge_triggered_);
+}
+
+bool TcpConnection::WritePending(void) const {
+	// 边沿触发时写事件常驻，以发送缓冲区判断
+	if (edge_triggered_) {
+		return channel_->iswriting() && !output_chain_.empty();
+	}
+	return channel_->iswriting();
+}
+
+void TcpConnection::StartTls(const std::shared_ptr<TlsContext>& ctx, const std::string& server_name) {
+	assert(state_ == kConnecting);
+	tls_.reset(new TlsStream(ctx, &output_chain_, peer_addr_.ipport(), server_name));
+}
+
 void TcpConnection::SetNoDelay(bool on) {
 	socket_->SetNodelay(on);
 }
@@ -241,8 +815,21 @@ void TcpConnection::ConnectEstablished(void) {
 	set_state(kConnected);
 	// 建立连接后就使能读数据
 	channel_->tie(shared_from_this());
-	channel_->EnableReading();
+	if (edge_triggered_) {
+		channel_->EnableReadingAndWriting();
+	} else {
+		channel_->EnableReading();
+	}
+	// 建立前已被流控暂停
+	if (throttles_ > 0) {
+		channel_->disableReading();
+	}
 
+	if (tls_) {
+		// 握手完成后再回调，客户端先发出ClientHello
+		HandleInput(Timestamp::now());
+		return;
+	}
 	connectionCallback_(shared_from_this());
 }
 
@@ -255,16 +842,29 @@ void TcpConnection::ConnectDestroyed(void) {
 		connectionCallback_(shared_from_this());
 	}
 	LOG_TRACE << "Disconnect.";
+	// 未发送的数据不再发送，尽早归还借用的内存
+	DropOutbound();
+	DropTlsFiles();
+	output_chain_.clear();
+	// 解除对读端的流控，结算自身暂停时间
+	ReleaseBackpressure(true);
+	SettleReadPaused();
+	throttles_ = 0;
 	// 从轮询器中删除channel
 	channel_->remove();
 }
 
 void TcpConnection::HandleRead(Timestamp receive_time) {
 	loop_->AssertInLoopThread();
+	if (edge_triggered_) {
+		HandleReadEdge(receive_time);
+		return;
+	}
+
 	int errno_back = 0;
-	ssize_t n = input_buffer_.read_fd(socket_->fd(), &errno_back);
+	ssize_t n = ReadTarget()->read_fd(socket_->fd(), &errno_back);
 	if (n > 0) {
-		messageCallback_(shared_from_this(), &input_buffer_, receive_time);
+		HandleInput(receive_time);
 	} else if (n == 0) {
 		LOG_INFO << "No data.";
 		HandleClose();
@@ -275,26 +875,110 @@ void TcpConnection::HandleRead(Timestamp receive_time) {
 	}
 }
 
+void TcpConnection::HandleReadEdge(Timestamp receive_time) {
+	size_t budget = read_budget_;
+
+	while (channel_->isreading()) {
+		int errno_back = 0;
+		bool more = false;
+		ssize_t n = ReadTarget()->read_fd(socket_->fd(), &errno_back, &more);
+		if (n > 0) {
+			HandleInput(receive_time);
+			if (!more) {
+				// 已读空，等待下一次边沿
+				break;
+			}
+			if (static_cast<size_t>(n) >= budget) {
+				// 预算耗尽，先处理其他就绪通道
+				loop_->QueueInLoop(std::bind(&TcpConnection::ContinueReadInLoop, shared_from_this()));
+				break;
+			}
+			budget -= n;
+		} else if (n == 0) {
+			LOG_INFO << "No data.";
+			HandleClose();
+			break;
+		} else if (errno_back == EAGAIN || errno_back == EWOULDBLOCK) {
+			break;
+		} else if (errno_back != EINTR) {
+			errno = errno_back;
+			LOG_SYSERR << "TcpConnection::HandleReadEdge";
+			HandleError();
+			break;
+		}
+	}
+}
+
+NetBuffer* TcpConnection::ReadTarget(void) {
+	return tls_ ? tls_->cipher_input() : &input_buffer_;
+}
+
+void TcpConnection::HandleInput(Timestamp receive_time) {
+	if (!tls_) {
+		messageCallback_(shared_from_this(), &input_buffer_, receive_time);
+		return;
+	}
+
+	bool idle = !WritePending() && output_chain_.empty();
+	size_t oldlen = QueuedBytes();
+	bool handshaking = !tls_->established();
+	size_t n = 0;
+	TlsStream::Result result = tls_->handshake();
+	if (result == TlsStream::kDone) {
+		result = tls_->decrypt(&input_buffer_, &n);
+	}
+	// 握手消息与告警先写出
+	FlushQueued(idle, oldlen, false);
+	if (result == TlsStream::kError) {
+		LOG_ERROR << "TcpConnection::HandleInput [" << name_ << "] - tls " << tls_->error();
+		HandleClose();
+		return;
+	}
+
+	if (handshaking && tls_->established()) {
+		LOG_DEBUG << "TcpConnection::HandleInput [" << name_ << "] - " << tls_->version()
+				  << (tls_->resumed() ? " resumed" : " full handshake");
+		connectionCallback_(shared_from_this());
+	}
+	if (n > 0 && state_ != kDisconnected) {
+		messageCallback_(shared_from_this(), &input_buffer_, receive_time);
+	}
+	if (result == TlsStream::kClosed && state_ != kDisconnected) {
+		// 回应close_notify，尽力写出后关闭
+		if (!WritePending() && tls_->close()) {
+			FlushQueued(true, 0, false);
+		}
+		HandleClose();
+	}
+}
+
+void TcpConnection::ContinueReadInLoop(void) {
+	loop_->AssertInLoopThread();
+	if (state_ == kConnected || state_ == kDisconnecting) {
+		HandleReadEdge(Timestamp::now());
+	}
+}
+
 void TcpConnection::HandleWrite(void) {
 	loop_->AssertInLoopThread();
-	if (channel_->iswriting()) {
-		ssize_t n = socket_->write(output_buffer_.peek(), output_buffer_.readable_bytes());
-		if (n > 0) {
-			output_buffer_.retrieve(n);
-			// 数据发送结束就停止写事件
-			if (output_buffer_.readable_bytes() == 0) {
+	if (WritePending()) {
+		// 数据发送结束就停止写事件
+		bool flushed = FlushOutput();
+		ReleaseBackpressure();
+		if (flushed && output_chain_.empty()) {
+			// 边沿触发时写事件常驻
+			if (!edge_triggered_) {
 				channel_->DisableWriting();
-				if (writeCompleteCallback_) {
-					loop_->QueueInLoop(std::bind(writeCompleteCallback_, shared_from_this()));
-				}
-				if (state_ == kDisconnecting) {
-					ShutDownInLoop();
-				}
 			}
-		} else {
-			LOG_SYSERR << "TcpConnection::HandleWrite";
+			// 握手消息写完不算发送完成
+			if (writeCompleteCallback_ && (!tls_ || (tls_->established() && tls_files_.empty()))) {
+				loop_->QueueInLoop(std::bind(writeCompleteCallback_, shared_from_this()));
+			}
+			if (state_ == kDisconnecting) {
+				ShutDownInLoop();
+			}
 		}
-	} else {
+	} else if (!channel_->iswriting()) {
 		LOG_TRACE << "Connection fd = " << socket_->fd() << " is down, no more writing";
 	}
 }
@@ -305,6 +989,8 @@ void TcpConnection::HandleClose(void) {
 	assert(state_ == kConnected || state_ == kDisconnecting);
 	set_state(kDisconnected);
 	channel_->DisableAll();
+	// 发送队列不会再写出，恢复被暂停的读端
+	ReleaseBackpressure(true);
 
 	TcpConnectionPtr guard(shared_from_this());
 	connectionCallback_(guard);
@@ -320,9 +1006,10 @@ void TcpConnection::HandleError(void) {
 // 接收
 void TcpConnection::StartReadInLoop(void) {
 	loop_->AssertInLoopThread();
-	if (!reading_ || !channel_->isreading()) {
+	reading_ = true;
+	// 流控暂停中由流控恢复时再使能
+	if (0 == throttles_ && !channel_->isreading()) {
 		channel_->EnableReading();
-		reading_ = true;
 	}
 }
 
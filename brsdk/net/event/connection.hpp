@@ -33,17 +33,22 @@
 #include "brsdk/mix/types.hpp"
 #include "brsdk/str/string_piece.hpp"
 #include "brsdk/net/socket/address.hpp"
+#include "brsdk/net/output_chain.hpp"
 #include "tcp_sock.hpp"
 #include "event_typedef.hpp"
 
 #include <netinet/tcp.h>
 #include <memory>
 #include <list>
+#include <deque>
 
 namespace brsdk {
 
 namespace net {
 
+class TlsContext;
+class TlsStream;
+
 // class Connection : noncopyable, public std::enable_shared_from_this<Connection> {
 // public:
 // 	virtual ~Connection();
@@ -79,9 +84,44 @@ public:
 	bool GetTcpInfo(struct tcp_info* info) const;
 	std::string GetTcpInfoString(void);
 	// 发送
+	// 其他线程调用时数据进入连接的无锁发送队列，多次发送合并为一次唤醒与一次writev
 	void send(const void* message, int len);
 	void send(const std::string& message);
+	// 其他线程调用时较大的缓冲区交换出内容，不拷贝，message被清空
 	void send(NetBuffer* message);
+	/**
+	 * @brief 移交缓冲区发送，不拷贝数据，发送完成或者连接关闭后释放
+	 * @details 调用后message为空缓冲区，可以继续使用；
+	 *          小于 @c kCopyThreshold 的数据直接拷贝，合并到发送队列的数据块中
+	 *
+	 * @param message 缓冲区
+	 */
+	void send(NetBuffer&& message);
+	// 移交缓冲区发送，不拷贝数据，发送完成或者连接关闭后释放
+	void send(std::unique_ptr<NetBuffer> message);
+	// 共享数据块发送，发送队列只引用数据块，多个连接发送同一消息时只有一份数据；
+	// 积压时小于 @c kCopyThreshold 的消息仍拷贝合并
+	void send(const OutputChain::Block& message);
+	/**
+	 * @brief 借用发送，不拷贝数据，发送完成或者连接关闭后调用release
+	 * @details message指向的内存在release调用前必须保持有效，release可能在任意发送线程或者事件循环线程调用
+	 *
+	 * @param message 数据
+	 * @param release 释放回调
+	 */
+	void send(const str::StringPiece& message, const OutputChain::ReleaseCallback& release);
+	/**
+	 * @brief 零拷贝发送文件区间，普通文件使用sendfile，其他类型经由管道splice
+	 * @details 计入发送队列，同样触发高水位与发送完成回调；
+	 *          fd由调用者管理，release调用前不能关闭，release可能在任意发送线程或者事件循环线程调用
+	 *
+	 * @param fd 文件描述符
+	 * @param offset 起始偏移，不可seek的fd忽略
+	 * @param len 长度
+	 * @param release 发送完成或者连接关闭后的释放回调，可为空
+	 */
+	void SendFile(int fd, off_t offset, size_t len,
+				  const OutputChain::ReleaseCallback& release = OutputChain::ReleaseCallback());
 	// 关闭
 	void shutdown(void);
 	void ForceClose(void);
@@ -94,6 +134,58 @@ public:
 	// 数据读取中
 	bool reading(void) const { return reading_; }
 
+	/**
+	 * @brief 发送队列流控，需在连接建立前设置
+	 * @details 发送队列超过高水位时自动暂停读取(设置了关联连接时暂停关联连接的读取)，
+	 *          写出到低水位以下后恢复，快速生产者面对慢速消费者时发送队列不再无限增长
+	 *
+	 * @param high 高水位，0关闭流控
+	 * @param low 低水位，不大于高水位
+	 */
+	void SetBackpressure(size_t high, size_t low);
+	/**
+	 * @brief 关联的读端连接，代理场景下本连接发送队列积压时暂停对端连接的读取
+	 * @details 在本连接loop线程内或者连接建立前调用，关联连接可以属于其他loop
+	 *
+	 * @param peer 读端连接
+	 */
+	void SetBackpressurePeer(const TcpConnectionPtr& peer);
+	/**
+	 * @brief 流控暂停/恢复读取，可嵌套，全部恢复后才重新读取，线程安全
+	 * @details 与 @c StopRead 相互独立，用户停止的读取不会被流控恢复
+	 *
+	 * @param pause 暂停或者恢复
+	 */
+	void ThrottleRead(bool pause);
+	// 是否被流控暂停读取，loop线程内调用
+	bool read_throttled(void) const { return throttles_ > 0; }
+	// 累计被流控暂停读取的时间(微秒)，loop线程内调用
+	int64_t read_paused_us(void) const;
+
+	/**
+	 * @brief 边沿触发模式，需在连接建立前设置，轮询器不支持时保持水平触发
+	 * @details 写事件常驻不再反复开关；读事件一次读到EAGAIN，
+	 *          单轮读取超过预算后让出，留到下一轮继续读取
+	 *
+	 * @param on 是否使能
+	 * @param read_budget 单轮最多读取的字节数
+	 */
+	void SetEdgeTriggered(bool on, size_t read_budget = kDefaultReadBudget);
+	bool edge_triggered(void) const { return edge_triggered_; }
+
+	/**
+	 * @brief 使能TLS，需在连接建立前设置
+	 * @details 握手完成后才调用连接回调，握手失败直接关闭连接；
+	 *          发送的明文加密后进入发送队列，写出方式与流控不变；
+	 *          SendFile在发送队列写空后逐块读取文件加密，只支持可seek的fd，其他fd关闭连接
+	 *
+	 * @param ctx TLS配置，服务端配置执行accept，客户端配置执行connect
+	 * @param server_name 客户端的服务器名，用于SNI与证书主机名校验
+	 */
+	void StartTls(const std::shared_ptr<TlsContext>& ctx, const std::string& server_name = std::string());
+	// TLS状态，未使能时为nullptr
+	const TlsStream* tls(void) const { return tls_.get(); }
+
 	void set_context(const Any& context) {
 		context_ = context;
 	}
@@ -121,8 +213,13 @@ public:
 		closeCallback_ = cb;
 	}
 
+	// 边沿触发默认单轮读取预算
+	static const size_t kDefaultReadBudget = 256 * 1024;
+	// 小于该长度的缓冲区拷贝发送，拷贝比持有整个缓冲区更省
+	static const size_t kCopyThreshold = 4 * 1024;
+
 	NetBuffer* input_buffer(void) { return &input_buffer_; }
-	NetBuffer* output_buffer(void) { return &output_buffer_; }
+	OutputChain* output_chain(void) { return &output_chain_; }
 
 	// 建立先连接,accept成功时
 	void ConnectEstablished(void);
@@ -139,20 +236,104 @@ private:
 
 	// 读事件
 	void HandleRead(Timestamp receive_time);
+	// 边沿触发读取，读空或者预算耗尽为止
+	void HandleReadEdge(Timestamp receive_time);
+	// 预算耗尽后的下一轮读取
+	void ContinueReadInLoop(void);
+	// 读取的目标缓冲区，TLS连接读入待解密的密文
+	NetBuffer* ReadTarget(void);
+	// 收到新数据，TLS连接先推进握手并解密
+	void HandleInput(Timestamp receive_time);
 	void HandleWrite(void);
 	void HandleClose(void);
 	void HandleError(void);
 	
+	/**
+	 * @brief 其他线程投递的发送请求，按投递顺序在loop线程内处理
+	 */
+	struct OutboundMessage {
+		OutboundMessage* next = nullptr;	///< 链表中较早投递的请求
+		std::unique_ptr<NetBuffer> buffer;	///< 移交的缓冲区
+		std::string data;					///< 拷贝的数据
+		OutputChain::Block block;			///< 共享数据块
+		str::StringPiece borrowed;			///< 借用数据
+		int fd = -1;						///< 文件描述符，非文件请求为-1
+		off_t offset = 0;					///< 文件起始偏移
+		size_t len = 0;						///< 文件区间长度
+		OutputChain::ReleaseCallback release;	///< 借用数据/文件的释放回调
+	};
+
+	/**
+	 * @brief TLS连接待加密的文件区间，发送队列写空后逐块读取加密
+	 * @details fd为-1时是排在文件之后的明文，保证发送顺序
+	 */
+	struct TlsFileSlice {
+		int fd = -1;						///< 文件描述符
+		off_t offset = 0;					///< 下一块的文件偏移
+		size_t len = 0;						///< 剩余长度
+		OutputChain::ReleaseCallback release;	///< 文件的释放回调
+		std::string data;					///< 排队的明文
+	};
+
+	// TLS文件单次读取加密的长度，一条TLS记录
+	static const size_t kTlsFileChunk = 16 * 1024;
+	// 发送队列写空后单次补充的加密数据上限
+	static const size_t kTlsFileBatch = 64 * 1024;
+
 	// 发送
 	void SendInLoop(const std::string& message);
 	void SendInLoop(const void* message, size_t len);
+	void SendBufferInLoop(std::unique_ptr<NetBuffer> message);
+	void SendBlockInLoop(const OutputChain::Block& message);
+	// 共享块剩余数据入队，较小的拷贝合并
+	void AppendBlock(const OutputChain::Block& message, size_t offset);
+	// 缓冲区剩余数据以借用方式入队，发送完成后释放
+	void AppendBuffer(std::unique_ptr<NetBuffer> message, size_t offset);
+	// 其他线程的发送请求入栈，由空变为非空时唤醒loop一次
+	void PostOutbound(OutboundMessage* message);
+	// 一次取出全部发送请求，按投递顺序返回
+	OutboundMessage* TakeOutbound(void);
+	// loop线程内处理全部发送请求，合并后一次写出
+	void DrainOutbound(void);
+	// 丢弃未处理的发送请求
+	void DropOutbound(void);
+	void SendBorrowedInLoop(const str::StringPiece& message, const OutputChain::ReleaseCallback& release);
+	void SendFileInLoop(int fd, off_t offset, size_t len, const OutputChain::ReleaseCallback& release);
+	// TLS连接加密后发送
+	void SendTlsInLoop(const void* message, size_t len);
+	void SendFileTlsInLoop(int fd, off_t offset, size_t len, const OutputChain::ReleaseCallback& release);
+	// 加密后追加到发送队列，失败时关闭连接
+	bool EncryptInLoop(const void* message, size_t len);
+	// 有文件区间未加密完时明文排在其后，否则直接加密
+	bool EncryptOrQueueInLoop(const void* message, size_t len);
+	// 从待加密的文件区间补充一批加密数据，返回是否有新数据入队
+	bool FillTlsInLoop(void);
+	// 丢弃待加密的文件区间并释放
+	void DropTlsFiles(void);
+	// 待写出的字节数，包括待加密的文件区间
+	size_t QueuedBytes(void) const { return output_chain_.readable_bytes() + tls_files_bytes_; }
+	// 新入队的数据写出，idle为入队前是否没有数据在等待写出，notify为写完时是否回调发送完成
+	void FlushQueued(bool idle, size_t oldlen, bool notify);
+	// 发送队列为空时直接写出，返回false表示连接已不可写
+	bool WriteDirect(const void* message, size_t len, size_t* nwrite);
+	// 写出发送队列，直到队列为空或者发送缓冲区满，返回false表示写出失败
+	bool FlushOutput(void);
+	// 剩余数据入队后的高水位检查与写事件使能
+	void QueueOutput(size_t oldlen);
 	// 接收
 	void StartReadInLoop(void);
 	void StopReadInLoop(void);
+	void ThrottleReadInLoop(bool pause);
+	// 结算本次暂停时间，只撤销已计入的统计
+	void SettleReadPaused(void);
+	// 发送队列低于低水位时解除流控，force为true时无条件解除
+	void ReleaseBackpressure(bool force = false);
 	// 关闭
 	void ShutDownInLoop(void);
 	// 强制关闭
 	void ForceCloseInLoop(void);
+	// 是否有数据在等待写事件
+	bool WritePending(void) const;
 	void set_state(StateE s) { state_ = s; }
 	const char* StateToString(void) const;
 
@@ -171,8 +352,22 @@ private:
 	TcpHighWaterMarkCallbak highWaterMarkCallback_;
 	TcpCloseCallbak closeCallback_;
 	size_t high_water_mark_;
+	size_t backpressure_high_;		///< 流控高水位，0不使用
+	size_t backpressure_low_;		///< 流控低水位
+	bool backpressure_;				///< 发送队列积压，已暂停读端
+	std::weak_ptr<TcpConnection> backpressure_peer_;	///< 流控暂停的读端连接，为空时暂停自身
+	int throttles_;					///< 流控暂停计数
+	bool paused_accounted_;			///< 本次暂停已计入loop统计
+	Timestamp paused_since_;		///< 本次暂停开始时间
+	int64_t paused_us_;				///< 累计暂停时间(微秒)
+	bool edge_triggered_;			///< 边沿触发
+	size_t read_budget_;			///< 边沿触发单轮读取预算
 	NetBuffer input_buffer_;		///< 接收缓冲区
-	NetBuffer output_buffer_;		///< 发送缓冲区
+	OutputChain output_chain_;		///< 发送队列
+	std::unique_ptr<TlsStream> tls_;	///< TLS状态，未使能时为空
+	std::deque<TlsFileSlice> tls_files_;	///< TLS连接待加密的文件区间
+	size_t tls_files_bytes_;		///< 待加密的文件区间与明文的字节数
+	std::atomic<OutboundMessage*> outbound_;	///< 其他线程投递的发送请求，无锁栈，最新的在栈顶
 	Any context_;					///< 用户数据
 	Timestamp creation_time_;		///< 连接创建时间
 	Timestamp last_recvive_time_;	///< 上次数据接收使时间
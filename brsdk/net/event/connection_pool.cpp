@@ -0,0 +1,271 @@
+/**
+ * MIT License
+ *
+ * Copyright © 2021 <Jerry.Yu>.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the “Software”), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * @file connection_pool.cpp
+ * @brief tcp连接池
+ * @author Jerry.Yu (jerry.yu512@outlook.com)
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright MIT License
+ *
+ */
+#include "connection_pool.hpp"
+#include <assert.h>
+#include <algorithm>
+#include "event_log.hpp"
+#include "connector.hpp"
+#include "connection.hpp"
+#include "event_loop.hpp"
+#include "tcp_client.hpp"
+
+namespace brsdk {
+
+namespace net {
+
+namespace {
+
+// 维护定时器间隔，秒
+const double kMaintainInterval = 1.0;
+
+} // namespace
+
+// 一个连接位置，断开后重连仍使用同一位置
+struct TcpConnectionPool::Slot {
+	TcpConnectorPtr connector;	///< 连接器
+	TcpConnectionPtr conn;		///< 连接，未建立时为空
+	size_t outstanding = 0;		///< 在途请求数
+	Timestamp last_active;		///< 最近一次取用或归还的时间
+	TimerId reconnect_timer;	///< 重连定时器
+	bool reconnecting = false;	///< 等待重连
+	int backoff_ms = 0;			///< 下次重连间隔
+};
+
+TcpConnectionPool::TcpConnectionPool(EventLoop* loop, const Address& server, const std::string& name,
+									 const Options& options)
+	: loop_(loop),
+	  server_(server),
+	  name_(name),
+	  options_(options),
+	  started_(false),
+	  next_conn_id_(1),
+	  connectionCallback_(TcpConnection::DefaultConnectionCallback),
+	  messageCallback_(TcpConnection::DefaultMessageCallback) {
+	assert(options_.min_connections <= options_.max_connections);
+}
+
+TcpConnectionPool::~TcpConnectionPool() {
+	if (started_) {
+		loop_->cancel(maintain_timer_);
+	}
+	for (auto& slot : slots_) {
+		if (slot->reconnecting) {
+			loop_->cancel(slot->reconnect_timer);
+		}
+		if (slot->conn) {
+			AbandonConnection(loop_, slot->conn);
+		} else if (slot->connector) {
+			AbandonConnector(loop_, slot->connector);
+		}
+	}
+}
+
+void TcpConnectionPool::start(void) {
+	loop_->AssertInLoopThread();
+	assert(!started_);
+	started_ = true;
+	last_health_check_ = Timestamp::now();
+	maintain_timer_ = loop_->RunEvery(kMaintainInterval, std::bind(&TcpConnectionPool::maintain, this));
+	while (slots_.size() < options_.min_connections) {
+		grow();
+	}
+}
+
+TcpConnectionPtr TcpConnectionPool::acquire(void) {
+	loop_->AssertInLoopThread();
+	Slot* best = nullptr;
+	for (auto& slot : slots_) {
+		if (slot->conn && slot->conn->connected()
+			&& (nullptr == best || slot->outstanding < best->outstanding)) {
+			best = slot.get();
+			if (0 == best->outstanding) {
+				break;
+			}
+		}
+	}
+
+	// 没有空闲连接时后台扩充，等待中的连接也算在内
+	if ((nullptr == best || best->outstanding > 0) && slots_.size() < options_.max_connections) {
+		bool pending = false;
+		for (auto& slot : slots_) {
+			if (!slot->conn) {
+				pending = true;
+				break;
+			}
+		}
+		if (!pending) {
+			grow();
+		}
+	}
+
+	if (nullptr == best) {
+		return TcpConnectionPtr();
+	}
+	++best->outstanding;
+	best->last_active = Timestamp::now();
+	return best->conn;
+}
+
+void TcpConnectionPool::release(const TcpConnectionPtr& conn) {
+	Slot* slot = find(conn);
+	if (slot && slot->outstanding > 0) {
+		--slot->outstanding;
+		slot->last_active = Timestamp::now();
+	}
+}
+
+void TcpConnectionPool::evict(const TcpConnectionPtr& conn) {
+	if (find(conn)) {
+		conn->ForceClose();
+	}
+}
+
+size_t TcpConnectionPool::connected_count(void) const {
+	size_t count = 0;
+	for (const auto& slot : slots_) {
+		if (slot->conn) {
+			++count;
+		}
+	}
+	return count;
+}
+
+void TcpConnectionPool::grow(void) {
+	Slot* slot = new Slot;
+	slots_.emplace_back(slot);
+	slot->backoff_ms = options_.reconnect_min_ms;
+	connect(slot);
+}
+
+TcpConnectionPool::Slot* TcpConnectionPool::find(const TcpConnectionPtr& conn) {
+	for (auto& slot : slots_) {
+		if (slot->conn == conn) {
+			return slot.get();
+		}
+	}
+	return nullptr;
+}
+
+void TcpConnectionPool::connect(Slot* slot) {
+	slot->reconnecting = false;
+	if (!slot->connector) {
+		slot->connector = std::make_shared<Connector>(loop_, server_);
+		slot->connector->SetRetryDelay(options_.reconnect_min_ms, options_.reconnect_max_ms);
+		slot->connector->SetNewConnectionCallback(std::bind(&TcpConnectionPool::OnNewConnection, this, slot, _1));
+		slot->connector->SetConnectionFailedCallback(std::bind(&TcpConnectionPool::OnConnectFailed, this, slot));
+		slot->connector->start();
+	} else {
+		slot->connector->restart();
+	}
+}
+
+void TcpConnectionPool::ScheduleReconnect(Slot* slot) {
+	int delay_ms = Connector::JitterDelay(slot->backoff_ms);
+	slot->backoff_ms = std::min(slot->backoff_ms * 2, options_.reconnect_max_ms);
+	slot->reconnecting = true;
+	slot->reconnect_timer = loop_->RunAfter(delay_ms / 1000.0, std::bind(&TcpConnectionPool::connect, this, slot));
+	LOG_INFO << "TcpConnectionPool [" << name_ << "] - reconnect to " << server_.ipport()
+			 << " in " << delay_ms << " milliseconds";
+}
+
+void TcpConnectionPool::RemoveSlot(Slot* slot) {
+	for (auto it = slots_.begin(); it != slots_.end(); ++it) {
+		if (it->get() == slot) {
+			if (slot->connector) {
+				ReleaseConnectorLater(loop_, slot->connector);
+			}
+			slots_.erase(it);
+			return;
+		}
+	}
+}
+
+void TcpConnectionPool::OnNewConnection(Slot* slot, int sockfd) {
+	TcpConnectionPtr conn = NewClientConnection(loop_, name_, sockfd, &next_conn_id_);
+	conn->SetConnectionCallback(connectionCallback_);
+	conn->SetMessageCallback(messageCallback_);
+	conn->SetWriteCompleteCallback(writeCompleteCallback_);
+	conn->SetCloseCallback(std::bind(&TcpConnectionPool::OnClose, this, slot, _1));
+	slot->conn = conn;
+	slot->outstanding = 0;
+	slot->last_active = Timestamp::now();
+	slot->backoff_ms = options_.reconnect_min_ms;
+	conn->ConnectEstablished();
+}
+
+void TcpConnectionPool::OnConnectFailed(Slot* slot) {
+	LOG_WARN << "TcpConnectionPool [" << name_ << "] - connect to " << server_.ipport() << " failed";
+	// 由连接池按退避间隔重连，停止连接器自身的重连
+	slot->connector->stop();
+	ScheduleReconnect(slot);
+}
+
+void TcpConnectionPool::OnClose(Slot* slot, const TcpConnectionPtr& conn) {
+	loop_->AssertInLoopThread();
+	slot->conn.reset();
+	slot->outstanding = 0;
+	loop_->QueueInLoop(std::bind(&TcpConnection::ConnectDestroyed, conn));
+	// 多于最少连接数的位置不再重连
+	if (slots_.size() > options_.min_connections) {
+		RemoveSlot(slot);
+	} else {
+		ScheduleReconnect(slot);
+	}
+}
+
+void TcpConnectionPool::maintain(void) {
+	Timestamp now = Timestamp::now();
+	bool check = healthCheck_ && options_.health_check_interval > 0
+		&& timeDifference(now, last_health_check_) >= options_.health_check_interval;
+	if (check) {
+		last_health_check_ = now;
+	}
+
+	size_t connected = connected_count();
+	for (auto& slot : slots_) {
+		TcpConnectionPtr conn = slot->conn;
+		if (!conn || !conn->connected()) {
+			continue;
+		}
+		if (check && !healthCheck_(conn)) {
+			LOG_WARN << "TcpConnectionPool [" << conn->name() << "] - health check failed";
+			conn->ForceClose();
+			continue;
+		}
+		if (options_.idle_timeout > 0 && connected > options_.min_connections && 0 == slot->outstanding
+			&& timeDifference(now, slot->last_active) > options_.idle_timeout) {
+			conn->shutdown();
+			--connected;
+		}
+	}
+}
+
+} // namespace net
+
+} // namespace brsdk
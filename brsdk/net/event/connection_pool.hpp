@@ -0,0 +1,144 @@
+/**
+ * MIT License
+ *
+ * Copyright © 2021 <Jerry.Yu>.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the “Software”), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * @file connection_pool.hpp
+ * @brief tcp连接池
+ * @author Jerry.Yu (jerry.yu512@outlook.com)
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright MIT License
+ *
+ */
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include "brsdk/mix/noncopyable.hpp"
+#include "brsdk/net/socket/address.hpp"
+#include "brsdk/time/timestamp.hpp"
+#include "event_typedef.hpp"
+#include "timer.hpp"
+
+namespace brsdk {
+
+namespace net {
+
+/**
+ * @brief 单个上游地址、单个loop的tcp连接池
+ * @details
+ * - 所有接口都在所属loop线程调用，连接全部属于该loop，取用连接不加锁；多个loop各建一个池
+ * - 保持 @c min_connections 条连接，全部连接都有在途请求时按需扩充到 @c max_connections
+ * - @c acquire 选择在途请求最少的连接，请求完成后 @c release
+ * - 断开的连接按退避间隔重连，间隔在[间隔/2, 间隔]内随机，避免上游恢复时同时重连
+ * - 超过最少连接数且空闲超时的连接被关闭；可设置健康检查，不健康的连接被关闭并重建
+ * - 不在回调中析构连接池
+ */
+class TcpConnectionPool : noncopyable {
+public:
+	struct Options {
+		Options()
+			: min_connections(1),
+			  max_connections(8),
+			  idle_timeout(60.0),
+			  reconnect_min_ms(100),
+			  reconnect_max_ms(10 * 1000),
+			  health_check_interval(0.0) {}
+
+		size_t min_connections;			///< 保持的最少连接数
+		size_t max_connections;			///< 最多连接数
+		double idle_timeout;			///< 多于最少连接数时空闲连接的关闭时间，秒，0表示不关闭
+		int reconnect_min_ms;			///< 初始重连间隔，毫秒
+		int reconnect_max_ms;			///< 最大重连间隔，毫秒
+		double health_check_interval;	///< 健康检查间隔，秒，0表示不检查
+	};
+
+	// 健康检查，返回false时关闭连接
+	using HealthCheckCallback = std::function<bool(const TcpConnectionPtr&)>;
+
+	TcpConnectionPool(EventLoop* loop, const Address& server, const std::string& name,
+					  const Options& options = Options());
+	~TcpConnectionPool();
+
+	EventLoop* GetLoop(void) const { return loop_; }
+	const std::string& name(void) const { return name_; }
+
+	// 以下回调应用到之后建立的连接，必须在 @c start 之前设置
+	void SetConnectionCallback(const TcpConnectionCallback& cb) { connectionCallback_ = cb; }
+	void SetMessageCallback(const TcpMessageCallbak& cb) { messageCallback_ = cb; }
+	void SetWriteCompleteCallback(const TcpWriteCompleteCallbak& cb) { writeCompleteCallback_ = cb; }
+	void SetHealthCheck(const HealthCheckCallback& cb) { healthCheck_ = cb; }
+
+	// 建立最少连接数的连接并启动维护定时器
+	void start(void);
+
+	/**
+	 * @brief 取用在途请求最少的已连接连接，在途请求数加一
+	 * @details 全部连接都有在途请求且未达上限时，后台新建一条连接，本次仍返回现有连接
+	 *
+	 * @return TcpConnectionPtr 没有已建立的连接时为空
+	 */
+	TcpConnectionPtr acquire(void);
+	// 请求完成，在途请求数减一；连接已经不在池中时忽略
+	void release(const TcpConnectionPtr& conn);
+	// 关闭连接，之后按需重建
+	void evict(const TcpConnectionPtr& conn);
+
+	// 连接数，含正在建立与等待重连的
+	size_t size(void) const { return slots_.size(); }
+	// 已建立的连接数
+	size_t connected_count(void) const;
+
+private:
+	struct Slot;
+
+	// 新增一个连接位置并开始连接
+	void grow(void);
+	Slot* find(const TcpConnectionPtr& conn);
+	void connect(Slot* slot);
+	// 按退避间隔重连
+	void ScheduleReconnect(Slot* slot);
+	void RemoveSlot(Slot* slot);
+
+	void OnNewConnection(Slot* slot, int sockfd);
+	void OnConnectFailed(Slot* slot);
+	void OnClose(Slot* slot, const TcpConnectionPtr& conn);
+	// 空闲回收与健康检查
+	void maintain(void);
+
+	EventLoop* loop_;			///< 所属事件循环
+	const Address server_;		///< 上游地址
+	const std::string name_;	///< 名称
+	const Options options_;		///< 配置
+	bool started_;				///< 已启动
+	int next_conn_id_;			///< 连接编号
+	TimerId maintain_timer_;	///< 维护定时器
+	Timestamp last_health_check_;	///< 上次健康检查时间
+	std::vector<std::unique_ptr<Slot>> slots_;	///< 连接位置
+	TcpConnectionCallback connectionCallback_;
+	TcpMessageCallbak messageCallback_;
+	TcpWriteCompleteCallbak writeCompleteCallback_;
+	HealthCheckCallback healthCheck_;
+};
+
+} // namespace net
+
+} // namespace brsdk
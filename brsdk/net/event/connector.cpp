@@ -31,6 +31,8 @@
 #include "connector.hpp"
 #include "event_channel.hpp"
 #include <errno.h>
+#include <unistd.h>
+#include <random>
 
 namespace brsdk {
 
@@ -49,7 +51,9 @@ Connector::Connector(EventLoop* loop, const Address& server_addr, const Address&
 	  local_addr_(local_addr),
 	  connect_(false),
 	  state_(kDisconnected),
-	  retry_delayms_(kInitRetryDelayMs) {
+	  retry_delayms_(kInitRetryDelayMs),
+	  init_retry_delayms_(kInitRetryDelayMs),
+	  max_retry_delayms_(kMaxRetryDelayMs) {
 	LOG_DEBUG << "constructor[" << this << "]";
 }
 
@@ -66,7 +70,7 @@ void Connector::start(void) {
 void Connector::restart(void) {
 	loop_->AssertInLoopThread();
 	set_state(kDisconnected);
-	retry_delayms_ = kInitRetryDelayMs;
+	retry_delayms_ = init_retry_delayms_;
 	connect_ = true;
 	StartInLoop();
 }
@@ -151,6 +155,9 @@ void Connector::HandleWrite(void) {
 		if (err) {
 			LOG_WARN << "Connector::HandlWrite - SO_ERROR = "
 					 << err << " " << strerror_tl(err);
+			if (failedConnectCallback_) {
+				failedConnectCallback_(server_addr_, local_addr_);
+			}
 			retry(sockfd);
 		} else if (sock_is_self_connect(sockfd)) {
 			LOG_WARN << "Connector::HandleWrite - Self connect";
@@ -175,6 +182,9 @@ void Connector::HandleError(void) {
 		int sockfd = RemoveAndResetChannel();
 		int err = sock_get_error(sockfd);
 		LOG_TRACE << "SO_ERROR = " << err << " " << strerror_tl(err);
+		if (failedConnectCallback_) {
+			failedConnectCallback_(server_addr_, local_addr_);
+		}
 		retry(sockfd);
 	}
 }
@@ -182,15 +192,25 @@ void Connector::retry(int sockfd) {
 	sock_close(sockfd);
 	set_state(kDisconnected);
 	if (connect_) {
+		int delay_ms = JitterDelay(retry_delayms_);
 		LOG_INFO << "Connector::retry - Retry connecting to " << server_addr_.ipport()
-				 << " in " << retry_delayms_ << " milliseconds.";
-		loop_->RunAfter(retry_delayms_ / 1000.0,
+				 << " in " << delay_ms << " milliseconds.";
+		loop_->RunAfter(delay_ms / 1000.0,
 						std::bind(&Connector::StartInLoop, shared_from_this()));
-		retry_delayms_ = std::min(retry_delayms_ * 2, kMaxRetryDelayMs);
+		retry_delayms_ = std::min(retry_delayms_ * 2, max_retry_delayms_);
 	} else {
 		LOG_DEBUG << "Do not connect";
 	}
 }
+int Connector::JitterDelay(int delay_ms) {
+	static thread_local std::minstd_rand t_engine(
+		static_cast<unsigned>(::getpid()) ^ static_cast<unsigned>(Timestamp::now().microSecondsSinceEpoch()));
+	if (delay_ms < 2) {
+		return delay_ms;
+	}
+	std::uniform_int_distribution<int> dist(delay_ms / 2, delay_ms);
+	return dist(t_engine);
+}
 int Connector::RemoveAndResetChannel(void) {
 	channel_->DisableAll();
 	channel_->remove();
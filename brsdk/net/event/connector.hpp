@@ -51,6 +51,10 @@ public:
 		newConnectionCallback_ = cb;
 	}
 
+	/**
+	 * @brief 设置连接失败回调，立即失败与异步失败(如连接被拒绝)都回调
+	 * @details 异步失败回调之后连接器按重连间隔自动重连，自行管理重连的所有者在回调中stop()
+	 */
 	void SetConnectionFailedCallback(const ConnectorFailedConnCallback& cb) {
 		failedConnectCallback_ = cb;
 	}
@@ -59,6 +63,21 @@ public:
 	void restart(void);	// loop中调用
 	void stop(void);
 
+	/**
+	 * @brief 设置重连间隔，每次失败后加倍直到最大值，实际间隔在[间隔/2, 间隔]内随机，
+	 *        避免大量连接在服务端恢复时同时重连
+	 *
+	 * @param init_delay_ms 初始重连间隔，毫秒
+	 * @param max_delay_ms 最大重连间隔，毫秒
+	 */
+	void SetRetryDelay(int init_delay_ms, int max_delay_ms) {
+		init_retry_delayms_ = init_delay_ms;
+		max_retry_delayms_ = max_delay_ms;
+		retry_delayms_ = init_delay_ms;
+	}
+	// 在[delay_ms/2, delay_ms]内随机取值
+	static int JitterDelay(int delay_ms);
+
 	// 获取服务器地址
 	const Address& server_address(void) const {
 		return server_addr_;
@@ -105,6 +124,8 @@ private:
 	ConnectorFailedConnCallback failedConnectCallback_;
 	ConnectorNewConnectionCallback newConnectionCallback_;
 	int retry_delayms_;						///< 重连间隔时间
+	int init_retry_delayms_;				///< 初始重连间隔时间
+	int max_retry_delayms_;					///< 最大重连间隔时间
 };
 
 } // namespace net
@@ -0,0 +1,404 @@
+/**
+ * MIT License
+ *
+ * Copyright © 2021 <Jerry.Yu>.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the “Software”), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * @file dns_resolver.cpp
+ * @brief 事件循环上的异步dns解析
+ * @author Jerry.Yu (jerry.yu512@outlook.com)
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright MIT License
+ *
+ */
+#include "dns_resolver.hpp"
+#include <arpa/inet.h>
+#include <ctype.h>
+#include <string.h>
+#include <algorithm>
+#include "brsdk/protocol/dns.hpp"
+#include "event_log.hpp"
+#include "event_loop.hpp"
+#include "udp_client.hpp"
+#include "udp_endpoint.hpp"
+
+namespace brsdk {
+
+namespace net {
+
+const size_t DnsCache::kDefaultShards;
+const size_t DnsCache::kDefaultCapacity;
+
+namespace {
+
+// 查询类型，下标与Lookup::ids对应
+const uint16_t kQueryTypes[2] = {BRSDK_DNS_TYPE_A, BRSDK_DNS_TYPE_AAAA};
+// 应答码
+const int kRcodeOk = 0;
+const int kRcodeNxDomain = 3;
+
+// 结果地址换成调用者的端口
+std::vector<Address> with_port(const std::vector<Address>& addrs, uint16_t port) {
+	std::vector<Address> result;
+	result.reserve(addrs.size());
+	for (const Address& addr : addrs) {
+		sock_addr_t raw = *addr.addr();
+		if (AF_INET == raw.sa.sa_family) {
+			raw.sin.sin_port = htons(port);
+		} else {
+			raw.sin6.sin6_port = htons(port);
+		}
+		result.push_back(Address(raw));
+	}
+	return result;
+}
+
+// IP字面量直接得到地址
+bool parse_literal(const std::string& name, uint16_t port, Address* addr) {
+	sock_addr_t raw;
+	memset(&raw, 0, sizeof(raw));
+	if (1 == ::inet_pton(AF_INET, name.c_str(), &raw.sin.sin_addr)) {
+		raw.sin.sin_family = AF_INET;
+		raw.sin.sin_port = htons(port);
+	} else if (1 == ::inet_pton(AF_INET6, name.c_str(), &raw.sin6.sin6_addr)) {
+		raw.sin6.sin6_family = AF_INET6;
+		raw.sin6.sin6_port = htons(port);
+	} else {
+		return false;
+	}
+	*addr = Address(raw);
+	return true;
+}
+
+bool equals_ignore_case(const char* a, const std::string& b) {
+	return 0 == ::strcasecmp(a, b.c_str());
+}
+
+} // namespace
+
+DnsCache::DnsCache(size_t shards, size_t capacity) {
+	shards = std::max<size_t>(shards, 1);
+	for (size_t i = 0; i < shards; i++) {
+		shards_.emplace_back(new Shard(capacity));
+	}
+}
+
+DnsCache::Shard* DnsCache::shard(const std::string& name) const {
+	return shards_[std::hash<std::string>()(name) % shards_.size()].get();
+}
+
+bool DnsCache::lookup(const std::string& name, std::vector<Address>* addrs) {
+	Shard* s = shard(name);
+	int64_t now = Timestamp::now().microSecondsSinceEpoch();
+	MutexLockGuard lock(s->mutex);
+	auto it = s->entries.find(name);
+	if (it == s->entries.end()) {
+		return false;
+	}
+	if (it->second.expire_us <= now) {
+		s->entries.erase(it);
+		return false;
+	}
+	*addrs = it->second.addrs;
+	return true;
+}
+
+void DnsCache::insert(const std::string& name, const std::vector<Address>& addrs, uint32_t ttl) {
+	if (0 == ttl) {
+		return;
+	}
+	Entry entry;
+	entry.addrs = addrs;
+	entry.expire_us = Timestamp::now().microSecondsSinceEpoch() + static_cast<int64_t>(ttl) * 1000 * 1000;
+	Shard* s = shard(name);
+	MutexLockGuard lock(s->mutex);
+	// 已存在的键不会被insert覆盖
+	s->entries.erase(name);
+	s->entries.insert(name, entry);
+}
+
+void DnsCache::erase(const std::string& name) {
+	Shard* s = shard(name);
+	MutexLockGuard lock(s->mutex);
+	s->entries.erase(name);
+}
+
+size_t DnsCache::size(void) const {
+	size_t n = 0;
+	for (const auto& s : shards_) {
+		MutexLockGuard lock(s->mutex);
+		n += s->entries.size();
+	}
+	return n;
+}
+
+DnsResolver::Options::Options()
+	: timeout(1.0),
+	  attempts(3),
+	  ipv6(true),
+	  max_ttl(3600),
+	  negative_ttl(30) {
+}
+
+DnsResolver::DnsResolver(EventLoop* loop, const Address& nameserver, const Options& options,
+						 const std::shared_ptr<DnsCache>& cache)
+	: loop_(loop),
+	  options_(options),
+	  cache_(cache ? cache : std::make_shared<DnsCache>()),
+	  client_(new UdpClient(loop, nameserver, "DnsResolver")),
+	  random_(std::random_device()()),
+	  queries_sent_(0),
+	  cache_hits_(0),
+	  coalesced_(0) {
+	client_->SetMessageCallback(std::bind(&DnsResolver::OnMessage, this, _1, _2, _3));
+	client_->start();
+}
+
+DnsResolver::~DnsResolver() {
+	loop_->AssertInLoopThread();
+	// 先取出全部解析，回调期间不再有进行中的查询
+	std::map<std::string, std::unique_ptr<Lookup>> lookups;
+	lookups.swap(lookups_);
+	queries_.clear();
+	for (auto& it : lookups) {
+		loop_->cancel(it.second->timer);
+	}
+	for (auto& it : lookups) {
+		for (const Waiter& waiter : it.second->waiters) {
+			waiter.cb(kCanceled, std::vector<Address>());
+		}
+	}
+}
+
+const char* DnsResolver::ErrorString(Error error) {
+	switch (error) {
+		case kOk:
+			return "ok";
+		case kNotFound:
+			return "not found";
+		case kTimeout:
+			return "timeout";
+		case kServerFailure:
+			return "server failure";
+		case kBadName:
+			return "bad name";
+		case kCanceled:
+			return "canceled";
+		default:
+			return "unknown error";
+	}
+}
+
+void DnsResolver::resolve(const std::string& name, uint16_t port, const ResolveCallback& cb) {
+	loop_->RunInLoop(std::bind(&DnsResolver::ResolveInLoop, this, name, port, cb));
+}
+
+void DnsResolver::ResolveInLoop(const std::string& name, uint16_t port, const ResolveCallback& cb) {
+	loop_->AssertInLoopThread();
+	Address literal;
+	if (parse_literal(name, port, &literal)) {
+		cb(kOk, std::vector<Address>(1, literal));
+		return;
+	}
+
+	// 域名不区分大小写，去掉末尾的根
+	std::string key(name);
+	if (!key.empty() && '.' == key.back()) {
+		key.pop_back();
+	}
+	std::transform(key.begin(), key.end(), key.begin(), ::tolower);
+	char encoded[BRSDK_DNS_NAME_MAXLEN + 1];
+	if (key.empty() || key.size() >= BRSDK_DNS_NAME_MAXLEN - 1 || protocol::dns_name_encode(key.c_str(), encoded) < 0) {
+		cb(kBadName, std::vector<Address>());
+		return;
+	}
+
+	std::vector<Address> cached;
+	if (cache_->lookup(key, &cached)) {
+		++cache_hits_;
+		cb(cached.empty() ? kNotFound : kOk, with_port(cached, port));
+		return;
+	}
+
+	auto it = lookups_.find(key);
+	if (it != lookups_.end()) {
+		++coalesced_;
+		it->second->waiters.push_back(Waiter{port, cb});
+		return;
+	}
+
+	Lookup* lookup = new Lookup();
+	lookups_[key].reset(lookup);
+	lookup->name = key;
+	lookup->waiters.push_back(Waiter{port, cb});
+	lookup->pending = options_.ipv6 ? 3 : 1;
+	SendQueries(lookup);
+}
+
+void DnsResolver::SendQueries(Lookup* lookup) {
+	char buf[512];
+	lookup->attempt++;
+	for (int i = 0; i < 2; i++) {
+		if (0 == (lookup->pending & (1 << i))) {
+			continue;
+		}
+		// 重发使用新的事务ID，迟到的旧应答不再匹配
+		queries_.erase(lookup->ids[i]);
+		lookup->ids[i] = NextId();
+		queries_[lookup->ids[i]] = std::make_pair(lookup, i);
+
+		protocol::dns_rr_t question;
+		memset(&question, 0, sizeof(question));
+		::strncpy(question.name, lookup->name.c_str(), sizeof(question.name) - 1);
+		question.rtype = kQueryTypes[i];
+		question.rclass = BRSDK_DNS_CLASS_IN;
+		protocol::dns_t query;
+		memset(&query, 0, sizeof(query));
+		query.hdr.transaction_id = lookup->ids[i];
+		query.hdr.qr = BRSDK_DNS_QUERY;
+		query.hdr.rd = 1;
+		query.hdr.nquestion = 1;
+		query.questions = &question;
+		int len = protocol::dns_pack(&query, buf, sizeof(buf));
+		if (len > 0) {
+			client_->send(buf, static_cast<size_t>(len));
+			++queries_sent_;
+		}
+	}
+
+	std::string name = lookup->name;
+	lookup->timer = loop_->RunAfter(options_.timeout, std::bind(&DnsResolver::OnTimeout, this, name, lookup));
+}
+
+void DnsResolver::OnMessage(const str::StringPiece& datagram, const Address& peer, Timestamp receive_time) {
+	// 解码后的记录指向报文，拷贝一份可写的
+	char buf[UdpEndpoint::kDefaultDatagramSize];
+	size_t len = std::min(static_cast<size_t>(datagram.size()), sizeof(buf));
+	::memcpy(buf, datagram.data(), len);
+	protocol::dns_t response;
+	if (protocol::dns_unpack(buf, static_cast<int>(len), &response) < 0) {
+		LOG_WARN << "DnsResolver - bad response from " << peer.ipport();
+		return;
+	}
+
+	auto query = queries_.find(response.hdr.transaction_id);
+	if (query == queries_.end()) {
+		protocol::dns_free(&response);
+		return;
+	}
+	Lookup* lookup = query->second.first;
+	int index = query->second.second;
+	uint16_t type = kQueryTypes[index];
+	// 问题必须与查询一致，防止伪造或者串号的应答
+	if (!response.hdr.qr || response.hdr.nquestion != 1
+		|| response.questions[0].rtype != type
+		|| !equals_ignore_case(response.questions[0].name, lookup->name)) {
+		protocol::dns_free(&response);
+		return;
+	}
+	queries_.erase(query);
+	lookup->pending &= ~(1 << index);
+
+	if (kRcodeOk == response.hdr.rcode || kRcodeNxDomain == response.hdr.rcode) {
+		lookup->nxdomain = lookup->nxdomain || kRcodeNxDomain == response.hdr.rcode;
+		// CNAME链上的地址记录都属于查询的域名，按类型收集即可
+		for (int i = 0; i < response.hdr.nanswer; i++) {
+			const protocol::dns_rr_t& rr = response.answers[i];
+			if (rr.rclass != BRSDK_DNS_CLASS_IN || rr.rtype != type) {
+				continue;
+			}
+			sock_addr_t raw;
+			memset(&raw, 0, sizeof(raw));
+			if (BRSDK_DNS_TYPE_A == type && 4 == rr.datalen) {
+				raw.sin.sin_family = AF_INET;
+				::memcpy(&raw.sin.sin_addr, rr.data, 4);
+				lookup->v4.push_back(Address(raw));
+			} else if (BRSDK_DNS_TYPE_AAAA == type && 16 == rr.datalen) {
+				raw.sin6.sin6_family = AF_INET6;
+				::memcpy(&raw.sin6.sin6_addr, rr.data, 16);
+				lookup->v6.push_back(Address(raw));
+			} else {
+				continue;
+			}
+			lookup->ttl = std::min(lookup->ttl, rr.ttl);
+		}
+	} else {
+		LOG_WARN << "DnsResolver - " << lookup->name << " rcode " << static_cast<int>(response.hdr.rcode);
+		lookup->failed = true;
+	}
+	protocol::dns_free(&response);
+
+	if (0 == lookup->pending) {
+		finish(lookup->name);
+	}
+}
+
+void DnsResolver::OnTimeout(const std::string& name, Lookup* lookup) {
+	auto it = lookups_.find(name);
+	if (it == lookups_.end() || it->second.get() != lookup) {
+		return;
+	}
+	if (lookup->attempt < options_.attempts) {
+		LOG_DEBUG << "DnsResolver - " << name << " timeout, attempt " << lookup->attempt;
+		SendQueries(lookup);
+		return;
+	}
+	finish(name);
+}
+
+void DnsResolver::finish(const std::string& name) {
+	auto it = lookups_.find(name);
+	std::unique_ptr<Lookup> lookup(std::move(it->second));
+	lookups_.erase(it);
+	loop_->cancel(lookup->timer);
+	for (int i = 0; i < 2; i++) {
+		if (lookup->pending & (1 << i)) {
+			queries_.erase(lookup->ids[i]);
+		}
+	}
+
+	std::vector<Address> addrs(lookup->v4);
+	addrs.insert(addrs.end(), lookup->v6.begin(), lookup->v6.end());
+	Error error = kOk;
+	if (!addrs.empty()) {
+		cache_->insert(lookup->name, addrs, std::min(lookup->ttl, options_.max_ttl));
+	} else if (lookup->nxdomain || (!lookup->failed && 0 == lookup->pending)) {
+		// 域名不存在或者没有地址记录
+		error = kNotFound;
+		cache_->insert(lookup->name, addrs, options_.negative_ttl);
+	} else {
+		error = lookup->failed ? kServerFailure : kTimeout;
+	}
+
+	// 回调中可能再次解析同一域名，此时已是新的解析
+	for (const Waiter& waiter : lookup->waiters) {
+		waiter.cb(error, with_port(addrs, waiter.port));
+	}
+}
+
+uint16_t DnsResolver::NextId(void) {
+	uint16_t id;
+	do {
+		id = static_cast<uint16_t>(random_());
+	} while (queries_.count(id) > 0);
+	return id;
+}
+
+} // namespace net
+
+} // namespace brsdk
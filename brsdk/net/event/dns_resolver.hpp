@@ -0,0 +1,211 @@
+/**
+ * MIT License
+ *
+ * Copyright © 2021 <Jerry.Yu>.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the “Software”), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * @file dns_resolver.hpp
+ * @brief 事件循环上的异步dns解析
+ * @author Jerry.Yu (jerry.yu512@outlook.com)
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright MIT License
+ *
+ */
+#pragma once
+
+#include <stdint.h>
+#include <functional>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include "brsdk/ds/lru_map.hpp"
+#include "brsdk/lock/mutex.hpp"
+#include "brsdk/mix/noncopyable.hpp"
+#include "brsdk/net/socket/address.hpp"
+#include "brsdk/str/string_piece.hpp"
+#include "brsdk/time/timestamp.hpp"
+#include "event_typedef.hpp"
+#include "timer.hpp"
+
+namespace brsdk {
+
+namespace net {
+
+/**
+ * @brief 域名解析结果缓存，按TTL过期
+ * @details 按域名哈希分片，每个分片一把锁和一个LRU，
+ *          多个loop的解析器共享同一个缓存时锁竞争分散到各分片
+ */
+class DnsCache : noncopyable {
+public:
+	// 默认分片数
+	static const size_t kDefaultShards = 16;
+	// 默认每个分片的容量
+	static const size_t kDefaultCapacity = 1024;
+
+	explicit DnsCache(size_t shards = kDefaultShards, size_t capacity = kDefaultCapacity);
+
+	/**
+	 * @brief 查找未过期的记录，过期记录被删除
+	 *
+	 * @param name 域名，小写
+	 * @param addrs 地址，端口为0；为空表示缓存的否定应答
+	 * @return true 命中
+	 */
+	bool lookup(const std::string& name, std::vector<Address>* addrs);
+	// 插入或者替换记录，ttl为0不缓存
+	void insert(const std::string& name, const std::vector<Address>& addrs, uint32_t ttl);
+	void erase(const std::string& name);
+	// 记录数，包含未清理的过期记录
+	size_t size(void) const;
+
+private:
+	struct Entry {
+		std::vector<Address> addrs;	///< 地址
+		int64_t expire_us = 0;		///< 过期时间
+	};
+
+	struct Shard {
+		explicit Shard(size_t capacity) : entries(capacity) {}
+
+		mutable MutexLock mutex;
+		ds::LruMap<std::string, Entry> entries GUARDED_BY(mutex);
+	};
+
+	Shard* shard(const std::string& name) const;
+
+	std::vector<std::unique_ptr<Shard>> shards_;	///< 分片
+};
+
+/**
+ * @brief 非阻塞的dns存根解析器，查询发往一个递归解析服务器
+ * @details
+ * - 基于loop上的UdpClient收发，报文使用protocol/dns.hpp的dnshdr_t/dns_rr_t编解码
+ * - A与AAAA查询同时发出，两个应答都到达(或者超时)后合并回调，IPv4地址在前
+ * - 同一域名的并发解析合并为一次查询，应答到达后依次回调
+ * - 结果按应答中最小的TTL缓存，不存在的域名按 @c Options::negative_ttl 缓存
+ * - 超时按 @c Options::attempts 重发，每次使用新的事务ID，迟到的旧应答被丢弃
+ * - 截断的应答只使用其中已有的记录，不改用TCP重查
+ * - 回调在loop线程执行，缓存命中与IP字面量在resolve内直接回调
+ * - 析构必须在loop线程，未完成的解析以 @c kCanceled 回调，回调中不能再使用本解析器
+ */
+class DnsResolver : noncopyable {
+public:
+	// 解析结果
+	enum Error {
+		kOk,			///< 成功
+		kNotFound,		///< 域名不存在或者没有地址记录
+		kTimeout,		///< 服务器无应答
+		kServerFailure,	///< 服务器返回错误
+		kBadName,		///< 域名格式错误
+		kCanceled,		///< 解析器析构，解析未完成
+	};
+
+	// 解析回调，地址端口为resolve传入的端口
+	using ResolveCallback = std::function<void(Error, const std::vector<Address>&)>;
+
+	struct Options {
+		Options();
+
+		double timeout;			///< 单次查询超时(秒)
+		int attempts;			///< 最多发送次数
+		bool ipv6;				///< 同时查询AAAA
+		uint32_t max_ttl;		///< 缓存时间上限(秒)
+		uint32_t negative_ttl;	///< 否定应答缓存时间(秒)，0不缓存
+	};
+
+	/**
+	 * @brief 构造
+	 *
+	 * @param loop 所属事件循环
+	 * @param nameserver 递归解析服务器地址
+	 * @param options 配置
+	 * @param cache 共享缓存，为空时创建独占的缓存
+	 */
+	DnsResolver(EventLoop* loop, const Address& nameserver, const Options& options = Options(),
+				const std::shared_ptr<DnsCache>& cache = std::shared_ptr<DnsCache>());
+	~DnsResolver();
+
+	/**
+	 * @brief 解析域名，任意线程可调用
+	 *
+	 * @param name 域名或者IP字面量
+	 * @param port 结果地址的端口
+	 * @param cb 回调，在loop线程执行
+	 */
+	void resolve(const std::string& name, uint16_t port, const ResolveCallback& cb);
+
+	const std::shared_ptr<DnsCache>& cache(void) const { return cache_; }
+	static const char* ErrorString(Error error);
+
+	// 已发送的查询报文数，loop线程内调用
+	uint64_t queries(void) const { return queries_sent_; }
+	// 缓存命中次数
+	uint64_t cache_hits(void) const { return cache_hits_; }
+	// 合并到进行中查询的解析次数
+	uint64_t coalesced(void) const { return coalesced_; }
+
+private:
+	// 等待结果的调用者
+	struct Waiter {
+		uint16_t port;
+		ResolveCallback cb;
+	};
+
+	// 一个域名的进行中解析，A与AAAA各一个查询
+	struct Lookup {
+		std::string name;				///< 域名
+		std::vector<Waiter> waiters;	///< 等待者
+		std::vector<Address> v4;		///< A记录
+		std::vector<Address> v6;		///< AAAA记录
+		uint16_t ids[2] = {0, 0};		///< 进行中查询的事务ID
+		int pending = 0;				///< 未应答的查询，按位对应A/AAAA
+		int attempt = 0;				///< 已发送次数
+		uint32_t ttl = UINT32_MAX;		///< 地址记录的最小TTL
+		bool nxdomain = false;			///< 域名不存在
+		bool failed = false;			///< 服务器返回错误
+		TimerId timer;					///< 超时定时器
+	};
+
+	void ResolveInLoop(const std::string& name, uint16_t port, const ResolveCallback& cb);
+	// 发送未应答的查询并设置超时
+	void SendQueries(Lookup* lookup);
+	void OnMessage(const str::StringPiece& datagram, const Address& peer, Timestamp receive_time);
+	void OnTimeout(const std::string& name, Lookup* lookup);
+	// 结束解析，缓存结果并回调全部等待者
+	void finish(const std::string& name);
+	// 未被占用的随机事务ID
+	uint16_t NextId(void);
+
+	EventLoop* loop_;
+	const Options options_;
+	std::shared_ptr<DnsCache> cache_;		///< 结果缓存
+	std::unique_ptr<UdpClient> client_;		///< 到解析服务器的udp
+	std::map<std::string, std::unique_ptr<Lookup>> lookups_;	///< 进行中的解析，按域名
+	std::map<uint16_t, std::pair<Lookup*, int>> queries_;		///< 进行中的查询，按事务ID，值为解析与查询序号
+	std::mt19937 random_;					///< 事务ID随机数
+	uint64_t queries_sent_;
+	uint64_t cache_hits_;
+	uint64_t coalesced_;
+};
+
+} // namespace net
+
+} // namespace brsdk
@@ -42,6 +42,7 @@ EventChannel::EventChannel(EventLoop* loop, int fd)
 	  revents_(0),
 	  index_(-1),
 	  log_hup_(true),
+	  edge_triggered_(false),
 	  tied_(false),
 	  event_handling_(false),
 	  added_to_loop_(false) {
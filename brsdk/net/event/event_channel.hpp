@@ -98,6 +98,12 @@ public:
 		update();
 	}
 
+	// 同时使能读写，只更新一次轮询器
+	void EnableReadingAndWriting(void) {
+		events_ |= kReadEvent | kWriteEvent;
+		update();
+	}
+
 	void DisableAll(void) {
 		events_ = kNoneEvent;
 		update();
@@ -123,6 +129,10 @@ public:
 	// 不允许日志挂载
 	void DoNotLogHup(void) { log_hup_ = false; }
 
+	// 边沿触发，需在首次使能事件前设置，读写回调必须一次处理完所有就绪数据
+	void SetEdgeTriggered(bool on) { edge_triggered_ = on; }
+	bool IsEdgeTriggered(void) const { return edge_triggered_; }
+
 	// 所属事件循环
 	EventLoop* OwnerLoop(void) {
 		return loop_;
@@ -152,6 +162,7 @@ private:
 	int revents_;		///< 接收事件类型,epoll/poll,当前活动事件
 	int index_;			///< 事件轮询器使用，当前的通道状态
 	bool log_hup_;		///< 日志
+	bool edge_triggered_;	///< 边沿触发
 
 	std::weak_ptr<void> tie_;	///< 引用
 	bool tied_;					///< 创建引用
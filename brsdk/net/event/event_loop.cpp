@@ -30,6 +30,7 @@
 #include "event_loop.hpp"
 #include "event_channel.hpp"
 #include "poller.hpp"
+#include "loop_watchdog.hpp"
 #include "brsdk/net/socket/socket_util.hpp"
 
 #include <algorithm>
@@ -45,6 +46,15 @@ __thread EventLoop* t_loop_in_this_thread = nullptr;
 
 // 轮询其间隔10s
 const int kPollTimeMs = 10000;
+// 全局空闲回调节点上限
+const size_t kMaxFreeFunctors = 4096;
+
+std::atomic<EventLoop::PendingFunctor*> EventLoop::s_free_functors_(nullptr);
+std::atomic<size_t> EventLoop::s_free_count_(0);
+
+static int64_t elapsed_us(Timestamp from, Timestamp to) {
+	return to.microSecondsSinceEpoch() - from.microSecondsSinceEpoch();
+}
 
 static int create_eventfd(void) {
 	int evtfd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
@@ -60,18 +70,30 @@ EventLoop* EventLoop::GetEventLoopOfCurrentThead(void) {
 	return t_loop_in_this_thread;
 }
 
-EventLoop::EventLoop()
+EventLoop::EventLoop() : EventLoop(0) {}
+
+EventLoop::EventLoop(int timer_wheel_tick_ms)
 	: looping_(false),
 	  quit_(false),
 	  event_handling_(false),
 	  calling_pending_functors_(false),
 	  iteration_(0),
+	  latency_us_(0),
+	  read_paused_(0),
+	  read_paused_us_(0),
+	  busy_since_us_(0),
+	  handling_fd_(-1),
+	  watchdog_(nullptr),
 	  tid_(thread::tid()),
 	  poller_(EventPoller::NewDefaultPoller(this)),
-	  timer_queue_(new TimerQueue(this)),
+	  timer_wheel_tick_ms_(timer_wheel_tick_ms),
+	  timer_queue_(TimerQueue::NewTimerQueue(this, timer_wheel_tick_ms)),
 	  wakeup_fd_(create_eventfd()),
 	  wakeup_channel_(new EventChannel(this, wakeup_fd_)),
-	  current_active_channel_(nullptr) {
+	  current_active_channel_(nullptr),
+	  polling_(false),
+	  wakeup_pending_(false),
+	  pending_count_(0) {
 	LOG_DEBUG << "EventLopp created " << this << " in thread " << tid_;
 
 	// 全局判断，一个线程只能创建一个
@@ -84,6 +106,8 @@ EventLoop::EventLoop()
 
 	// 设置唤醒通道的读事件
 	wakeup_channel_->SetReadCallback(std::bind(&EventLoop::HandleWakeupRead, this));
+	// 每次读取都会清空eventfd计数
+	wakeup_channel_->SetEdgeTriggered(true);
 	// 始终允许读事件
 	wakeup_channel_->EnableReading();
 }
@@ -91,6 +115,9 @@ EventLoop::EventLoop()
 EventLoop::~EventLoop() {
 	LOG_DEBUG << "EventLoop" << this << " of thread " << tid_
 			  << " destructs in thread " << thread::tid();
+	if (EventLoopWatchdog* watchdog = watchdog_.load()) {
+		watchdog->unwatch(this);
+	}
 	// 移除唤醒通道
 	wakeup_channel_->DisableAll();
 	wakeup_channel_->remove();
@@ -108,11 +135,19 @@ void EventLoop::loop(void) {
 
 	LOG_TRACE << "EventLoop " << this << " start looping";
 
+	// 上一次迭代结束时间，即本次轮询开始等待的时间
+	Timestamp idle_since = Timestamp::now();
 	while (!quit_) {
 		// 清空活动队列
 		active_channels_.clear();
 		// 轮询活动通道
-		poll_return_time_ = poller_->poll(kPollTimeMs, &active_channels_);
+		busy_since_us_.store(0, std::memory_order_relaxed);
+		poll_return_time_ = poller_->poll(PollTimeout(kPollTimeMs), &active_channels_);
+		polling_.store(false);
+		busy_since_us_.store(poll_return_time_.microSecondsSinceEpoch(), std::memory_order_relaxed);
+		if (metrics_) {
+			metrics_->RecordPoll(elapsed_us(idle_since, poll_return_time_), active_channels_.size());
+		}
 		// loop次数增加
 		++iteration_;
 		if (Logger::logLevel() <= Logger::TRACE) {
@@ -121,15 +156,25 @@ void EventLoop::loop(void) {
 		// 正在处理事件
 		event_handling_ = true;
 		// 活动事件轮询处理
+		Timestamp last = poll_return_time_;
 		for (EventChannel* channel : active_channels_) {
 			current_active_channel_ = channel;
+			handling_fd_.store(channel->fd(), std::memory_order_relaxed);
 			current_active_channel_->HandleEvent(poll_return_time_);
+			if (metrics_) {
+				Timestamp now = Timestamp::now();
+				metrics_->RecordCallback(elapsed_us(last, now));
+				last = now;
+			}
 		}
 		current_active_channel_ = nullptr;
+		handling_fd_.store(-1, std::memory_order_relaxed);
 		// 事件处理结束
 		event_handling_ = false;
 		// 处理待处理的回调接口
 		DoPendingFunctors();
+		idle_since = Timestamp::now();
+		UpdateLatency(idle_since);
 	}
 
 	LOG_TRACE << "EventLoop " << this << " stop looping";
@@ -161,22 +206,16 @@ void EventLoop::QueueInLoop(EventFunctor cb) {
 		cb();
 		return;
 	}
-	{
-		MutexLockGuard lock(mutex_);
-		pending_functors_.push_back(std::move(cb));
-	}
 
-	// 如果不是在loop线程内，或者正在执行待处理回调函数，需要唤醒一次，避免处理延后
-	if (!IsInLoopThread() || calling_pending_functors_) {
+	pending_count_.fetch_add(1, std::memory_order_relaxed);
+	pending_functors_.push(NewPendingFunctor(std::move(cb)));
+
+	// 不在loop线程内才需要唤醒，loop线程内入队的回调在下次轮询前会被发现(超时为0)
+	if (!IsInLoopThread()) {
 		wakeup();
 	}
 }
 
-size_t EventLoop::queue_size(void) const {
-	MutexLockGuard lock(mutex_);
-	return pending_functors_.size();
-}
-
 TimerId EventLoop::RunAt(Timestamp time, TimerCallback cb) {
 	// 间隔为0则不需要间隔执行
 	return timer_queue_->AddTimer(std::move(cb), time, 0.0);
@@ -221,13 +260,37 @@ bool EventLoop::HasChannel(EventChannel* channel) {
 	return poller_->HasChannel(channel);
 }
 
+bool EventLoop::SupportsEdgeTriggered(void) const {
+	return poller_->SupportsEdgeTriggered();
+}
+
 void EventLoop::AbortNotInLoopThread(void) {
 	LOG_FATAL << "EventLoop::abortNotInLoopThread - EventLoop " << this
 			  << " was created in threadId_ = " << tid_
 			  << ", current thread id = " << thread::tid();
 }
 
+int EventLoop::PollTimeout(int timeout_ms) {
+	// 先声明即将阻塞，再检查队列；与wakeup()中的先入队再检查polling_配对(顺序一致)，
+	// 保证要么loop看到新回调不阻塞，要么生产者看到loop阻塞而写eventfd
+	polling_.store(true);
+	if (quit_ || !pending_functors_.empty()) {
+		return 0;
+	}
+
+	return timeout_ms;
+}
+
 void EventLoop::wakeup(void) {
+	// loop正在运行，会在下一次轮询前处理回调，无需写eventfd
+	if (!polling_.load()) {
+		return;
+	}
+	// 已经有人写过eventfd了
+	if (wakeup_pending_.exchange(true)) {
+		return;
+	}
+
 	uint64_t one = 1;
 	// 通过写数据来唤醒轮询器
 	ssize_t n = sock_write(wakeup_fd_, &one, sizeof(one));
@@ -242,23 +305,120 @@ void EventLoop::HandleWakeupRead(void) {
 	if (n != sizeof(one)) {
 		LOG_ERROR << "EventLoop::handleRead() reads " << n << " bytes instead of 8";
 	}
+	// 读完后才允许下一次写入，之后入队的回调在本轮DoPendingFunctors中可见
+	wakeup_pending_.store(false);
 }
 
 void EventLoop::DoPendingFunctors(void) {
-	std::vector<EventFunctor> functors;
+	PendingFunctor* head = nullptr;
+	PendingFunctor* tail = nullptr;
+	size_t count = 0;
+
 	// 正在处理回调接口
 	calling_pending_functors_ = true;
-	{
-		MutexLockGuard lock(mutex_);
-		functors.swap(pending_functors_);
+	// 先全部取出，回调中新入队的留到下一轮，避免回调不断重新入队导致loop饿死
+	while (PendingFunctor* node = pending_functors_.pop()) {
+		if (tail) {
+			tail->local_next = node;
+		} else {
+			head = node;
+		}
+		tail = node;
+		count++;
 	}
-
-	for (const EventFunctor& functor : functors) {
-		functor();
+	pending_count_.fetch_sub(count, std::memory_order_relaxed);
+
+	EventLoopMetrics* metrics = count > 0 ? metrics_.get() : nullptr;
+	Timestamp start = metrics ? Timestamp::now() : Timestamp();
+	Timestamp last = start;
+	PendingFunctor* first = head;
+	while (head) {
+		PendingFunctor* node = head;
+		head = head->local_next;
+		node->functor();
+		// 尽早释放捕获的对象，节点留待回收
+		node->functor = nullptr;
+		if (metrics) {
+			Timestamp now = Timestamp::now();
+			metrics->RecordCallback(elapsed_us(last, now));
+			last = now;
+		}
+	}
+	if (metrics) {
+		metrics->RecordPending(count, elapsed_us(start, last));
+	}
+	if (first) {
+		RecyclePendingFunctors(first, tail, count);
 	}
 	calling_pending_functors_ = false;
 }
 
+EventLoop::PendingFunctor* EventLoop::NewPendingFunctor(EventFunctor&& cb) {
+	// 线程本地的空闲节点，从全局栈一次整体取走，避免逐个出栈的ABA问题
+	struct LocalFreeList {
+		PendingFunctor* head = nullptr;
+		~LocalFreeList() {
+			while (head) {
+				PendingFunctor* node = head;
+				head = head->local_next;
+				delete node;
+			}
+		}
+	};
+	static thread_local LocalFreeList free_list;
+
+	if (!free_list.head && s_free_functors_.load(std::memory_order_relaxed)) {
+		free_list.head = s_free_functors_.exchange(nullptr, std::memory_order_acquire);
+		s_free_count_.store(0, std::memory_order_relaxed);
+	}
+
+	PendingFunctor* node = free_list.head;
+	if (!node) {
+		return new PendingFunctor(std::move(cb));
+	}
+
+	free_list.head = node->local_next;
+	node->local_next = nullptr;
+	node->functor = std::move(cb);
+	return node;
+}
+
+void EventLoop::RecyclePendingFunctors(PendingFunctor* head, PendingFunctor* tail, size_t count) {
+	// 超过上限直接释放，突发投递后的节点不会一直占用内存
+	if (s_free_count_.fetch_add(count, std::memory_order_relaxed) >= kMaxFreeFunctors) {
+		s_free_count_.fetch_sub(count, std::memory_order_relaxed);
+		while (head) {
+			PendingFunctor* node = head;
+			head = head->local_next;
+			delete node;
+		}
+		return;
+	}
+
+	// 整条链表一次压栈；出栈只有整体交换，CAS压栈不存在ABA问题
+	PendingFunctor* top = s_free_functors_.load(std::memory_order_relaxed);
+	do {
+		tail->local_next = top;
+	} while (!s_free_functors_.compare_exchange_weak(top, head, std::memory_order_release,
+													 std::memory_order_relaxed));
+}
+
+void EventLoop::EnableMetrics(void) {
+	if (!metrics_) {
+		metrics_.reset(new EventLoopMetrics());
+	}
+}
+
+void EventLoop::UpdateLatency(Timestamp now) {
+	int64_t busy = elapsed_us(poll_return_time_, now);
+	if (metrics_) {
+		metrics_->RecordBusy(busy);
+	}
+	int64_t avg = latency_us_.load(std::memory_order_relaxed);
+	// 1/8权重的指数平均，单次尖峰不会让负载均衡立刻避开该loop
+	latency_us_.store(avg + (std::max<int64_t>(busy, 0) - avg) / 8, std::memory_order_relaxed);
+}
+
 void EventLoop::PrintActiveChannels(void) const {
 	for (const EventChannel* channel : active_channels_) {
 		LOG_TRACE << "{" << channel->ReventsToString() << "}";
@@ -31,20 +31,31 @@
 #include <functional>
 #include <vector>
 #include "brsdk/mix/types.hpp"
-#include "brsdk/lock/mutex.hpp"
+#include "brsdk/ds/mpsc_queue.hpp"
 #include "brsdk/thread/current_thread.hpp"
 #include "brsdk/time/timestamp.hpp"
 #include "event_typedef.hpp"
+#include "loop_metrics.hpp"
 #include "timer.hpp"
 
 namespace brsdk {
 
 namespace net {
 
+class EventLoopWatchdog;
+
 class EventLoop : noncopyable {
 public:
 
 	EventLoop();
+	/**
+	 * @brief 指定定时器实现
+	 * 
+	 * @param timer_wheel_tick_ms 时间轮刻度(毫秒)
+	 * - 0 有序集合定时器，定时精确，适合定时器少的场景
+	 * - >0 分层时间轮定时器，O(1)添加/取消，适合每个连接都有超时定时器的场景
+	 */
+	explicit EventLoop(int timer_wheel_tick_ms);
 	~EventLoop();
 
 	// 启动loop，只能在loop线程中调用，成为loop线程
@@ -62,14 +73,66 @@ public:
 		return iteration_;
 	}
 
+	// 每轮迭代处理事件与回调的耗时(微秒，指数平均)，不含阻塞等待，可跨线程读取
+	int64_t latency_us(void) const {
+		return latency_us_.load(std::memory_order_relaxed);
+	}
+
+	// 被流控暂停读取的连接数，可跨线程读取
+	int read_paused(void) const {
+		return read_paused_.load(std::memory_order_relaxed);
+	}
+	// 本loop上连接被流控暂停读取的累计时间(微秒)，不含仍在暂停的部分，可跨线程读取
+	int64_t read_paused_us(void) const {
+		return read_paused_us_.load(std::memory_order_relaxed);
+	}
+	/**
+	 * @brief 开启运行指标统计：轮询等待/处理耗时、活动通道数、待处理回调耗时与积压、
+	 *        定时器延迟、单个回调耗时，未开启时loop不做额外计时
+	 * @warning 在loop启动前或者loop线程内调用
+	 */
+	void EnableMetrics(void);
+	// 运行指标，未开启时为nullptr，可跨线程读取
+	EventLoopMetrics* metrics(void) const {
+		return metrics_.get();
+	}
+
+	// 看门狗心跳，可跨线程读取
+	// 本次迭代开始处理事件的时间(微秒)，阻塞在轮询器上时为0
+	int64_t busy_since_us(void) const {
+		return busy_since_us_.load(std::memory_order_relaxed);
+	}
+	// 正在处理的通道fd，处理待处理回调时为-1
+	int handling_fd(void) const {
+		return handling_fd_.load(std::memory_order_relaxed);
+	}
+	// loop线程id
+	pid_t tid(void) const {
+		return tid_;
+	}
+	// 由看门狗设置，loop析构时取消监视
+	void set_watchdog(EventLoopWatchdog* watchdog) {
+		watchdog_.store(watchdog);
+	}
+
+	// 连接暂停/恢复读取时更新统计，由连接在loop线程内调用
+	void AddReadPaused(int delta, int64_t paused_us) {
+		read_paused_.fetch_add(delta, std::memory_order_relaxed);
+		read_paused_us_.fetch_add(paused_us, std::memory_order_relaxed);
+	}
+
 	// 在loop循环中去执行的回调接口
 	// 如果是当前loop线程调用，则直接执行
 	void RunInLoop(EventFunctor cb);
 
 	// 放到queue里，之后由loop循环调用
-	void QueueInLoop(EventCallback cb);
+	// 无锁入队，多生产者线程并发投递不会互相阻塞
+	void QueueInLoop(EventFunctor cb);
 
-	size_t queue_size(void) const;
+	// 待处理回调数量，近似值
+	size_t queue_size(void) const {
+		return pending_count_.load(std::memory_order_relaxed);
+	}
 
 	// 在某个事件点执行
 	TimerId RunAt(Timestamp time, TimerCallback cb);
@@ -79,13 +142,20 @@ public:
 	TimerId RunEvery(double interval, TimerCallback cb);
 	// 取消定时器
 	void cancel(TimerId timer_id);
+	// 时间轮刻度，0表示未使用时间轮
+	int timer_wheel_tick_ms(void) const {
+		return timer_wheel_tick_ms_;
+	}
 
 	// !!!:内部接口
 	// 唤醒poller，当没有事件时，但是有回调接口需要执行，需要唤醒loop
+	// 只有loop阻塞(或即将阻塞)在轮询器上时才会真正写eventfd
 	void wakeup(void);
 	void UpdateChannel(EventChannel* channel);
 	void RemoveChannel(EventChannel* channel);
 	bool HasChannel(EventChannel* channel);
+	// 轮询器是否支持边沿触发
+	bool SupportsEdgeTriggered(void) const;
 
 	// 如果不是loop线程内则异常
 	void AssertInLoopThread(void) {
@@ -121,12 +191,28 @@ public:
 	static EventLoop* GetEventLoopOfCurrentThead(void);
 
 private:
+	// 待处理回调节点
+	struct PendingFunctor : ds::MpscQueueNode {
+		explicit PendingFunctor(EventFunctor&& f) : functor(std::move(f)) {}
+		EventFunctor functor;
+		PendingFunctor* local_next = nullptr;	///< 取出后本地链表使用
+	};
+
+	// 分配回调节点，优先复用已回收的节点
+	static PendingFunctor* NewPendingFunctor(EventFunctor&& cb);
+	// 回收执行完的回调节点链表
+	static void RecyclePendingFunctors(PendingFunctor* head, PendingFunctor* tail, size_t count);
+
+	// 轮询超时时间，有待处理回调或者需要退出时不阻塞
+	int PollTimeout(int timeout_ms);
 	// 未在loop线程中时，异常退出
 	void AbortNotInLoopThread(void);
 	// waked up去处理读事件
 	void HandleWakeupRead(void);
 	// 处理就绪函数
 	void DoPendingFunctors(void);
+	// 更新迭代处理耗时，now为本次迭代结束时间
+	void UpdateLatency(Timestamp now);
 
 	// 调试用
 	void PrintActiveChannels(void) const;
@@ -136,9 +222,17 @@ private:
 	std::atomic_bool event_handling_;			///< 事件处理中
 	std::atomic_bool calling_pending_functors_;	///< 就绪函数调用中
 	int64_t iteration_;
+	std::atomic<int64_t> latency_us_;				///< 迭代处理耗时(微秒，指数平均)
+	std::atomic_int read_paused_;					///< 流控暂停读取的连接数
+	std::atomic<int64_t> read_paused_us_;			///< 流控暂停读取累计时间(微秒)
+	std::unique_ptr<EventLoopMetrics> metrics_;		///< 运行指标，未开启时为空
+	std::atomic<int64_t> busy_since_us_;			///< 本次迭代开始处理的时间(微秒)，轮询中为0
+	std::atomic_int handling_fd_;					///< 正在处理的通道fd
+	std::atomic<EventLoopWatchdog*> watchdog_;		///< 监视本loop的看门狗
 	const pid_t tid_;
 	Timestamp poll_return_time_;					///< 轮询器返回时间
 	std::unique_ptr<EventPoller> poller_;			///< 轮询器
+	const int timer_wheel_tick_ms_;					///< 时间轮刻度
 	std::unique_ptr<TimerQueue> timer_queue_;		///< 定时器队列
 	int wakeup_fd_;									///< 唤醒描述符，loop自己使用，主要是没有事件发生，但是又有回调函数需要执行时需要唤醒
 	std::unique_ptr<EventChannel> wakeup_channel_;
@@ -147,8 +241,13 @@ private:
 	EventChanneList active_channels_;		///< 活动通道
 	EventChannel* current_active_channel_;	///< 当前活动通道
 
-	mutable MutexLock mutex_;
-	std::vector<EventFunctor> pending_functors_ GUARDED_BY(mutex_);
+	std::atomic_bool polling_;						///< loop阻塞(或即将阻塞)在轮询器上
+	std::atomic_bool wakeup_pending_;				///< eventfd已写入尚未读取，避免重复写
+	std::atomic<size_t> pending_count_;				///< 待处理回调数量
+	ds::MpscQueue<PendingFunctor> pending_functors_;	///< 待处理回调队列
+
+	static std::atomic<PendingFunctor*> s_free_functors_;	///< 全局空闲回调节点栈
+	static std::atomic<size_t> s_free_count_;				///< 空闲节点数，近似值
 };
 
 } // namespace net
@@ -40,7 +40,8 @@ EventLoopThread::EventLoopThread(const ThreadInitCallback& cb, const std::string
 	  thread_(std::bind(&EventLoopThread::ThreadFunc, this), name),
 	  mutex_(),
 	  cond_(mutex_),
-	  callback_(cb) {
+	  callback_(cb),
+	  timer_wheel_tick_ms_(0) {
 }
 
 EventLoopThread::~EventLoopThread() {
@@ -78,7 +79,7 @@ EventLoop* EventLoopThread::StartLoop(void) {
 
 void EventLoopThread::ThreadFunc(void) {
 	// loop在线程栈里边
-	EventLoop loop;
+	EventLoop loop(timer_wheel_tick_ms_);
 
 	if (callback_) {
 		callback_(&loop);
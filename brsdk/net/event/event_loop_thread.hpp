@@ -42,6 +42,10 @@ public:
 					const std::string& name = std::string());
 	~EventLoopThread();
 	EventLoop* StartLoop(void);
+	// 设置loop的时间轮刻度，必须在StartLoop之前调用
+	void set_timer_wheel_tick(int tick_ms) {
+		timer_wheel_tick_ms_ = tick_ms;
+	}
 private:
 	void ThreadFunc(void);
 
@@ -51,6 +55,7 @@ private:
 	MutexLock mutex_;
 	Condition cond_ GUARDED_BY(mutex_);
 	ThreadInitCallback callback_;
+	int timer_wheel_tick_ms_;				///< 时间轮刻度，0不使用
 };
 
 } // namespace net
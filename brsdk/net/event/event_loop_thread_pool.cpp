@@ -31,17 +31,50 @@
 #include "event_loop_thread.hpp"
 #include "event_loop.hpp"
 #include <stdio.h>
+#include <string.h>
+#include <algorithm>
 
 namespace brsdk {
 
 namespace net {
 
+const int EventLoopThreadPool::kVirtualNodes;
+
+namespace {
+
+// 迭代耗时相差在该范围内视为相同，再按连接数比较，避免突发连接全部涌向同一个loop
+const int64_t kLatencyToleranceUs = 50;
+
+uint32_t fnv1a(const void* data, size_t len) {
+	const uint8_t* p = static_cast<const uint8_t*>(data);
+	uint32_t h = 2166136261u;
+	for (size_t i = 0; i < len; i++) {
+		h ^= p[i];
+		h *= 16777619u;
+	}
+	return h;
+}
+
+// murmur3终结混合，让相邻输入在环上分散
+uint32_t mix(uint32_t h) {
+	h ^= h >> 16;
+	h *= 0x85ebca6bu;
+	h ^= h >> 13;
+	h *= 0xc2b2ae35u;
+	h ^= h >> 16;
+	return h;
+}
+
+} // namespace
+
 EventLoopThreadPool::EventLoopThreadPool(EventLoop* baseloop, const std::string& name) 
 	: baseloop_(baseloop),
 	  name_(name),
 	  started_(false),
 	  threadnum_(0),
-	  next_(0) {
+	  next_(0),
+	  timer_wheel_tick_ms_(0),
+	  load_balance_(kRoundRobin) {
 }
 
 EventLoopThreadPool::~EventLoopThreadPool() {
@@ -55,12 +88,18 @@ void EventLoopThreadPool::start(const ThreadInitCallback& cb) {
 	for (int i = 0; i < threadnum_; i++) {
 		std::string thread_name = name_ + std::to_string(i);
 		EventLoopThread* t = new EventLoopThread(cb, thread_name);
+		t->set_timer_wheel_tick(timer_wheel_tick_ms_);
 		// 线程入队
 		threads_.push_back(std::unique_ptr<EventLoopThread>(t));
 		// loop入队
 		loops_.push_back(t->StartLoop());
 	}
 
+	loads_.assign(loops_.size(), 0);
+	if (load_balance_ == kConsistentHash) {
+		BuildHashRing();
+	}
+
 	// 不使用线程池，则使用主loop
 	if (!threadnum_ && cb) {
 		cb(baseloop_);
@@ -91,12 +130,124 @@ EventLoop* EventLoopThreadPool::GetLoopForHash(size_t hash) {
 	EventLoop* loop = baseloop_;
 
 	if (!loops_.empty()) {
-		loop = loops_[hash & loops_.size()];
+		loop = loops_[hash % loops_.size()];
 	}
 
 	return loop;
 }
 
+EventLoop* EventLoopThreadPool::GetLoopForPeer(const Address& peer) {
+	baseloop_->AssertInLoopThread();
+
+	if (loops_.empty()) {
+		return baseloop_;
+	}
+
+	switch (load_balance_) {
+	case kLeastConnections:
+		return GetLeastConnectionsLoop();
+	case kLeastLatency:
+		return GetLeastLatencyLoop();
+	case kConsistentHash:
+		return GetConsistentHashLoop(peer);
+	default:
+		return GetNextLoop();
+	}
+}
+
+EventLoop* EventLoopThreadPool::GetLeastConnectionsLoop(void) {
+	// 从轮询位置开始比较，连接数相同时依次分配
+	size_t n = loops_.size();
+	size_t best = static_cast<size_t>(next_);
+	for (size_t i = 1; i < n; i++) {
+		size_t k = (static_cast<size_t>(next_) + i) % n;
+		if (loads_[k] < loads_[best]) {
+			best = k;
+		}
+	}
+
+	next_ = static_cast<int>((best + 1) % n);
+	return loops_[best];
+}
+
+EventLoop* EventLoopThreadPool::GetLeastLatencyLoop(void) {
+	size_t n = loops_.size();
+	size_t best = static_cast<size_t>(next_);
+	int64_t best_latency = loops_[best]->latency_us() / kLatencyToleranceUs;
+	for (size_t i = 1; i < n; i++) {
+		size_t k = (static_cast<size_t>(next_) + i) % n;
+		int64_t latency = loops_[k]->latency_us() / kLatencyToleranceUs;
+		if (latency < best_latency || (latency == best_latency && loads_[k] < loads_[best])) {
+			best = k;
+			best_latency = latency;
+		}
+	}
+
+	next_ = static_cast<int>((best + 1) % n);
+	return loops_[best];
+}
+
+EventLoop* EventLoopThreadPool::GetConsistentHashLoop(const Address& peer) {
+	const sock_addr_t* addr = peer.addr();
+	uint32_t h = 0;
+	// 只取ip，同一主机的多个连接落在同一loop
+	if (peer.family() == AF_INET) {
+		h = mix(fnv1a(&addr->sin.sin_addr, sizeof(addr->sin.sin_addr)));
+	} else if (peer.family() == AF_INET6) {
+		h = mix(fnv1a(&addr->sin6.sin6_addr, sizeof(addr->sin6.sin6_addr)));
+	} else {
+		return GetNextLoop();
+	}
+
+	auto it = std::lower_bound(ring_.begin(), ring_.end(), std::make_pair(h, 0));
+	if (it == ring_.end()) {
+		it = ring_.begin();
+	}
+	return loops_[it->second];
+}
+
+void EventLoopThreadPool::BuildHashRing(void) {
+	ring_.clear();
+	ring_.reserve(loops_.size() * kVirtualNodes);
+	for (size_t i = 0; i < loops_.size(); i++) {
+		for (int v = 0; v < kVirtualNodes; v++) {
+			uint32_t key[2] = {static_cast<uint32_t>(i), static_cast<uint32_t>(v)};
+			ring_.push_back(std::make_pair(mix(fnv1a(key, sizeof(key))), static_cast<int>(i)));
+		}
+	}
+	std::sort(ring_.begin(), ring_.end());
+}
+
+int EventLoopThreadPool::IndexOf(EventLoop* loop) const {
+	for (size_t i = 0; i < loops_.size(); i++) {
+		if (loops_[i] == loop) {
+			return static_cast<int>(i);
+		}
+	}
+	return -1;
+}
+
+void EventLoopThreadPool::IncreaseLoad(EventLoop* loop) {
+	baseloop_->AssertInLoopThread();
+	int i = IndexOf(loop);
+	if (i >= 0) {
+		loads_[i]++;
+	}
+}
+
+void EventLoopThreadPool::DecreaseLoad(EventLoop* loop) {
+	baseloop_->AssertInLoopThread();
+	int i = IndexOf(loop);
+	if (i >= 0 && loads_[i] > 0) {
+		loads_[i]--;
+	}
+}
+
+int EventLoopThreadPool::load(EventLoop* loop) const {
+	int i = IndexOf(loop);
+	return i >= 0 ? loads_[i] : 0;
+}
+
 std::vector<EventLoop*> EventLoopThreadPool::GetAllLoops(void) {
 	baseloop_->AssertInLoopThread();
 
@@ -28,6 +28,7 @@
  */
 #pragma once
 
+#include <utility>
 #include "brsdk/mix/noncopyable.hpp"
 #include "event_typedef.hpp"
 
@@ -37,6 +38,17 @@ namespace net {
 	
 class EventLoopThreadPool : noncopyable {
 public:
+	// 新连接选择loop的策略
+	enum LoadBalance {
+		kRoundRobin,		///< 轮询
+		kLeastConnections,	///< 连接数最少
+		kLeastLatency,		///< 迭代处理耗时最短，连接负载不均时优于连接数
+		kConsistentHash,	///< 按对端ip一致性哈希，同一主机的连接落在同一loop
+	};
+
+	// 一致性哈希环上每个loop的虚拟节点数
+	static const int kVirtualNodes = 64;
+
 	// baseloop为线程池的主loop，acceptor都在主loop中，用户层添加新的也在主loop中
 	// FIXME:用户tcp客户端/udp如何利用线程池
 	EventLoopThreadPool(EventLoop* baseloop, const std::string& name);
@@ -46,12 +58,34 @@ public:
 		threadnum_ = num;
 	}
 
+	// 线程池内loop使用时间轮定时器，必须在start之前调用
+	void set_timer_wheel_tick(int tick_ms) {
+		timer_wheel_tick_ms_ = tick_ms;
+	}
+
+	// 选择策略，必须在start之前调用
+	void set_load_balance(LoadBalance policy) {
+		load_balance_ = policy;
+	}
+
 	void start(const ThreadInitCallback& cb = ThreadInitCallback());
 
 	// 循序取一个loop(应该由baseLoop里的事件处理调用)
 	EventLoop* GetNextLoop(void);
-	// 随机取一个loop
+	// 按哈希值取一个loop
 	EventLoop* GetLoopForHash(size_t hash);
+	// 按选择策略为对端peer的新连接取一个loop(应该由baseLoop里的事件处理调用)
+	EventLoop* GetLoopForPeer(const Address& peer);
+	/**
+	 * @brief 连接建立/移除时维护loop负载计数，供kLeastConnections/kLeastLatency使用
+	 * @details 应该由baseLoop里的事件处理调用
+	 *
+	 * @param loop 连接所在loop
+	 */
+	void IncreaseLoad(EventLoop* loop);
+	void DecreaseLoad(EventLoop* loop);
+	// loop上的连接数
+	int load(EventLoop* loop) const;
 	// 获取全部loop
 	std::vector<EventLoop*> GetAllLoops(void);
 
@@ -64,13 +98,24 @@ public:
 	}
 
 private:
+	// loop在loops_中的下标，不属于线程池返回-1
+	int IndexOf(EventLoop* loop) const;
+	EventLoop* GetLeastConnectionsLoop(void);
+	EventLoop* GetLeastLatencyLoop(void);
+	EventLoop* GetConsistentHashLoop(const Address& peer);
+	void BuildHashRing(void);
+
 	EventLoop* baseloop_;	///< 主loop
 	std::string name_;		///< 名称
 	bool started_;			///< 开始标记
 	int threadnum_;			///< 线程数
 	int next_;				///< 下个EventLoop的编号，一个loop对应于一个线程
+	int timer_wheel_tick_ms_;	///< 时间轮刻度
+	LoadBalance load_balance_;	///< 选择策略
 	std::vector<std::unique_ptr<EventLoopThread>> threads_;
 	std::vector<EventLoop*> loops_;
+	std::vector<int> loads_;	///< 各loop连接数，与loops_一一对应
+	std::vector<std::pair<uint32_t, int>> ring_;	///< 一致性哈希环，(哈希点, loop下标)
 };
 
 } // namespace net
@@ -31,6 +31,7 @@
 #include <functional>
 #include <vector>
 #include <map>
+#include "brsdk/mix/inline_function.hpp"
 #include "brsdk/time/timestamp.hpp"
 #include "brsdk/net/buffer.hpp"
 #include "brsdk/net/socket/address.hpp"
@@ -85,7 +86,6 @@ class EventPoller;
 // 5.IO操作；
 class EventChannel;
 using EventChanneList = std::vector<EventChannel*>;
-using EventChannelMap = std::map<int, EventChannel*>;
 
 // 网络连接，代表一个已经建立的连接
 // 实际IO在连接中处理
@@ -124,15 +124,15 @@ using TcpConnectionPtr = std::shared_ptr<TcpConnection>;
 using ThreadInitCallback = std::function<void(EventLoop*)>;
 // 事件回调
 using EventCallback = std::function<void()>;
-// loop处理接口
-using EventFunctor = std::function<void()>;
+// loop处理接口，只移动，小对象不分配内存
+using EventFunctor = InlineFunction<void()>;
 using ReadEventCallback = std::function<void(Timestamp)>;
 // 新连接回调
 using AcceptNewConnectionCallback = std::function<void(int sockfd, const Address& addr)>;
 using ConnectorNewConnectionCallback = std::function<void(int sockfd)>;
 using ConnectorFailedConnCallback = std::function<void(const Address& peer_addr, const Address& local_addr)>;
-// 定时器超时
-using TimerCallback = std::function<void()>;
+// 定时器超时，只移动，小对象不分配内存
+using TimerCallback = InlineFunction<void()>;
 // tcp连接成功
 using TcpConnectionCallback = std::function<void(const TcpConnectionPtr&)>;
 // tcp连接失败
@@ -145,6 +145,8 @@ using TcpWriteCompleteCallbak = std::function<void(const TcpConnectionPtr&)>;
 using TcpHighWaterMarkCallbak = std::function<void(const TcpConnectionPtr&, size_t)>;
 // tcp消息接收成功
 using TcpMessageCallbak = std::function<void(const TcpConnectionPtr&, NetBuffer*, Timestamp)>;
+// udp数据报接收，datagram仅在回调期间有效
+using UdpMessageCallback = std::function<void(const str::StringPiece& datagram, const Address& peer, Timestamp)>;
 
 class TcpClient;
 class TcpServer;
@@ -0,0 +1,123 @@
+/**
+ * MIT License
+ *
+ * Copyright © 2021 <Jerry.Yu>.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the “Software”), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * @file loop_metrics.cpp
+ * @brief 事件循环运行指标
+ * @author Jerry.Yu (jerry.yu512@outlook.com)
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright MIT License
+ *
+ */
+#include "loop_metrics.hpp"
+#include <stdio.h>
+#include <algorithm>
+
+namespace brsdk {
+
+namespace net {
+
+const int LatencyHistogram::kSubBucketBits;
+const int LatencyHistogram::kSubBuckets;
+const int64_t LatencyHistogram::kMaxValue;
+const int LatencyHistogram::kBuckets;
+
+LatencyHistogram::LatencyHistogram() : count_(0), sum_(0), max_(0) {
+	for (int i = 0; i < kBuckets; i++) {
+		counts_[i].store(0, std::memory_order_relaxed);
+	}
+}
+
+int64_t LatencyHistogram::BucketUpper(int bucket) {
+	if (bucket < kSubBuckets) {
+		return bucket;
+	}
+	int shift = bucket / kSubBuckets - 1;
+	int64_t sub = bucket % kSubBuckets + kSubBuckets;
+	return ((sub + 1) << shift) - 1;
+}
+
+LatencyHistogram::Snapshot LatencyHistogram::snapshot(void) const {
+	Snapshot s;
+	for (int i = 0; i < kBuckets; i++) {
+		s.counts_[i] = counts_[i].load(std::memory_order_relaxed);
+		s.count_ += s.counts_[i];
+	}
+	// 总数以各桶之和为准，与分位数计算保持一致
+	s.sum_ = sum_.load(std::memory_order_relaxed);
+	s.max_ = max_.load(std::memory_order_relaxed);
+	return s;
+}
+
+int64_t LatencyHistogram::Snapshot::percentile(double q) const {
+	if (count_ <= 0) {
+		return 0;
+	}
+
+	q = std::min(std::max(q, 0.0), 1.0);
+	int64_t rank = std::max<int64_t>(static_cast<int64_t>(q * count_ + 0.5), 1);
+	int64_t seen = 0;
+	for (int i = 0; i < kBuckets; i++) {
+		seen += counts_[i];
+		if (seen >= rank) {
+			return std::min(BucketUpper(i), max_);
+		}
+	}
+	return max_;
+}
+
+LatencyHistogram::Snapshot LatencyHistogram::Snapshot::since(const Snapshot& earlier) const {
+	Snapshot s;
+	for (int i = 0; i < kBuckets; i++) {
+		s.counts_[i] = std::max<int64_t>(counts_[i] - earlier.counts_[i], 0);
+		s.count_ += s.counts_[i];
+		if (s.counts_[i] > 0) {
+			s.max_ = std::min(BucketUpper(i), max_);
+		}
+	}
+	s.sum_ = std::max<int64_t>(sum_ - earlier.sum_, 0);
+	return s;
+}
+
+std::string LatencyHistogram::Snapshot::ToString(void) const {
+	char buf[160];
+	snprintf(buf, sizeof(buf), "n=%lld mean=%.1f p50=%lld p90=%lld p99=%lld p999=%lld max=%lld",
+			 static_cast<long long>(count_), mean(),
+			 static_cast<long long>(percentile(0.5)), static_cast<long long>(percentile(0.9)),
+			 static_cast<long long>(percentile(0.99)), static_cast<long long>(percentile(0.999)),
+			 static_cast<long long>(max_));
+	return buf;
+}
+
+std::string EventLoopMetrics::ToString(void) const {
+	std::string s;
+	s += "poll_wait_us{" + poll_wait_us_.snapshot().ToString() + "} ";
+	s += "busy_us{" + busy_us_.snapshot().ToString() + "} ";
+	s += "active_channels{" + active_channels_.snapshot().ToString() + "} ";
+	s += "pending_functors_us{" + pending_functors_us_.snapshot().ToString() + "} ";
+	s += "timer_lateness_us{" + timer_lateness_us_.snapshot().ToString() + "} ";
+	s += "callback_us{" + callback_us_.snapshot().ToString() + "} ";
+	s += "pending_high_water=" + std::to_string(pending_high_water());
+	return s;
+}
+
+} // namespace net
+
+} // namespace brsdk
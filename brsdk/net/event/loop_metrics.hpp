@@ -0,0 +1,183 @@
+/**
+ * MIT License
+ *
+ * Copyright © 2021 <Jerry.Yu>.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the “Software”), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * @file loop_metrics.hpp
+ * @brief 事件循环运行指标
+ * @author Jerry.Yu (jerry.yu512@outlook.com)
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright MIT License
+ *
+ */
+#pragma once
+#include <stdint.h>
+#include <atomic>
+#include <string>
+#include <vector>
+#include "brsdk/mix/noncopyable.hpp"
+
+namespace brsdk {
+
+namespace net {
+
+/**
+ * @brief HDR风格的对数分桶直方图
+ * @details
+ * - 每个2的幂区间再均分为16个子桶，相对误差不超过1/16，小于16的值精确计数
+ * - 只允许一个线程记录(loop线程)，记录只有无锁的relaxed读写，没有原子读改写指令
+ * - 任意线程可随时读取快照，不需要停止记录线程，快照各桶之间不保证严格一致
+ */
+class LatencyHistogram : noncopyable {
+public:
+	// 子桶位数
+	static const int kSubBucketBits = 4;
+	static const int kSubBuckets = 1 << kSubBucketBits;
+	// 可记录的最大值，超出的按最大值计
+	static const int64_t kMaxValue = (INT64_C(1) << 36) - 1;
+	static const int kBuckets = (36 - kSubBucketBits + 1) * kSubBuckets;
+
+	/**
+	 * @brief 某一时刻的直方图拷贝，用于计算分位数，或者与之前的快照相减得到区间内的分布
+	 */
+	class Snapshot {
+	public:
+		Snapshot() : counts_(kBuckets, 0), count_(0), sum_(0), max_(0) {}
+
+		int64_t count(void) const { return count_; }
+		int64_t max(void) const { return max_; }
+		double mean(void) const { return count_ > 0 ? static_cast<double>(sum_) / count_ : 0.0; }
+		/**
+		 * @brief 分位数
+		 *
+		 * @param q 0~1，如0.99
+		 * @return int64_t 所在桶的上界，不超过最大值
+		 */
+		int64_t percentile(double q) const;
+		// 本快照相对更早快照的增量，最大值取区间内最高非空桶的上界
+		Snapshot since(const Snapshot& earlier) const;
+		// 如 "n=100 mean=3.2 p50=3 p90=5 p99=9 p999=15 max=17"
+		std::string ToString(void) const;
+
+	private:
+		friend class LatencyHistogram;
+
+		std::vector<int64_t> counts_;	///< 各桶计数
+		int64_t count_;					///< 总数
+		int64_t sum_;					///< 总和
+		int64_t max_;					///< 最大值
+	};
+
+	LatencyHistogram();
+
+	// 记录一个值，负值按0计，只能在记录线程调用
+	void record(int64_t value) {
+		value = value < 0 ? 0 : (value > kMaxValue ? kMaxValue : value);
+		std::atomic<int64_t>& c = counts_[BucketOf(value)];
+		c.store(c.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+		count_.store(count_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+		sum_.store(sum_.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+		if (value > max_.load(std::memory_order_relaxed)) {
+			max_.store(value, std::memory_order_relaxed);
+		}
+	}
+
+	int64_t count(void) const { return count_.load(std::memory_order_relaxed); }
+	int64_t max(void) const { return max_.load(std::memory_order_relaxed); }
+	// 当前数据的拷贝，可跨线程调用
+	Snapshot snapshot(void) const;
+
+	static int BucketOf(int64_t value) {
+		if (value < kSubBuckets) {
+			return static_cast<int>(value);
+		}
+		int shift = 63 - __builtin_clzll(static_cast<uint64_t>(value)) - kSubBucketBits;
+		return (shift + 1) * kSubBuckets + static_cast<int>((value >> shift) - kSubBuckets);
+	}
+	// 桶能表示的最大值
+	static int64_t BucketUpper(int bucket);
+
+private:
+	std::atomic<int64_t> counts_[kBuckets];	///< 各桶计数
+	std::atomic<int64_t> count_;			///< 总数
+	std::atomic<int64_t> sum_;				///< 总和
+	std::atomic<int64_t> max_;				///< 最大值
+};
+
+/**
+ * @brief 事件循环运行指标，由 @c EventLoop::EnableMetrics 开启
+ * @details 记录接口只由loop线程调用，读取接口可在任意线程调用，不加锁也不打断loop
+ */
+class EventLoopMetrics : noncopyable {
+public:
+	EventLoopMetrics() : pending_high_water_(0), slowest_callback_us_(0) {}
+
+	// 每次轮询阻塞等待的时间(微秒)
+	const LatencyHistogram& poll_wait_us(void) const { return poll_wait_us_; }
+	// 每次迭代处理事件与回调的时间(微秒)
+	const LatencyHistogram& busy_us(void) const { return busy_us_; }
+	// 每次迭代的活动通道数
+	const LatencyHistogram& active_channels(void) const { return active_channels_; }
+	// 每批待处理回调的处理时间(微秒)，没有待处理回调时不记录
+	const LatencyHistogram& pending_functors_us(void) const { return pending_functors_us_; }
+	// 定时器实际触发时间与到期时间之差(微秒)
+	const LatencyHistogram& timer_lateness_us(void) const { return timer_lateness_us_; }
+	// 单个通道事件处理或者单个待处理回调的耗时(微秒)，定时器回调计入定时器通道
+	const LatencyHistogram& callback_us(void) const { return callback_us_; }
+	// 单次取出的待处理回调数的最大值
+	int64_t pending_high_water(void) const { return pending_high_water_.load(std::memory_order_relaxed); }
+	// 取出上次调用以来最慢的单个回调耗时(微秒)并清零，用于按周期上报
+	int64_t TakeSlowestCallback(void) { return slowest_callback_us_.exchange(0, std::memory_order_relaxed); }
+	// 全部指标的文本摘要
+	std::string ToString(void) const;
+
+	// !!!:以下由loop线程调用
+	void RecordPoll(int64_t wait_us, size_t active) {
+		poll_wait_us_.record(wait_us);
+		active_channels_.record(static_cast<int64_t>(active));
+	}
+	void RecordBusy(int64_t busy_us) { busy_us_.record(busy_us); }
+	void RecordPending(size_t count, int64_t elapsed_us) {
+		pending_functors_us_.record(elapsed_us);
+		if (static_cast<int64_t>(count) > pending_high_water_.load(std::memory_order_relaxed)) {
+			pending_high_water_.store(static_cast<int64_t>(count), std::memory_order_relaxed);
+		}
+	}
+	void RecordTimer(int64_t lateness_us) { timer_lateness_us_.record(lateness_us); }
+	void RecordCallback(int64_t elapsed_us) {
+		callback_us_.record(elapsed_us);
+		if (elapsed_us > slowest_callback_us_.load(std::memory_order_relaxed)) {
+			slowest_callback_us_.store(elapsed_us, std::memory_order_relaxed);
+		}
+	}
+
+private:
+	LatencyHistogram poll_wait_us_;
+	LatencyHistogram busy_us_;
+	LatencyHistogram active_channels_;
+	LatencyHistogram pending_functors_us_;
+	LatencyHistogram timer_lateness_us_;
+	LatencyHistogram callback_us_;
+	std::atomic<int64_t> pending_high_water_;	///< 待处理回调数高水位
+	std::atomic<int64_t> slowest_callback_us_;	///< 本周期最慢回调耗时
+};
+
+} // namespace net
+
+} // namespace brsdk
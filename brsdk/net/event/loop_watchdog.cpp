@@ -0,0 +1,245 @@
+/**
+ * MIT License
+ *
+ * Copyright © 2021 <Jerry.Yu>.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the “Software”), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * @file loop_watchdog.cpp
+ * @brief 事件循环卡顿看门狗
+ * @author Jerry.Yu (jerry.yu512@outlook.com)
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright MIT License
+ *
+ */
+#include "loop_watchdog.hpp"
+#include <assert.h>
+#include <errno.h>
+#include <string.h>
+#include <execinfo.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <algorithm>
+#include "brsdk/thread/current_thread.hpp"
+#include "event_log.hpp"
+#include "event_loop.hpp"
+
+namespace brsdk {
+
+namespace net {
+
+const int EventLoopWatchdog::kDefaultSignal;
+
+namespace {
+
+// 采集的最大栈帧数
+const int kMaxFrames = 64;
+// 等待目标线程响应信号的时间
+const int64_t kCaptureTimeoutUs = 200 * 1000;
+
+// 采集状态，信号处理函数只处理已请求的采集
+enum CaptureState {
+	kCaptureIdle,
+	kCaptureRequested,
+	kCaptureRunning,
+	kCaptureDone,
+};
+
+// 信号处理函数为进程全局，采集一次只进行一个
+MutexLock g_capture_mutex;
+std::atomic_int g_capture_state(kCaptureIdle);
+void* g_capture_frames[kMaxFrames];
+int g_capture_count = 0;
+
+void capture_handler(int) {
+	int expected = kCaptureRequested;
+	if (!g_capture_state.compare_exchange_strong(expected, kCaptureRunning)) {
+		return;
+	}
+
+	int saved_errno = errno;
+	g_capture_count = ::backtrace(g_capture_frames, kMaxFrames);
+	g_capture_state.store(kCaptureDone, std::memory_order_release);
+	errno = saved_errno;
+}
+
+} // namespace
+
+EventLoopWatchdog::EventLoopWatchdog(double threshold, int signo)
+	: threshold_us_(static_cast<int64_t>(threshold * Timestamp::kMicroSecondsPerSecond)),
+	  signo_(signo),
+	  running_(false),
+	  thread_(std::bind(&EventLoopWatchdog::ThreadFunc, this), "loop watchdog"),
+	  mutex_(),
+	  cond_(mutex_),
+	  stalls_(0) {
+}
+
+EventLoopWatchdog::~EventLoopWatchdog() {
+	stop();
+	MutexLockGuard lock(mutex_);
+	for (const Watched& w : loops_) {
+		w.loop->set_watchdog(nullptr);
+	}
+}
+
+void EventLoopWatchdog::start(void) {
+	assert(!thread_.started());
+
+	// backtrace首次调用会加载libgcc，提前调用，避免在信号处理函数中分配内存
+	void* frames[1];
+	::backtrace(frames, 1);
+
+	struct sigaction act;
+	::memset(&act, 0, sizeof(act));
+	act.sa_handler = capture_handler;
+	act.sa_flags = SA_RESTART;
+	sigemptyset(&act.sa_mask);
+	if (::sigaction(signo_, &act, nullptr) < 0) {
+		LOG_SYSERR << "EventLoopWatchdog install signal " << signo_;
+	}
+
+	running_ = true;
+	thread_.start();
+}
+
+void EventLoopWatchdog::stop(void) {
+	if (!running_.exchange(false)) {
+		return;
+	}
+
+	{
+		MutexLockGuard lock(mutex_);
+		cond_.notify();
+	}
+	thread_.join();
+}
+
+void EventLoopWatchdog::watch(EventLoop* loop) {
+	MutexLockGuard lock(mutex_);
+	Watched w;
+	w.loop = loop;
+	w.reported_since = 0;
+	loops_.push_back(w);
+	loop->set_watchdog(this);
+}
+
+void EventLoopWatchdog::unwatch(EventLoop* loop) {
+	MutexLockGuard lock(mutex_);
+	auto it = std::find_if(loops_.begin(), loops_.end(), [loop](const Watched& w) { return w.loop == loop; });
+	if (it != loops_.end()) {
+		loops_.erase(it);
+		loop->set_watchdog(nullptr);
+	}
+}
+
+void EventLoopWatchdog::ThreadFunc(void) {
+	// 检查周期为阈值的1/4，卡顿最多晚报告1/4个阈值
+	double interval = std::min(std::max(threshold_us_ / 4.0 / Timestamp::kMicroSecondsPerSecond, 0.01), 1.0);
+
+	std::vector<Stall> stalls;
+	while (running_) {
+		{
+			MutexLockGuard lock(mutex_);
+			// 持锁检查，stop的通知不会丢失
+			if (running_) {
+				cond_.waitForSeconds(interval);
+			}
+			if (!running_) {
+				break;
+			}
+			collect(&stalls);
+		}
+
+		// 采集调用栈最长等待200ms，日志与回调也可能较慢，期间不能阻塞loop析构时的unwatch
+		for (Stall& stall : stalls) {
+			report(&stall);
+		}
+		stalls.clear();
+	}
+}
+
+void EventLoopWatchdog::collect(std::vector<Stall>* stalls) {
+	for (Watched& w : loops_) {
+		EventLoop* loop = w.loop;
+		int64_t since = loop->busy_since_us();
+		if (0 == since || since == w.reported_since) {
+			continue;
+		}
+
+		int64_t stalled = Timestamp::now().microSecondsSinceEpoch() - since;
+		if (stalled < threshold_us_) {
+			continue;
+		}
+
+		w.reported_since = since;
+		stalls_.fetch_add(1, std::memory_order_relaxed);
+
+		Stall stall;
+		stall.loop = loop;
+		stall.tid = loop->tid();
+		stall.fd = loop->handling_fd();
+		stall.stalled_us = stalled;
+		stalls->push_back(stall);
+	}
+}
+
+void EventLoopWatchdog::report(Stall* stall) {
+	// loop可能已经析构，只使用持锁时记录的信息；线程已退出时tgkill失败
+	if (!capture(stall->tid, &stall->stack)) {
+		stall->stack = "(stack unavailable)\n";
+	}
+
+	LOG_ERROR << "EventLoop " << stall->loop << " tid " << stall->tid << " stalled "
+			  << stall->stalled_us / 1000 << " ms in "
+			  << (stall->fd >= 0 ? "HandleEvent fd = " + std::to_string(stall->fd) : std::string("DoPendingFunctors"))
+			  << ", stack:\n" << stall->stack;
+	if (stall_callback_) {
+		stall_callback_(*stall);
+	}
+}
+
+bool EventLoopWatchdog::capture(pid_t tid, std::string* stack) {
+	MutexLockGuard lock(g_capture_mutex);
+	g_capture_state.store(kCaptureRequested);
+	if (::syscall(SYS_tgkill, ::getpid(), tid, signo_) < 0) {
+		g_capture_state.store(kCaptureIdle);
+		return false;
+	}
+
+	Timestamp deadline(Timestamp::now().microSecondsSinceEpoch() + kCaptureTimeoutUs);
+	while (g_capture_state.load(std::memory_order_acquire) != kCaptureDone) {
+		if (Timestamp::now() < deadline) {
+			thread::sleepUsec(1000);
+			continue;
+		}
+		// 线程处于不可中断的等待中，撤销请求；处理函数已经开始则等它完成
+		int expected = kCaptureRequested;
+		if (g_capture_state.compare_exchange_strong(expected, kCaptureIdle)) {
+			return false;
+		}
+	}
+
+	// 跳过信号处理函数自身
+	*stack = g_capture_count > 1 ? thread::stackTrace(g_capture_frames + 1, g_capture_count - 1, true) : std::string();
+	g_capture_state.store(kCaptureIdle);
+	return !stack->empty();
+}
+
+} // namespace net
+
+} // namespace brsdk
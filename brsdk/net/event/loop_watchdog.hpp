@@ -0,0 +1,123 @@
+/**
+ * MIT License
+ *
+ * Copyright © 2021 <Jerry.Yu>.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the “Software”), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * @file loop_watchdog.hpp
+ * @brief 事件循环卡顿看门狗
+ * @author Jerry.Yu (jerry.yu512@outlook.com)
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright MIT License
+ *
+ */
+#pragma once
+#include <signal.h>
+#include <stdint.h>
+#include <sys/types.h>
+#include <atomic>
+#include <functional>
+#include <string>
+#include <vector>
+#include "brsdk/lock/condition.hpp"
+#include "brsdk/lock/mutex.hpp"
+#include "brsdk/thread/thread.hpp"
+#include "event_typedef.hpp"
+
+namespace brsdk {
+
+namespace net {
+
+/**
+ * @brief 事件循环卡顿看门狗
+ * @details
+ * - 独立线程周期检查被监视loop的心跳，一次迭代处理事件或者待处理回调超过阈值即认为卡顿
+ * - 卡顿时记录正在处理的通道fd，并向loop线程发送信号，在信号处理函数中采集其调用栈，
+ *   由看门狗线程还原符号后通过日志输出，定位阻塞loop的同步磁盘/DNS等调用
+ * - 同一次卡顿只报告一次
+ * - 信号处理函数使用SA_RESTART安装，被打断的多数阻塞调用会自动重启，sleep类调用会提前返回
+ * - loop析构时自动取消监视，看门狗需要比被监视的loop存活更久，或者先取消监视
+ */
+class EventLoopWatchdog : noncopyable {
+public:
+	// 卡顿信息
+	struct Stall {
+		EventLoop* loop;		///< 卡顿的loop，仅用于标识，回调时可能已取消监视并析构
+		pid_t tid;				///< loop线程id
+		int fd;					///< 正在处理的通道fd，-1表示卡在待处理回调
+		int64_t stalled_us;		///< 已卡顿时间(微秒)
+		std::string stack;		///< loop线程调用栈，采集失败时为空
+	};
+	using StallCallback = std::function<void(const Stall&)>;
+
+	// 默认采集调用栈使用的信号，默认动作为忽略，误投递也不会终止进程
+	static const int kDefaultSignal = SIGURG;
+
+	/**
+	 * @brief 构造
+	 *
+	 * @param threshold 卡顿阈值(秒)
+	 * @param signo 采集调用栈使用的信号，不能与业务使用的信号冲突
+	 */
+	explicit EventLoopWatchdog(double threshold = 1.0, int signo = kDefaultSignal);
+	~EventLoopWatchdog();
+
+	// 卡顿回调，在看门狗线程调用，日志输出之后调用，需在start之前设置；
+	// 调用时不持有看门狗的锁，回调内可以watch/unwatch
+	void SetStallCallback(const StallCallback& cb) { stall_callback_ = cb; }
+
+	// 启动看门狗线程
+	void start(void);
+	// 停止看门狗线程
+	void stop(void);
+
+	// 监视/取消监视loop，线程安全
+	void watch(EventLoop* loop);
+	void unwatch(EventLoop* loop);
+
+	// 已报告的卡顿次数
+	int64_t stalls(void) const { return stalls_.load(std::memory_order_relaxed); }
+
+private:
+	struct Watched {
+		EventLoop* loop;			///< 被监视的loop
+		int64_t reported_since;		///< 已报告卡顿的迭代开始时间
+	};
+
+	void ThreadFunc(void);
+	// 找出超过阈值且未报告的卡顿，只记录loop信息，不采集调用栈
+	void collect(std::vector<Stall>* stalls) REQUIRES(mutex_);
+	// 采集调用栈、输出日志并回调，不持有锁
+	void report(Stall* stall);
+	// 向线程发送信号采集调用栈
+	bool capture(pid_t tid, std::string* stack);
+
+	const int64_t threshold_us_;		///< 卡顿阈值(微秒)
+	const int signo_;					///< 采集调用栈的信号
+	std::atomic_bool running_;			///< 看门狗线程运行中
+	thread::Thread thread_;
+	MutexLock mutex_;
+	Condition cond_ GUARDED_BY(mutex_);
+	std::vector<Watched> loops_ GUARDED_BY(mutex_);	///< 被监视的loop
+	StallCallback stall_callback_;
+	std::atomic<int64_t> stalls_;		///< 已报告的卡顿次数
+};
+
+} // namespace net
+
+} // namespace brsdk
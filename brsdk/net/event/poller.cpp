@@ -38,8 +38,7 @@ EventPoller::~EventPoller() = default;
 
 bool EventPoller::HasChannel(EventChannel* channel) const {
 	AssertInLoopThread();
-	EventChannelMap::const_iterator it = channels_.find(channel->fd());
-	return it != channels_.end() && it->second == channel;
+	return channels_.contains(channel, channel->fd());
 }
 
 } // namespace net
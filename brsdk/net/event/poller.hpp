@@ -27,12 +27,12 @@
  * 
  */
 #pragma once
-#include <map>
 #include <vector>
 #include "brsdk/time/timestamp.hpp"
 #include "brsdk/mix/noncopyable.hpp"
 #include "event_loop.hpp"
 #include "event_typedef.hpp"
+#include "channel_table.hpp"
 
 namespace brsdk {
 
@@ -50,13 +50,15 @@ public:
 	virtual void RemoveChannel(EventChannel* channel) = 0;
 	// 是否有通道
 	virtual bool HasChannel(EventChannel* channel) const;
+	// 是否支持边沿触发通道，不支持时边沿触发标记被忽略
+	virtual bool SupportsEdgeTriggered(void) const { return false; }
 	// 创建默认轮询器
 	static EventPoller* NewDefaultPoller(EventLoop* loop);
 	void AssertInLoopThread(void) const {
 		loop_->AssertInLoopThread();
 	}
 protected:
-	EventChannelMap channels_;	///< 通道映射
+	EventChannelTable channels_;	///< fd索引的通道表
 
 private:
 	EventLoop* loop_;
@@ -30,19 +30,43 @@
 #include "poller.hpp"
 #include "poller_poll.hpp"
 #include "poller_epoll.hpp"
+#include "poller_uring.hpp"
+#include <stdlib.h>
+#include <string.h>
 
 namespace brsdk {
 
 namespace net {
 
 EventPoller* EventPoller::NewDefaultPoller(EventLoop* loop) {
-#ifdef USE_EPOLL
-	LOG_TRACE << "Using epoll.";
-	return new EpollPoller(loop);
+	// 环境变量BRSDK_POLLER可在运行时覆盖编译选项：io_uring/epoll/poll
+	const char* name = ::getenv("BRSDK_POLLER");
+	if (nullptr == name || '\0' == name[0]) {
+#if defined(USE_IO_URING)
+		name = "io_uring";
+#elif defined(USE_EPOLL)
+		name = "epoll";
 #else
+		name = "poll";
+#endif
+	}
+
+	if (0 == strcmp(name, "io_uring")) {
+		if (IoUringPoller::IsSupported()) {
+			LOG_TRACE << "Using io_uring.";
+			return new IoUringPoller(loop);
+		}
+		LOG_WARN << "io_uring is not supported, fall back to epoll.";
+		name = "epoll";
+	}
+
+	if (0 == strcmp(name, "epoll")) {
+		LOG_TRACE << "Using epoll.";
+		return new EpollPoller(loop);
+	}
+
 	LOG_TRACE << "Using poll.";
 	return new PollPoller(loop);
-#endif
 }
 	
 } // namespace net
@@ -100,9 +100,7 @@ void EpollPoller::UpdateChannel(EventChannel* channel) {
 	if (index == kNew || index == kDeleted) {
 		int fd = channel->fd();
 		if (index == kNew) {
-			channels_[fd] = channel;
-		} else {
-
+			channels_.insert(fd, channel);
 		}
 		channel->set_index(kAdded);
 		update(EPOLL_CTL_ADD, channel);
@@ -148,7 +146,14 @@ const char* EpollPoller::OperationToString(int op) {
 
 void EpollPoller::FillActiveChannels(int num_events, EventChanneList* active_channels) {
 	for (int i = 0; i < num_events; i++) {
-		EventChannel* channel = static_cast<EventChannel*>(events_[i].data.ptr);
+		uint64_t data = events_[i].data.u64;
+		int fd = static_cast<int>(data & 0xffffffff);
+		EventChannel* channel = channels_.find(fd);
+		if (nullptr == channel || channels_.generation(fd) != static_cast<uint32_t>(data >> 32)) {
+			// fd已关闭但文件仍被引用(dup/fork)时，内核还会上报已移除通道的事件
+			LOG_WARN << "Drop stale event of fd = " << fd;
+			continue;
+		}
 		channel->set_revents(events_[i].events);
 		active_channels->push_back(channel);
 	}
@@ -157,8 +162,12 @@ void EpollPoller::update(int operation, EventChannel* channel) {
 	struct epoll_event event;
 	memset(&event, 0, sizeof(event));
 	event.events = channel->events();
-	event.data.ptr = channel;
+	if (channel->IsEdgeTriggered()) {
+		event.events |= EPOLLET;
+	}
 	int fd = channel->fd();
+	// 携带generation，用于识别过期事件
+	event.data.u64 = (static_cast<uint64_t>(channels_.generation(fd)) << 32) | static_cast<uint32_t>(fd);
 
 	LOG_TRACE << "epoll_ctl op = " << OperationToString(operation)
 			  << " fd = " << fd << " event = { " << channel->EventsToString() << " }";
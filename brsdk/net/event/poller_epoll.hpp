@@ -45,6 +45,7 @@ public:
 	virtual void UpdateChannel(EventChannel* channel) override;
 	// 通道移除
 	virtual void RemoveChannel(EventChannel* channel) override;
+	bool SupportsEdgeTriggered(void) const override { return true; }
 
 private:
 	static const int kInitEventListSize = 16;
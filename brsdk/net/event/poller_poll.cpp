@@ -45,7 +45,7 @@ PollPoller::PollPoller(EventLoop* loop) : EventPoller(loop) {
 PollPoller::~PollPoller() = default;
 
 Timestamp PollPoller::poll(int timeoutms, EventChanneList* activer_channels) {
-	int evnets_num = ::poll(&*pollfds_.begin(), pollfds_.size(), timeoutms);
+	int evnets_num = ::poll(pollfds_.data(), pollfds_.size(), timeoutms);
 	int errno_back = errno;
 
 	Timestamp now(Timestamp::now());
@@ -67,26 +67,33 @@ Timestamp PollPoller::poll(int timeoutms, EventChanneList* activer_channels) {
 void PollPoller::UpdateChannel(EventChannel* channel) {
 	EventPoller::AssertInLoopThread();
 	LOG_TRACE << "fd = " << channel->fd() << " events = " << channel->events();
-	
-	if (channel->index() < 0) {
+
+	int fd = channel->fd();
+	if (!channels_.contains(channel, fd)) {
+		channels_.insert(fd, channel);
+		channel->set_index(-1);
+	}
+
+	int idx = channel->index();
+	if (channel->IsNoneEvent()) {
+		// 无关心事件时移出数组，poll不再扫描
+		if (idx >= 0) {
+			SwapRemove(idx);
+			channel->set_index(-1);
+		}
+	} else if (idx < 0) {
 		struct pollfd pfd;
 
-		pfd.fd = channel->fd();
+		pfd.fd = fd;
 		pfd.events = static_cast<short>(channel->events());
 		pfd.revents = 0;
 		pollfds_.push_back(pfd);
-		int idx = static_cast<int>(pollfds_.size() - 1);
-		channel->set_index(idx);
-		channels_[pfd.fd] = channel;
+		channel->set_index(static_cast<int>(pollfds_.size() - 1));
 	} else {
-		int idx = channel->index();
 		struct pollfd& pfd = pollfds_[idx];
-		pfd.fd = channel->fd();
+		assert(pfd.fd == fd);
 		pfd.events = static_cast<short>(channel->events());
 		pfd.revents = 0;
-		if (channel->IsNoneEvent()) {
-			pfd.fd = - channel->fd() - 1;
-		}
 	}
 }
 // 通道移除
@@ -94,29 +101,32 @@ void PollPoller::RemoveChannel(EventChannel* channel) {
 	EventPoller::AssertInLoopThread();
 	LOG_TRACE << "fd = " << channel->fd();
 	int idx = channel->index();
-	const struct pollfd& pfd = pollfds_[idx];
-	(void)pfd;
+	if (idx >= 0) {
+		SwapRemove(idx);
+	}
 	size_t n = channels_.erase(channel->fd());
 	(void)n;
-	if (implicit_cast<size_t>(idx) == pollfds_.size() - 1) {
-		pollfds_.pop_back();
-	} else {
-		int channel_at_end = pollfds_.back().fd;
-		iter_swap(pollfds_.begin() + idx, pollfds_.end() - 1);
-		if (channel_at_end < 0) {
-			channel_at_end = - channel_at_end - 1;
-		}
-		channels_[channel_at_end]->set_index(idx);
-		pollfds_.pop_back();
+	channel->set_index(-1);
+}
+
+void PollPoller::SwapRemove(int idx) {
+	assert(implicit_cast<size_t>(idx) < pollfds_.size());
+	if (implicit_cast<size_t>(idx) != pollfds_.size() - 1) {
+		// 末尾元素移到空位，数组保持紧凑
+		pollfds_[idx] = pollfds_.back();
+		EventChannel* moved = channels_.find(pollfds_[idx].fd);
+		assert(moved != nullptr);
+		moved->set_index(idx);
 	}
+	pollfds_.pop_back();
 }
 
 void PollPoller::FillActiveChannels(int num_events, EventChanneList* active_channels) {
 	for (auto pfd = pollfds_.begin(); pfd != pollfds_.end() && num_events > 0; pfd++) {
 		if (pfd->revents > 0) {
 			--num_events;
-			auto ch = channels_.find(pfd->fd);
-			EventChannel* channel = ch->second;
+			EventChannel* channel = channels_.find(pfd->fd);
+			assert(channel != nullptr);
 			channel->set_revents(pfd->revents);
 			active_channels->push_back(channel);
 		}
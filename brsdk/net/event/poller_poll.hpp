@@ -49,6 +49,8 @@ public:
 
 private:
 	void FillActiveChannels(int num_events, EventChanneList* active_channels);
+	// 交换删除，保持pollfd数组紧凑
+	void SwapRemove(int idx);
 
 	using PollFdList = std::vector<struct pollfd>;
 	PollFdList pollfds_;
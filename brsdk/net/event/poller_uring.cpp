@@ -0,0 +1,426 @@
+/**
+ * MIT License
+ * 
+ * Copyright © 2021 <Jerry.Yu>.
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the “Software”), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * 
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ * 
+ * @file poller_uring.cpp
+ * @brief io_uring轮询器
+ * @author Jerry.Yu (jerry.yu512@outlook.com)
+ * @version 1.0.0
+ * @date 2026-10-17
+ * 
+ * @copyright MIT License
+ * 
+ */
+#include "event_log.hpp"
+#include "event_loop.hpp"
+#include "event_channel.hpp"
+#include "poller_uring.hpp"
+
+#include <assert.h>
+#include <errno.h>
+#include <poll.h>
+#include <string.h>
+#include <unistd.h>
+
+#ifdef BRSDK_HAVE_IO_URING
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+
+namespace brsdk {
+
+namespace net {
+
+#ifdef BRSDK_HAVE_IO_URING
+
+namespace {
+
+#ifndef IORING_FEAT_RSRC_TAGS
+#define IORING_FEAT_RSRC_TAGS (1U << 10)
+#endif
+#ifndef IORING_SETUP_COOP_TASKRUN
+#define IORING_SETUP_COOP_TASKRUN (1U << 8)
+#endif
+
+// 内部提交项(取消)的完成项标记
+const uint64_t kInternalData = 1ULL << 63;
+// 需要的内核特性，RSRC_TAGS与multishot poll同在5.13引入
+const unsigned kRequiredFeatures = IORING_FEAT_SINGLE_MMAP | IORING_FEAT_NODROP
+								 | IORING_FEAT_EXT_ARG | IORING_FEAT_RSRC_TAGS;
+
+int io_uring_setup(unsigned entries, struct io_uring_params* p) {
+	return static_cast<int>(::syscall(__NR_io_uring_setup, entries, p));
+}
+
+int io_uring_enter(int fd, unsigned to_submit, unsigned min_complete, unsigned flags,
+				   const void* arg, size_t argsz) {
+	return static_cast<int>(::syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, arg, argsz));
+}
+
+// 创建io_uring，优先使用协作式任务处理，旧内核不支持时去掉该标记
+int setup_ring(unsigned entries, struct io_uring_params* p) {
+	memset(p, 0, sizeof(*p));
+	p->flags = IORING_SETUP_CQSIZE | IORING_SETUP_CLAMP | IORING_SETUP_COOP_TASKRUN;
+	p->cq_entries = entries * 8;
+	int fd = io_uring_setup(entries, p);
+	if (fd < 0 && errno == EINVAL) {
+		memset(p, 0, sizeof(*p));
+		p->flags = IORING_SETUP_CQSIZE | IORING_SETUP_CLAMP;
+		p->cq_entries = entries * 8;
+		fd = io_uring_setup(entries, p);
+	}
+	return fd;
+}
+
+uint64_t make_data(int fd, uint32_t generation) {
+	return (static_cast<uint64_t>(generation) << 32) | static_cast<uint32_t>(fd);
+}
+
+} // namespace
+
+bool IoUringPoller::IsSupported(void) {
+	static const bool supported = []() {
+		struct io_uring_params p;
+		int fd = setup_ring(4, &p);
+		if (fd < 0) {
+			LOG_WARN << "io_uring unavailable: " << strerror(errno);
+			return false;
+		}
+		::close(fd);
+		if ((p.features & kRequiredFeatures) != kRequiredFeatures) {
+			LOG_WARN << "io_uring lacks required features, features = " << p.features;
+			return false;
+		}
+		return true;
+	}();
+	return supported;
+}
+
+IoUringPoller::IoUringPoller(EventLoop* loop)
+	: EventPoller(loop),
+	  ringfd_(-1),
+	  sq_ring_(MAP_FAILED),
+	  cq_ring_(MAP_FAILED),
+	  sq_ring_size_(0),
+	  cq_ring_size_(0),
+	  sqes_(static_cast<struct io_uring_sqe*>(MAP_FAILED)),
+	  sqes_size_(0),
+	  sq_local_tail_(0),
+	  to_submit_(0),
+	  round_(0) {
+	struct io_uring_params p;
+	ringfd_ = setup_ring(kRingEntries, &p);
+	if (ringfd_ < 0) {
+		LOG_SYSFATAL << "IoUringPoller::IoUringPoller";
+	}
+
+	// 5.4之后提交队列与完成队列共用一次映射
+	sq_ring_size_ = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+	cq_ring_size_ = p.cq_off.cqes + p.cq_entries * sizeof(struct io_uring_cqe);
+	if (cq_ring_size_ > sq_ring_size_) {
+		sq_ring_size_ = cq_ring_size_;
+	}
+	cq_ring_size_ = sq_ring_size_;
+	sq_ring_ = ::mmap(nullptr, sq_ring_size_, PROT_READ | PROT_WRITE,
+					  MAP_SHARED | MAP_POPULATE, ringfd_, IORING_OFF_SQ_RING);
+	cq_ring_ = sq_ring_;
+	sqes_size_ = p.sq_entries * sizeof(struct io_uring_sqe);
+	sqes_ = static_cast<struct io_uring_sqe*>(::mmap(nullptr, sqes_size_, PROT_READ | PROT_WRITE,
+					  MAP_SHARED | MAP_POPULATE, ringfd_, IORING_OFF_SQES));
+	if (sq_ring_ == MAP_FAILED || sqes_ == MAP_FAILED) {
+		LOG_SYSFATAL << "IoUringPoller::IoUringPoller mmap";
+	}
+
+	char* sq = static_cast<char*>(sq_ring_);
+	char* cq = static_cast<char*>(cq_ring_);
+	sq_head_ = reinterpret_cast<unsigned*>(sq + p.sq_off.head);
+	sq_tail_ = reinterpret_cast<unsigned*>(sq + p.sq_off.tail);
+	sq_mask_ = *reinterpret_cast<unsigned*>(sq + p.sq_off.ring_mask);
+	sq_array_ = reinterpret_cast<unsigned*>(sq + p.sq_off.array);
+	cq_head_ = reinterpret_cast<unsigned*>(cq + p.cq_off.head);
+	cq_tail_ = reinterpret_cast<unsigned*>(cq + p.cq_off.tail);
+	cq_mask_ = *reinterpret_cast<unsigned*>(cq + p.cq_off.ring_mask);
+	cqes_ = reinterpret_cast<struct io_uring_cqe*>(cq + p.cq_off.cqes);
+
+	sq_local_tail_ = *sq_tail_;
+	// 提交项下标固定映射，之后只需推进尾部
+	for (unsigned i = 0; i <= sq_mask_; i++) {
+		sq_array_[i] = i;
+	}
+}
+
+IoUringPoller::~IoUringPoller() {
+	if (sqes_ != MAP_FAILED) {
+		::munmap(sqes_, sqes_size_);
+	}
+	if (sq_ring_ != MAP_FAILED) {
+		::munmap(sq_ring_, sq_ring_size_);
+	}
+	// 关闭后内核会取消所有挂载的poll
+	::close(ringfd_);
+}
+
+Timestamp IoUringPoller::poll(int timeoutms, EventChanneList* activer_channels) {
+	LOG_TRACE << "fd total count " << channels_.size();
+	FlushChanges();
+
+	// 完成队列已有数据时不阻塞
+	unsigned ready = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE) - *cq_head_;
+	unsigned min_complete = (ready > 0 || timeoutms == 0) ? 0 : 1;
+	int ret = enter(min_complete, timeoutms, true);
+	int errno_back = errno;
+	Timestamp now(Timestamp::now());
+
+	if (ret < 0 && errno_back != ETIME && errno_back != EINTR && errno_back != EBUSY) {
+		errno = errno_back;
+		LOG_SYSERR << "IoUringPoller::poll()";
+	}
+
+	size_t before = activer_channels->size();
+	FillActiveChannels(activer_channels);
+	if (activer_channels->size() > before) {
+		LOG_TRACE << activer_channels->size() - before << " events happened";
+	} else {
+		LOG_TRACE << "nothing happened";
+	}
+
+	return now;
+}
+
+// 通道更新
+void IoUringPoller::UpdateChannel(EventChannel* channel) {
+	EventPoller::AssertInLoopThread();
+	int fd = channel->fd();
+	LOG_TRACE << "fd = " << fd << " events = " << channel->events();
+
+	if (static_cast<size_t>(fd) >= slots_.size()) {
+		slots_.resize(fd + 1);
+	}
+	if (slots_[fd].channel != channel) {
+		channels_.insert(fd, channel);
+	}
+	slots_[fd].channel = channel;
+	channel->set_index(1);
+	MarkDirty(fd);
+}
+
+// 通道移除
+void IoUringPoller::RemoveChannel(EventChannel* channel) {
+	EventPoller::AssertInLoopThread();
+	int fd = channel->fd();
+	LOG_TRACE << "fd = " << fd;
+	size_t n = channels_.erase(fd);
+	(void)n;
+
+	assert(static_cast<size_t>(fd) < slots_.size());
+	Slot& slot = slots_[fd];
+	if (slot.channel == channel) {
+		slot.channel = nullptr;
+		// fd即将被关闭复用，挂载的poll必须立即取消，旧完成项由generation丢弃
+		disarm(slot);
+	}
+	channel->set_index(-1);
+}
+
+void IoUringPoller::MarkDirty(int fd) {
+	Slot& slot = slots_[fd];
+	if (!slot.dirty) {
+		slot.dirty = true;
+		dirty_.push_back(fd);
+	}
+}
+
+void IoUringPoller::FlushChanges(void) {
+	for (int fd : dirty_) {
+		Slot& slot = slots_[fd];
+		slot.dirty = false;
+
+		uint32_t wanted = slot.channel ? static_cast<uint32_t>(slot.channel->events()) : 0;
+		bool multishot = slot.channel && slot.channel->IsEdgeTriggered();
+		if (slot.armed_data != 0) {
+			if (wanted == slot.armed_events && multishot == slot.multishot) {
+				// 同一轮内开关抵消，无需提交
+				continue;
+			}
+			disarm(slot);
+		}
+		if (wanted != 0) {
+			arm(fd, slot);
+		}
+	}
+	dirty_.clear();
+}
+
+void IoUringPoller::arm(int fd, Slot& slot) {
+	if (++slot.generation == 0) {
+		slot.generation = 1;
+	}
+	slot.armed_data = make_data(fd, slot.generation);
+	slot.armed_events = static_cast<uint32_t>(slot.channel->events());
+	slot.multishot = slot.channel->IsEdgeTriggered();
+
+	struct io_uring_sqe* sqe = GetSqe();
+	sqe->opcode = IORING_OP_POLL_ADD;
+	sqe->fd = fd;
+	sqe->poll32_events = slot.armed_events;
+	sqe->len = slot.multishot ? IORING_POLL_ADD_MULTI : 0;
+	sqe->user_data = slot.armed_data;
+}
+
+void IoUringPoller::disarm(Slot& slot) {
+	if (slot.armed_data == 0) {
+		return;
+	}
+	struct io_uring_sqe* sqe = GetSqe();
+	sqe->opcode = IORING_OP_POLL_REMOVE;
+	sqe->fd = -1;
+	sqe->addr = slot.armed_data;
+	sqe->user_data = kInternalData;
+	slot.armed_data = 0;
+	slot.armed_events = 0;
+}
+
+void IoUringPoller::FillActiveChannels(EventChanneList* active_channels) {
+	round_++;
+	unsigned head = *cq_head_;
+	unsigned tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+
+	for (; head != tail; head++) {
+		const struct io_uring_cqe* cqe = &cqes_[head & cq_mask_];
+		uint64_t data = cqe->user_data;
+		int res = cqe->res;
+		bool more = cqe->flags & IORING_CQE_F_MORE;
+
+		if (data & kInternalData) {
+			// 取消时poll已经触发属于正常情况
+			if (res < 0 && res != -ENOENT && res != -EALREADY) {
+				LOG_ERROR << "io_uring poll remove " << strerror(-res);
+			}
+			continue;
+		}
+
+		int fd = static_cast<int>(data & 0xffffffff);
+		if (static_cast<size_t>(fd) >= slots_.size()) {
+			continue;
+		}
+		Slot& slot = slots_[fd];
+		if (slot.armed_data != data || nullptr == slot.channel) {
+			// 已被取消或重新挂载的旧完成项
+			continue;
+		}
+
+		if (!more) {
+			// 单次poll已触发，或multishot被内核终止，下一轮重新挂载
+			slot.armed_data = 0;
+			slot.armed_events = 0;
+			MarkDirty(fd);
+		}
+
+		uint32_t revents;
+		if (res >= 0) {
+			revents = static_cast<uint32_t>(res);
+		} else if (res == -ECANCELED) {
+			continue;
+		} else {
+			LOG_ERROR << "io_uring poll fd = " << fd << " " << strerror(-res);
+			revents = (res == -EBADF) ? POLLNVAL : POLLERR;
+		}
+
+		if (slot.active_round == round_) {
+			// multishot同一轮多次上报，合并事件
+			slot.revents |= revents;
+			slot.channel->set_revents(static_cast<int>(slot.revents));
+		} else {
+			slot.active_round = round_;
+			slot.revents = revents;
+			slot.channel->set_revents(static_cast<int>(revents));
+			active_channels->push_back(slot.channel);
+		}
+	}
+
+	__atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+}
+
+struct io_uring_sqe* IoUringPoller::GetSqe(void) {
+	unsigned head = __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+	if (sq_local_tail_ - head > sq_mask_) {
+		// 提交队列已满，先提交一批
+		enter(0, 0, false);
+		head = __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+		if (sq_local_tail_ - head > sq_mask_) {
+			LOG_FATAL << "io_uring submission queue stalled";
+		}
+	}
+
+	struct io_uring_sqe* sqe = &sqes_[sq_local_tail_ & sq_mask_];
+	memset(sqe, 0, sizeof(*sqe));
+	sq_local_tail_++;
+	to_submit_++;
+	__atomic_store_n(sq_tail_, sq_local_tail_, __ATOMIC_RELEASE);
+	return sqe;
+}
+
+int IoUringPoller::enter(unsigned min_complete, int timeoutms, bool getevents) {
+	struct __kernel_timespec ts;
+	struct io_uring_getevents_arg arg;
+	memset(&arg, 0, sizeof(arg));
+	if (min_complete > 0 && timeoutms >= 0) {
+		ts.tv_sec = timeoutms / 1000;
+		ts.tv_nsec = (timeoutms % 1000) * 1000000LL;
+		arg.ts = reinterpret_cast<uint64_t>(&ts);
+	}
+
+	unsigned flags = IORING_ENTER_EXT_ARG;
+	if (getevents) {
+		flags |= IORING_ENTER_GETEVENTS;
+	}
+
+	int ret = io_uring_enter(ringfd_, to_submit_, min_complete, flags, &arg, sizeof(arg));
+	int errno_back = errno;
+	// 以内核消费位置为准，部分提交时剩余项留待下次
+	to_submit_ = sq_local_tail_ - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+	errno = errno_back;
+	return ret;
+}
+
+#else
+
+bool IoUringPoller::IsSupported(void) {
+	return false;
+}
+
+IoUringPoller::IoUringPoller(EventLoop* loop) : EventPoller(loop) {
+	LOG_FATAL << "io_uring is not supported on this platform";
+}
+
+IoUringPoller::~IoUringPoller() = default;
+
+Timestamp IoUringPoller::poll(int timeoutms, EventChanneList* activer_channels) {
+	return Timestamp::now();
+}
+
+void IoUringPoller::UpdateChannel(EventChannel* channel) {}
+
+void IoUringPoller::RemoveChannel(EventChannel* channel) {}
+
+#endif
+
+} // namespace net
+
+} // namespace brsdk
@@ -0,0 +1,127 @@
+/**
+ * MIT License
+ * 
+ * Copyright © 2021 <Jerry.Yu>.
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the “Software”), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * 
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ * 
+ * @file poller_uring.hpp
+ * @brief io_uring轮询器
+ * @author Jerry.Yu (jerry.yu512@outlook.com)
+ * @version 1.0.0
+ * @date 2026-10-17
+ * 
+ * @copyright MIT License
+ * 
+ */
+#pragma once
+#include "poller.hpp"
+#include <stdint.h>
+#include <vector>
+
+// io_uring需要内核头文件支持，缺失时该轮询器不可用
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#define BRSDK_HAVE_IO_URING 1
+#endif
+#endif
+
+struct io_uring_sqe;
+struct io_uring_cqe;
+
+namespace brsdk {
+
+namespace net {
+
+/**
+ * @brief io_uring轮询器
+ * @details
+ * - 通道的关心事件变化只记录为脏，在下一次poll时统一生成提交项，
+ *   一次io_uring_enter完成提交与等待，同一轮中反复开关写事件不会产生系统调用
+ * - 普通通道使用单次poll，触发后在下一轮批量重新挂载，保持水平触发语义
+ * - 边沿触发通道使用multishot poll，挂载一次持续上报
+ * - 内核不支持时(<5.13或被禁用)，@c NewDefaultPoller 回退到epoll
+ */
+class IoUringPoller : public EventPoller {
+public:
+	IoUringPoller(EventLoop* loop);
+	~IoUringPoller() override;
+
+	Timestamp poll(int timeoutms, EventChanneList* activer_channels) override;
+	// 通道更新
+	virtual void UpdateChannel(EventChannel* channel) override;
+	// 通道移除
+	virtual void RemoveChannel(EventChannel* channel) override;
+	bool SupportsEdgeTriggered(void) const override { return true; }
+
+	// 当前内核是否支持，结果只探测一次
+	static bool IsSupported(void);
+
+private:
+	static const unsigned kRingEntries = 256;
+
+	// fd对应的挂载状态
+	struct Slot {
+		EventChannel* channel = nullptr;	///< 当前通道
+		uint64_t armed_data = 0;			///< 已挂载poll的user_data，0表示未挂载
+		uint32_t armed_events = 0;			///< 已挂载的事件
+		uint32_t generation = 0;			///< 每次挂载递增，用于丢弃过期完成项
+		uint32_t revents = 0;				///< 本轮累计的活动事件
+		uint64_t active_round = 0;			///< 最近一次加入活动列表的轮次
+		bool multishot = false;				///< 已挂载的poll是否为multishot
+		bool dirty = false;					///< 是否在待同步列表中
+	};
+
+	// 标记通道需要在下一次poll时同步
+	void MarkDirty(int fd);
+	// 把脏通道同步为提交项
+	void FlushChanges(void);
+	void arm(int fd, Slot& slot);
+	void disarm(Slot& slot);
+	// 处理完成队列
+	void FillActiveChannels(EventChanneList* active_channels);
+
+	struct io_uring_sqe* GetSqe(void);
+	// 提交待提交项，getevents时同时收割/等待完成项
+	int enter(unsigned min_complete, int timeoutms, bool getevents);
+
+	int ringfd_;					///< io_uring句柄
+	void* sq_ring_;					///< 提交队列映射
+	void* cq_ring_;					///< 完成队列映射
+	size_t sq_ring_size_;
+	size_t cq_ring_size_;
+	struct io_uring_sqe* sqes_;		///< 提交项数组
+	size_t sqes_size_;
+
+	unsigned* sq_head_;
+	unsigned* sq_tail_;
+	unsigned sq_mask_;
+	unsigned* sq_array_;
+	unsigned* cq_head_;
+	unsigned* cq_tail_;
+	unsigned cq_mask_;
+	struct io_uring_cqe* cqes_;
+
+	unsigned sq_local_tail_;		///< 尚未提交的本地尾部
+	unsigned to_submit_;			///< 待提交数量
+
+	uint64_t round_;				///< 轮询轮次
+	std::vector<Slot> slots_;		///< fd索引的挂载状态
+	std::vector<int> dirty_;		///< 待同步的fd
+};
+
+} // namespace net
+
+} // namespace brsdk
@@ -39,20 +39,58 @@ namespace net {
 
 namespace {
 
-using ConnectorPtr = std::shared_ptr<Connector>;
-
 void _RemoveConnection(EventLoop* loop, const TcpConnectionPtr& conn)
 {
 	LOG_TRACE << "To remove connection.";
 	loop->QueueInLoop(std::bind(&TcpConnection::ConnectDestroyed, conn));
 }
 
-void _RemoveConnector(const ConnectorPtr& connector)
+void _RemoveConnector(const TcpConnectorPtr& connector)
 {
 	LOG_TRACE << "To remove connector.";
-    // connector->
 }
 
+// 所有者析构之后才建立的连接直接关闭
+void _CloseSocket(int sockfd)
+{
+	sock_close(sockfd);
+}
+
+}
+
+TcpConnectionPtr NewClientConnection(EventLoop* loop, const std::string& name, int sockfd, int* next_conn_id) {
+	loop->AssertInLoopThread();
+	sock_addr_t addr;
+	sock_get_peer_name(sockfd, addr);
+	Address peer_addr(addr);
+	char buf[64] = "";
+	snprintf(buf, sizeof(buf), ":%s#%d", peer_addr.ipport().c_str(), *next_conn_id);
+	(*next_conn_id)++;
+	std::string conn_name = name + buf;
+
+	memset(&addr, 0, sizeof(addr));
+	sock_get_name(sockfd, addr);
+	Address local_addr(addr);
+
+	return TcpConnectionPtr(new TcpConnection(loop, conn_name, sockfd, local_addr, peer_addr));
+}
+
+void AbandonConnector(EventLoop* loop, const TcpConnectorPtr& connector) {
+	connector->SetNewConnectionCallback(&_CloseSocket);
+	connector->SetConnectionFailedCallback(ConnectorFailedConnCallback());
+	connector->stop();
+	loop->RunAfter(1, std::bind(&_RemoveConnector, connector));
+}
+
+void AbandonConnection(EventLoop* loop, const TcpConnectionPtr& conn) {
+	conn->SetConnectionCallback(TcpConnection::DefaultConnectionCallback);
+	conn->SetMessageCallback(TcpConnection::DefaultMessageCallback);
+	conn->SetCloseCallback(std::bind(&_RemoveConnection, loop, _1));
+	conn->ForceClose();
+}
+
+void ReleaseConnectorLater(EventLoop* loop, const TcpConnectorPtr& connector) {
+	loop->QueueInLoop(std::bind(&_RemoveConnector, connector));
 }
 
 TcpClient::TcpClient(EventLoop* loop, const Address& serverAddr, const Address& localAddr, const std::string& nameArgs)
@@ -91,8 +129,7 @@ TcpClient::~TcpClient() {
 			conn->ForceClose();
 		}
 	} else {
-		connector_->stop();
-		loop_->RunAfter(1, std::bind(&_RemoveConnector, connector_));
+		AbandonConnector(loop_, connector_);
 	}
 }
 
@@ -123,28 +160,14 @@ void TcpClient::stop(void) {
 
 // 新连接，在loop中执行
 void TcpClient::NewConnection(int sockfd) {
-	loop_->AssertInLoopThread();
-	sock_addr_t addr;
-	sock_get_peer_name(sockfd, addr);
-	Address peer_addr(addr);
-	char buf[64] = "";
-	snprintf(buf, sizeof(buf), ":%s#%d", peer_addr.ipport().c_str(), nextConnId_);
-	nextConnId_++;
-	std::string conn_name = name_ + buf;
-
-	memset(&addr, 0, sizeof(addr));
-	sock_get_name(sockfd, addr);
-	Address local_addr(addr);
-
-	TcpConnectionPtr conn(new TcpConnection(loop_,
-											conn_name,
-											sockfd,
-											local_addr,
-											peer_addr));
+	TcpConnectionPtr conn = NewClientConnection(loop_, name_, sockfd, &nextConnId_);
 	conn->SetConnectionCallback(connectionCallback_);
 	conn->SetMessageCallback(messageCallback_);
 	conn->SetWriteCompleteCallback(writeCompleteCallback_);
 	conn->SetCloseCallback(std::bind(&TcpClient::RemoveConnection, this, _1));
+	if (tls_) {
+		conn->StartTls(tls_, server_name_);
+	}
 
 	{
 		MutexLockGuard lock(mutex_);
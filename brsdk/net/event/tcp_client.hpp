@@ -77,6 +77,7 @@ public:
 		connectionCallback_ = cb;
 	}
 
+	// 设置连接失败回调，每次连接失败都回调，异步失败后连接器继续重连
 	void SetConnectionFailedCallback(TcpConnectionFailedCallback cb) {
 		connectionFailedCallback_ = cb;
 	}
@@ -91,6 +92,18 @@ public:
 		writeCompleteCallback_ = cb;
 	}
 
+	/**
+	 * @brief 连接使用TLS，需在connect之前调用
+	 * @details 同一配置的客户端按服务器缓存会话，重连时恢复会话
+	 *
+	 * @param ctx 客户端TLS配置，nullptr关闭
+	 * @param server_name 服务器名，用于SNI与证书主机名校验，可为空
+	 */
+	void EnableTls(const std::shared_ptr<TlsContext>& ctx, const std::string& server_name = std::string()) {
+		tls_ = ctx;
+		server_name_ = server_name;
+	}
+
 private:
 	// 新连接，在loop中执行
 	void NewConnection(int sockfd);
@@ -105,6 +118,8 @@ private:
 	TcpConnectionFailedCallback connectionFailedCallback_;
 	TcpMessageCallbak messageCallback_;
 	TcpWriteCompleteCallbak writeCompleteCallback_;
+	std::shared_ptr<TlsContext> tls_;	///< TLS配置，为空不加密
+	std::string server_name_;		///< TLS服务器名
 	std::atomic_bool retry_;		///< 重连使能
 	std::atomic_bool connect_;		///< 是否已经连接
 	// 在事件循环线程里执行
@@ -113,6 +128,34 @@ private:
 	TcpConnectionPtr connection_ GUARDED_BY(mutex_);	// 连接句柄
 };
 
+/**
+ * @brief 用连接器建立的套接字创建客户端连接，在loop中执行
+ * @details 连接名为"name:对端地址#序号"，回调由调用者设置后再调用ConnectEstablished
+ *
+ * @param loop 事件循环
+ * @param name 客户端名称
+ * @param sockfd 连接器建立的套接字
+ * @param next_conn_id 连接序号，使用后加一
+ * @return TcpConnectionPtr 新连接
+ */
+TcpConnectionPtr NewClientConnection(EventLoop* loop, const std::string& name, int sockfd, int* next_conn_id);
+
+/**
+ * @brief 所有者析构时放弃连接器
+ * @details 停止连接与重连，之后建立的套接字直接关闭，不再回调所有者；连接器延后释放，
+ *          保证其回调与排队的任务执行完毕
+ */
+void AbandonConnector(EventLoop* loop, const TcpConnectorPtr& connector);
+
+/**
+ * @brief 所有者析构时放弃已建立的连接
+ * @details 回调恢复为默认并强制关闭，关闭后连接自行销毁
+ */
+void AbandonConnection(EventLoop* loop, const TcpConnectionPtr& conn);
+
+// 连接器从所有者移除后延后释放，保证其回调与排队的任务执行完毕
+void ReleaseConnectorLater(EventLoop* loop, const TcpConnectorPtr& connector);
+
 } // namespace net
 
 } // namespace brsdk
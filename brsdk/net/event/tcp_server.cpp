@@ -38,27 +38,53 @@
 namespace brsdk {
 
 namespace net {
+
+namespace {
+
+// 在IO loop内向一组连接发送同一数据块
+void SendToAll(const std::vector<TcpConnectionPtr>& conns, const OutputChain::Block& message) {
+	for (const TcpConnectionPtr& conn : conns) {
+		conn->send(message);
+	}
+}
+
+} // namespace
 	
 TcpServer::TcpServer(EventLoop* loop, const Address& listenAddr, const std::string& nameArg, Option option)
 	: loop_(loop), 
 	  ipport_(listenAddr.ipport()),
 	  name_(nameArg),
-	  acceptor_(new Acceptor(loop, listenAddr, option == kReusePort)),
+	  listen_addr_(listenAddr),
+	  option_(option),
+	  acceptor_(option == kReusePortPerLoop ? nullptr : new Acceptor(loop, listenAddr, option == kReusePort)),
 	  threadPool_(new EventLoopThreadPool(loop, name_)),
 	  connectionCallback_(TcpConnection::DefaultConnectionCallback),
 	  messageCallback_(TcpConnection::DefaultMessageCallback),
 	  writeCompleteCallback_(nullptr),
 	  threadInitCallback_(nullptr),
 	  started_(false),
-	  nextConnId_(1) {
+	  nextConnId_(1),
+	  edge_triggered_(false),
+	  read_budget_(TcpConnection::kDefaultReadBudget),
+	  backpressure_high_(0),
+	  backpressure_low_(0) {
 	// 新客户端接入时调用
-	acceptor_->SetNewConnectionCallback(std::bind(&TcpServer::NewConnection, this, _1, _2));
+	if (acceptor_) {
+		acceptor_->SetNewConnectionCallback(std::bind(&TcpServer::NewConnection, this, _1, _2));
+	}
 }
 
 TcpServer::~TcpServer() {
 	loop_->AssertInLoopThread();
 	LOG_TRACE << "TcpServer::~TcpServer [" << name_ << "] destructing";
 
+	// 接受器与连接表属于各自loop，在所属线程内销毁后才能释放
+	for (auto& slot : loop_acceptors_) {
+		CountDownLatch latch(1);
+		slot->loop->RunInLoop(std::bind(&TcpServer::DestroyLoopAcceptor, this, get_pointer(slot), &latch));
+		latch.wait();
+	}
+
 	for (auto& item : connections_) {
 		TcpConnectionPtr conn(item.second);
 		item.second.reset();
@@ -70,20 +96,38 @@ void TcpServer::SetThreadNum(int thread_num) {
 	threadPool_->set_threadnum(thread_num);
 }
 
+void TcpServer::SetTimerWheelTick(int tick_ms) {
+	threadPool_->set_timer_wheel_tick(tick_ms);
+}
+
+void TcpServer::SetLoadBalance(EventLoopThreadPool::LoadBalance policy) {
+	threadPool_->set_load_balance(policy);
+}
+
 void TcpServer::start(void) {
-	if (started_ == 0) {
+	if (started_.exchange(1) == 0) {
 		threadPool_->start(threadInitCallback_);
-		loop_->RunInLoop(std::bind(&Acceptor::listen, get_pointer(acceptor_)));
+		if (option_ != kReusePortPerLoop) {
+			loop_->RunInLoop(std::bind(&Acceptor::listen, get_pointer(acceptor_)));
+			return;
+		}
+
+		for (EventLoop* io_loop : threadPool_->GetAllLoops()) {
+			std::unique_ptr<LoopAcceptor> slot(new LoopAcceptor);
+			slot->loop = io_loop;
+			slot->acceptor.reset(new Acceptor(io_loop, listen_addr_, true));
+			slot->acceptor->SetNewConnectionCallback(
+				std::bind(&TcpServer::NewLocalConnection, this, get_pointer(slot), _1, _2));
+			io_loop->RunInLoop(std::bind(&Acceptor::listen, get_pointer(slot->acceptor)));
+			loop_acceptors_.push_back(std::move(slot));
+		}
 	}
 }
 
-void TcpServer::NewConnection(int sockfd, const Address& peerAddr) {
-	loop_->AssertInLoopThread();
-	EventLoop* io_loop = threadPool_->GetNextLoop();
+TcpConnectionPtr TcpServer::CreateConnection(EventLoop* io_loop, int sockfd, const Address& peerAddr) {
 	char buf[64] = "";
 
-	snprintf(buf, sizeof(buf), "-%s#%d", ipport_.c_str(), nextConnId_);
-	nextConnId_++;
+	snprintf(buf, sizeof(buf), "-%s#%d", ipport_.c_str(), nextConnId_.fetch_add(1));
 	std::string conn_name = name_ + buf;
 
 	LOG_INFO << "TcpServer::NewConnection [" << name_
@@ -98,14 +142,100 @@ void TcpServer::NewConnection(int sockfd, const Address& peerAddr) {
 											sockfd,
 											local_addr,
 											peerAddr));
-	connections_[conn_name] = conn;
 	conn->SetConnectionCallback(connectionCallback_);
 	conn->SetMessageCallback(messageCallback_);
 	conn->SetWriteCompleteCallback(writeCompleteCallback_);
+	if (edge_triggered_) {
+		conn->SetEdgeTriggered(true, read_budget_);
+	}
+	if (backpressure_high_ > 0) {
+		conn->SetBackpressure(backpressure_high_, backpressure_low_);
+	}
+	if (tls_) {
+		conn->StartTls(tls_);
+	}
+	return conn;
+}
+
+void TcpServer::NewConnection(int sockfd, const Address& peerAddr) {
+	loop_->AssertInLoopThread();
+	EventLoop* io_loop = threadPool_->GetLoopForPeer(peerAddr);
+	TcpConnectionPtr conn = CreateConnection(io_loop, sockfd, peerAddr);
+	connections_[conn->name()] = conn;
+	threadPool_->IncreaseLoad(io_loop);
 	conn->SetCloseCallback(std::bind(&TcpServer::RemoveConnection, this, _1));
 	io_loop->RunInLoop(std::bind(&TcpConnection::ConnectEstablished, conn));
 }
 
+void TcpServer::NewLocalConnection(LoopAcceptor* slot, int sockfd, const Address& peerAddr) {
+	slot->loop->AssertInLoopThread();
+	TcpConnectionPtr conn = CreateConnection(slot->loop, sockfd, peerAddr);
+	slot->connections[conn->name()] = conn;
+	conn->SetCloseCallback(std::bind(&TcpServer::RemoveLocalConnection, this, slot, _1));
+	conn->ConnectEstablished();
+}
+
+void TcpServer::RemoveLocalConnection(LoopAcceptor* slot, const TcpConnectionPtr& conn) {
+	slot->loop->AssertInLoopThread();
+	LOG_INFO << "TcpServer::RemoveLocalConnection [" << name_
+			 << "] - connection " << conn->name();
+	size_t n = slot->connections.erase(conn->name());
+	(void)n;
+	slot->loop->QueueInLoop(std::bind(&TcpConnection::ConnectDestroyed, conn));
+}
+
+void TcpServer::DestroyLoopAcceptor(LoopAcceptor* slot, CountDownLatch* latch) {
+	slot->loop->AssertInLoopThread();
+	slot->acceptor.reset();
+	for (auto& item : slot->connections) {
+		TcpConnectionPtr conn(item.second);
+		item.second.reset();
+		conn->ConnectDestroyed();
+	}
+	slot->connections.clear();
+	latch->countDown();
+}
+
+void TcpServer::broadcast(std::string message) {
+	broadcast(std::make_shared<const std::string>(std::move(message)));
+}
+
+void TcpServer::broadcast(const OutputChain::Block& message) {
+	if (!message || message->empty()) {
+		return;
+	}
+
+	if (option_ != kReusePortPerLoop) {
+		// 连接表属于主loop
+		loop_->RunInLoop(std::bind(&TcpServer::BroadcastInLoop, this, message));
+		return;
+	}
+
+	// 接受器在start之后不再变化，连接表由各自loop访问
+	for (auto& slot : loop_acceptors_) {
+		slot->loop->RunInLoop(std::bind(&TcpServer::BroadcastLocal, this, get_pointer(slot), message));
+	}
+}
+
+void TcpServer::BroadcastInLoop(const OutputChain::Block& message) {
+	loop_->AssertInLoopThread();
+	std::map<EventLoop*, std::vector<TcpConnectionPtr>> groups;
+	for (auto& item : connections_) {
+		groups[item.second->GetLoop()].push_back(item.second);
+	}
+
+	for (auto& group : groups) {
+		group.first->RunInLoop(std::bind(&SendToAll, std::move(group.second), message));
+	}
+}
+
+void TcpServer::BroadcastLocal(LoopAcceptor* slot, const OutputChain::Block& message) {
+	slot->loop->AssertInLoopThread();
+	for (auto& item : slot->connections) {
+		item.second->send(message);
+	}
+}
+
 void TcpServer::RemoveConnection(const TcpConnectionPtr& conn) {
 	loop_->RunInLoop(std::bind(&TcpServer::RemoveConnectionInLoop, this, conn));
 }
@@ -115,8 +245,10 @@ void TcpServer::RemoveConnectionInLoop(const TcpConnectionPtr& conn) {
 	LOG_INFO << "TcpServer::RemoveConnectionInLoop [" << name_
 			 << "] - connection " << conn->name();
 	size_t n = connections_.erase(conn->name());
-	(void)n;
 	EventLoop* io_loop = conn->GetLoop();
+	if (n > 0) {
+		threadPool_->DecreaseLoad(io_loop);
+	}
 	io_loop->QueueInLoop(std::bind(&TcpConnection::ConnectDestroyed, conn));
 }
 
@@ -31,9 +31,11 @@
 #include <atomic>
 #include "brsdk/mix/noncopyable.hpp"
 #include "brsdk/lock/mutex.hpp"
+#include "brsdk/lock/countdownlatch.hpp"
 #include "brsdk/net/socket/address.hpp"
 #include "brsdk/net/buffer.hpp"
 #include "connection.hpp"
+#include "event_loop_thread_pool.hpp"
 #include "event_typedef.hpp"
 
 namespace brsdk {
@@ -49,6 +51,9 @@ public:
 	enum Option {
 		kNoReusePort,
 		kReusePort,
+		// 每个IO loop各自以SO_REUSEPORT监听，由内核分发连接，
+		// 连接在接受它的loop内建立和销毁，不经过主loop
+		kReusePortPerLoop,
 	};
 
 	TcpServer(EventLoop* loop, const Address& listenAddr, const std::string& nameArg, Option option = kNoReusePort);
@@ -69,6 +74,55 @@ public:
 	 * - N 表明I/O在线程池内
 	 */
 	void SetThreadNum(int thread_num);
+	/**
+	 * @brief 线程池内loop使用时间轮定时器
+	 * @warning 必须在 @c start 之前调用，主loop由用户创建时自行指定
+	 * 
+	 * @param tick_ms 时间轮刻度(毫秒)，0不使用
+	 */
+	void SetTimerWheelTick(int tick_ms);
+	/**
+	 * @brief 新连接选择IO loop的策略，默认轮询
+	 * @details 长连接负载悬殊时使用kLeastLatency/kLeastConnections避免重负载连接堆积在少数loop上，
+	 *          kReusePortPerLoop模式下连接由内核分发，不使用该策略
+	 * @warning 必须在 @c start 之前调用
+	 *
+	 * @param policy 选择策略
+	 */
+	void SetLoadBalance(EventLoopThreadPool::LoadBalance policy);
+	/**
+	 * @brief 新连接使用边沿触发，写事件常驻，读事件按预算读空
+	 * @details 稳定负载下几乎不再有epoll_ctl调用，轮询器不支持时保持水平触发
+	 * @warning 只影响之后建立的连接
+	 * 
+	 * @param on 是否使能
+	 * @param read_budget 每个连接单轮最多读取的字节数
+	 */
+	void SetEdgeTriggered(bool on, size_t read_budget = TcpConnection::kDefaultReadBudget) {
+		edge_triggered_ = on;
+		read_budget_ = read_budget;
+	}
+	/**
+	 * @brief 新连接的发送队列流控，积压超过高水位暂停读取，低于低水位恢复
+	 * @warning 只影响之后建立的连接
+	 *
+	 * @param high 高水位，0关闭
+	 * @param low 低水位
+	 */
+	void SetBackpressure(size_t high, size_t low) {
+		backpressure_high_ = high;
+		backpressure_low_ = low;
+	}
+	/**
+	 * @brief 新连接使用TLS，握手完成后才回调连接建立
+	 * @details 所有IO loop共享同一个配置，会话缓存与票据密钥对任意loop接入的连接都有效
+	 * @warning 只影响之后建立的连接
+	 *
+	 * @param ctx 服务端TLS配置，nullptr关闭
+	 */
+	void EnableTls(const std::shared_ptr<TlsContext>& ctx) {
+		tls_ = ctx;
+	}
 	void SetThreadInitCallback(const ThreadInitCallback& cb) {
 		threadInitCallback_ = cb;
 	}
@@ -91,24 +145,60 @@ public:
 		writeCompleteCallback_ = cb;
 	}
 
+	/**
+	 * @brief 向全部连接广播消息，任意线程可调用
+	 * @details 消息只保存一份，各连接的发送队列共享引用；
+	 *          每个IO loop只投递一次任务，由该loop向自己的连接逐个发送，
+	 *          调用之后建立的连接不会收到
+	 *
+	 * @param message 不可变的共享数据块
+	 */
+	void broadcast(const OutputChain::Block& message);
+	// 向全部连接广播消息，消息被接管，不再拷贝
+	void broadcast(std::string message);
+
 private:
+	using ConnectionMap = std::map<std::string, TcpConnectionPtr>;
+
+	// IO loop独立的接受器与连接表，只在所属loop线程访问
+	struct LoopAcceptor {
+		EventLoop* loop;					///< 所属loop
+		std::unique_ptr<Acceptor> acceptor;	///< 接受器
+		ConnectionMap connections;			///< 连接表
+	};
+
 	void NewConnection(int sockfd, const Address& peerAddr);
 	void RemoveConnection(const TcpConnectionPtr& conn);
 	void RemoveConnectionInLoop(const TcpConnectionPtr& conn);
-
-	using ConnectionMap = std::map<std::string, TcpConnectionPtr>;
+	// kReusePortPerLoop模式下在IO loop内建立/移除连接
+	void NewLocalConnection(LoopAcceptor* slot, int sockfd, const Address& peerAddr);
+	void RemoveLocalConnection(LoopAcceptor* slot, const TcpConnectionPtr& conn);
+	void DestroyLoopAcceptor(LoopAcceptor* slot, CountDownLatch* latch);
+	// 按IO loop分组连接，每个loop投递一次发送任务
+	void BroadcastInLoop(const OutputChain::Block& message);
+	void BroadcastLocal(LoopAcceptor* slot, const OutputChain::Block& message);
+	// 创建连接并设置回调
+	TcpConnectionPtr CreateConnection(EventLoop* io_loop, int sockfd, const Address& peerAddr);
 
 	EventLoop* loop_;			///< 事件循环
 	const std::string ipport_;	///< 地址端口
 	const std::string name_;	///< 连接名称
+	const Address listen_addr_;	///< 监听地址
+	const Option option_;		///< 监听选项
 	std::unique_ptr<Acceptor> acceptor_;				///< 接受器
+	std::vector<std::unique_ptr<LoopAcceptor>> loop_acceptors_;	///< 各IO loop的接受器
 	std::shared_ptr<EventLoopThreadPool> threadPool_;	///< 线程池
 	TcpConnectionCallback connectionCallback_;			///< 连接回调
 	TcpMessageCallbak messageCallback_;
 	TcpWriteCompleteCallbak writeCompleteCallback_;
 	ThreadInitCallback threadInitCallback_;
 	std::atomic_int32_t started_;						///< 是否已经开始
-	int nextConnId_;									///< 连接计数
+	std::atomic_int nextConnId_;						///< 连接计数
+	bool edge_triggered_;								///< 连接使用边沿触发
+	size_t read_budget_;								///< 边沿触发单轮读取预算
+	size_t backpressure_high_;							///< 连接流控高水位
+	size_t backpressure_low_;							///< 连接流控低水位
+	std::shared_ptr<TlsContext> tls_;					///< 连接的TLS配置，为空不加密
 	ConnectionMap connections_;							///< 连接池
 };
 
@@ -38,19 +38,20 @@ TcpSocket::~TcpSocket() {
 }
 
 int TcpSocket::listen(void) {
-	return sock_listen(sockfd_);
+	// 默认backlog过小，连接速率高时SYN被丢弃，客户端要等待重传
+	return sock_listen(sockfd_, SOMAXCONN);
 }
 
 int TcpSocket::accept(Address& peeraddr) {
 	sock_addr_t addr;
-	int ret = sock_accept(sockfd_, addr);
+	int ret = sock_accept(sockfd_, addr, SOCK_NONBLOCK | SOCK_CLOEXEC);
 	peeraddr.set_sockaddr(addr);
 	return ret;
 }
 
 // 关闭写端
 void TcpSocket::ShutdownWrite(void) {
-	sock_shutdown(sockfd_);
+	sock_shutdown(sockfd_, 'w');
 }
 
 // 立即关闭
@@ -44,6 +44,7 @@ public:
 public:
 	// tcp监听
 	int listen(void);
+	// 接受连接，新套接字为非阻塞且exec时关闭
 	int accept(Address& peeraddr);
 	// 关闭写端
 	void ShutdownWrite(void);
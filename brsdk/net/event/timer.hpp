@@ -28,9 +28,6 @@
  */
 #pragma once
 #include <atomic>
-#include <map>
-#include <set>
-#include <vector>
 #include "brsdk/time/timestamp.hpp"
 #include "brsdk/mix/noncopyable.hpp"
 #include "event_typedef.hpp"
@@ -43,13 +40,14 @@ namespace net {
 class Timer : noncopyable {
 public:
 	Timer(TimerCallback cb, Timestamp when, double interval)
-		: callback_(cb),
+		: callback_(std::move(cb)),
 		  expiration_(when),
 		  interval_(interval),
 		  repeat_(interval > 0.0),
 		  sequence_(++s_num_created_) {}
 	
-	friend class TimerQueue;
+	friend class TreeTimerQueue;
+	friend class WheelTimerQueue;
 
 	void run(void) const {
 		callback_();
@@ -91,7 +89,8 @@ public:
 	TimerId() : timer_(nullptr), sequence_(0) {}
 	TimerId(Timer* timer, int64_t seq) : timer_(timer), sequence_(seq) {}
 
-	friend class TimerQueue;
+	friend class TreeTimerQueue;
+	friend class WheelTimerQueue;
 private:
 	Timer* timer_;	///< 定时器
 	int64_t sequence_;	///< 序号
@@ -99,39 +98,33 @@ private:
 
 /**
  * @brief 定时器队列
- * 
+ * @details 所有定时器在loop线程内触发，AddTimer/cancel可以在任意线程调用
+ * - @c TreeTimerQueue 有序集合实现，定时精度高，适合定时器数量少的场景
+ * - @c WheelTimerQueue 分层时间轮实现，O(1)添加/取消，适合大量超时定时器的场景
  */
 class TimerQueue : noncopyable {
 public:
-	explicit TimerQueue(EventLoop* loop);
-	~TimerQueue();
+	explicit TimerQueue(EventLoop* loop) : loop_(loop) {}
+	virtual ~TimerQueue();
 
 	// 添加定时器
-	TimerId AddTimer(TimerCallback cb, Timestamp when, double interval = 0.0);
+	virtual TimerId AddTimer(TimerCallback cb, Timestamp when, double interval = 0.0) = 0;
 	// 取消定时器
-	void cancel(TimerId timer_id);
-
-	using TimeEntry = std::pair<Timestamp, Timer*>;
-	using TimerList = std::set<TimeEntry>;
-	using ActiveTimer = std::pair<Timer*, int64_t>;
-	using ActiveTimerSet = std::set<ActiveTimer>;
-private:
-
-	void AddTimerInLoop(Timer* timer);
-	void CancelInLoop(TimerId timer_id);
-	void HandleRead(void);
-	std::vector<TimeEntry> GetExpired(Timestamp now);
-	void reset(const std::vector<TimeEntry>& expired, Timestamp now);
-	bool insert(Timer* timer);
-
+	virtual void cancel(TimerId timer_id) = 0;
+
+	/**
+	 * @brief 创建定时器队列
+	 * 
+	 * @param loop 所属loop
+	 * @param wheel_tick_ms 时间轮刻度(毫秒)
+	 * - 0 使用有序集合实现
+	 * - >0 使用分层时间轮实现，定时精度为一个刻度
+	 * @return TimerQueue* 
+	 */
+	static TimerQueue* NewTimerQueue(EventLoop* loop, int wheel_tick_ms);
+
+protected:
 	EventLoop* loop_;
-	const int timerfd_;				///< 时间描述符
-	EventChannel timerfd_channel_;	///< 时间描述符通道
-	TimerList timers_;				///< 定时器列表
-
-	ActiveTimerSet activeTimers_;	///< 活动定时器
-	bool calling_expired_timers_;	///< 正在调用超时定时器
-	ActiveTimerSet canceling_timers_;	///< 取消的定时器
 };
 
 } // namespace net
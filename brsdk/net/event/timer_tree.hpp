@@ -0,0 +1,77 @@
+/**
+ * MIT License
+ * 
+ * Copyright © 2021 <Jerry.Yu>.
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the “Software”), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * 
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ * 
+ * @file timer_tree.hpp
+ * @brief 有序集合定时器队列
+ * @author Jerry.Yu (jerry.yu512@outlook.com)
+ * @version 1.0.0
+ * @date 2026-10-17
+ * 
+ * @copyright MIT License
+ * 
+ */
+#pragma once
+#include <set>
+#include <vector>
+#include "timer.hpp"
+#include "event_channel.hpp"
+
+namespace brsdk {
+
+namespace net {
+
+/**
+ * @brief 有序集合实现的定时器队列
+ * @details 定时器按到期时间排序，timerfd总是设置为最早到期时间
+ */
+class TreeTimerQueue : public TimerQueue {
+public:
+	explicit TreeTimerQueue(EventLoop* loop);
+	~TreeTimerQueue() override;
+
+	// 添加定时器
+	TimerId AddTimer(TimerCallback cb, Timestamp when, double interval = 0.0) override;
+	// 取消定时器
+	void cancel(TimerId timer_id) override;
+
+	using TimeEntry = std::pair<Timestamp, Timer*>;
+	using TimerList = std::set<TimeEntry>;
+	using ActiveTimer = std::pair<Timer*, int64_t>;
+	using ActiveTimerSet = std::set<ActiveTimer>;
+private:
+
+	void AddTimerInLoop(Timer* timer);
+	void CancelInLoop(TimerId timer_id);
+	void HandleRead(void);
+	std::vector<TimeEntry> GetExpired(Timestamp now);
+	void reset(const std::vector<TimeEntry>& expired, Timestamp now);
+	bool insert(Timer* timer);
+
+	const int timerfd_;				///< 时间描述符
+	EventChannel timerfd_channel_;	///< 时间描述符通道
+	TimerList timers_;				///< 定时器列表
+
+	ActiveTimerSet activeTimers_;	///< 活动定时器
+	bool calling_expired_timers_;	///< 正在调用超时定时器
+	ActiveTimerSet canceling_timers_;	///< 取消的定时器
+};
+
+} // namespace net
+
+} // namespace brsdk
@@ -0,0 +1,366 @@
+/**
+ * MIT License
+ * 
+ * Copyright © 2021 <Jerry.Yu>.
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the “Software”), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * 
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ * 
+ * @file timer_wheel.cpp
+ * @brief 分层时间轮定时器队列
+ * @author Jerry.Yu (jerry.yu512@outlook.com)
+ * @version 1.0.0
+ * @date 2026-10-17
+ * 
+ * @copyright MIT License
+ * 
+ */
+#include "event_log.hpp"
+#include "event_loop.hpp"
+#include "timer_wheel.hpp"
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+namespace brsdk {
+
+namespace net {
+
+namespace {
+
+int create_timerfd(void) {
+	int timerfd = ::timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+	if (timerfd < 0) {
+		LOG_SYSFATAL << "Failed in timerfd_create";
+	}
+
+	return timerfd;
+}
+
+} // namespace
+
+WheelTimerQueue::WheelTimerQueue(EventLoop* loop, int tick_ms)
+	: TimerQueue(loop),
+	  tick_us_(static_cast<int64_t>(tick_ms) * 1000),
+	  timerfd_(create_timerfd()),
+	  timerfd_channel_(loop, timerfd_),
+	  current_tick_(TickOf(Timestamp::now())),
+	  count_(0),
+	  armed_(false),
+	  running_(nullptr),
+	  free_list_(nullptr),
+	  shared_free_list_(nullptr) {
+	assert(tick_ms > 0);
+	for (Link& head : root_) {
+		ListInit(&head);
+	}
+	for (auto& level : levels_) {
+		for (Link& head : level) {
+			ListInit(&head);
+		}
+	}
+	ListInit(&expired_);
+
+	timerfd_channel_.SetReadCallback(std::bind(&WheelTimerQueue::HandleRead, this));
+	timerfd_channel_.SetEdgeTriggered(true);
+	timerfd_channel_.EnableReading();
+}
+
+WheelTimerQueue::~WheelTimerQueue() {
+	timerfd_channel_.DisableAll();
+	timerfd_channel_.remove();
+	::close(timerfd_);
+
+	// 析构还在时间轮中的定时器，节点内存由chunks_和shared_chunks_释放
+	auto destroy = [](Link* head) {
+		for (Link* l = head->next; l != head; l = l->next) {
+			NodeOfLink(l)->timer()->~Timer();
+		}
+	};
+	for (Link& head : root_) {
+		destroy(&head);
+	}
+	for (auto& level : levels_) {
+		for (Link& head : level) {
+			destroy(&head);
+		}
+	}
+	destroy(&expired_);
+}
+
+// 添加定时器
+TimerId WheelTimerQueue::AddTimer(TimerCallback cb, Timestamp when, double interval) {
+	bool in_loop = loop_->IsInLoopThread();
+	// 节点池只在loop线程内使用，其他线程从加锁的共享池取
+	Node* node = AllocNode(!in_loop);
+
+	Timer* timer = new (&node->storage) Timer(std::move(cb), when, interval);
+	node->link.prev = node->link.next = nullptr;
+	node->canceled = false;
+
+	if (in_loop) {
+		AddTimerInLoop(node);
+	} else {
+		loop_->RunInLoop(std::bind(&WheelTimerQueue::AddTimerInLoop, this, node));
+	}
+
+	return TimerId(timer, timer->sequence_);
+}
+
+// 取消定时器
+void WheelTimerQueue::cancel(TimerId timer_id) {
+	loop_->RunInLoop(std::bind(&WheelTimerQueue::CancelInLoop, this, timer_id));
+}
+
+void WheelTimerQueue::ListSplice(Link* src, Link* dst) {
+	if (ListEmpty(src)) {
+		return;
+	}
+
+	Link* first = src->next;
+	Link* last = src->prev;
+
+	first->prev = dst->prev;
+	dst->prev->next = first;
+	last->next = dst;
+	dst->prev = last;
+	ListInit(src);
+}
+
+WheelTimerQueue::Node* WheelTimerQueue::NewChunk(bool shared, std::vector<std::unique_ptr<Node[]>>* chunks) {
+	std::unique_ptr<Node[]> chunk(new Node[kChunkNodes]);
+	Node* head = nullptr;
+	for (int i = 0; i < kChunkNodes; i++) {
+		chunk[i].shared = shared;
+		chunk[i].sequence = 0;
+		chunk[i].free_next = head;
+		head = &chunk[i];
+	}
+	chunks->push_back(std::move(chunk));
+	return head;
+}
+
+WheelTimerQueue::Node* WheelTimerQueue::AllocNode(bool shared) {
+	Node* node;
+	if (shared) {
+		MutexLockGuard lock(shared_mutex_);
+		if (!shared_free_list_) {
+			shared_free_list_ = NewChunk(true, &shared_chunks_);
+		}
+		node = shared_free_list_;
+		shared_free_list_ = node->free_next;
+		return node;
+	}
+
+	if (!free_list_) {
+		free_list_ = NewChunk(false, &chunks_);
+	}
+	node = free_list_;
+	free_list_ = node->free_next;
+	return node;
+}
+
+void WheelTimerQueue::FreeNode(Node* node) {
+	node->timer()->~Timer();
+	// 序号清零后，过期的TimerId不会再匹配该节点
+	node->sequence = 0;
+	if (node->shared) {
+		MutexLockGuard lock(shared_mutex_);
+		node->free_next = shared_free_list_;
+		shared_free_list_ = node;
+		return;
+	}
+	node->free_next = free_list_;
+	free_list_ = node;
+}
+
+void WheelTimerQueue::AddTimerInLoop(Node* node) {
+	loop_->AssertInLoopThread();
+	// 序号在loop线程内设置，共享池节点在其他线程复用时不会与过期TimerId的取消检查竞争
+	node->sequence = node->timer()->sequence_;
+
+	// 时间轮为空时直接跳到当前刻度，避免空闲很久后逐个刻度推进
+	if (0 == count_) {
+		uint64_t now_tick = Timestamp::now().microSecondsSinceEpoch() / tick_us_;
+		if (now_tick > current_tick_) {
+			current_tick_ = now_tick;
+		}
+	}
+
+	node->expire = TickOf(node->timer()->expiration_);
+	insert(node);
+	count_++;
+	arm(true);
+}
+
+void WheelTimerQueue::CancelInLoop(TimerId timer_id) {
+	loop_->AssertInLoopThread();
+	if (!timer_id.timer_) {
+		return;
+	}
+
+	// 节点内存在队列析构前不会释放，可以安全访问
+	Node* node = NodeOf(timer_id.timer_);
+	if (node->sequence != timer_id.sequence_) {
+		return;
+	}
+
+	if (node == running_) {
+		// 回调中取消自己，执行完后不再重新加入
+		node->canceled = true;
+	} else if (node->link.next) {
+		ListDel(&node->link);
+		count_--;
+		FreeNode(node);
+	}
+}
+
+void WheelTimerQueue::HandleRead(void) {
+	loop_->AssertInLoopThread();
+	uint64_t howmany;
+	ssize_t n = ::read(timerfd_, &howmany, sizeof(howmany));
+	if (n != sizeof(howmany)) {
+		LOG_ERROR << "TimerRead reads " << n << " bytes instead of 8";
+	}
+
+	advance(Timestamp::now().microSecondsSinceEpoch() / tick_us_);
+
+	if (0 == count_) {
+		arm(false);
+	}
+}
+
+uint64_t WheelTimerQueue::TickOf(Timestamp when) const {
+	int64_t us = when.microSecondsSinceEpoch();
+	if (us <= 0) {
+		return 0;
+	}
+
+	return static_cast<uint64_t>((us + tick_us_ - 1) / tick_us_);
+}
+
+void WheelTimerQueue::insert(Node* node) {
+	uint64_t expire = node->expire;
+	int64_t idx = static_cast<int64_t>(expire - current_tick_);
+	Link* slot = nullptr;
+
+	if (idx < 0) {
+		// 已经过期，放到下一个处理的槽
+		slot = &root_[current_tick_ & kRootMask];
+	} else if (idx < kRootSize) {
+		slot = &root_[expire & kRootMask];
+	} else if (idx < (1LL << (kRootBits + kLevelBits))) {
+		slot = &levels_[0][(expire >> kRootBits) & kLevelMask];
+	} else if (idx < (1LL << (kRootBits + 2 * kLevelBits))) {
+		slot = &levels_[1][(expire >> (kRootBits + kLevelBits)) & kLevelMask];
+	} else if (idx < (1LL << (kRootBits + 3 * kLevelBits))) {
+		slot = &levels_[2][(expire >> (kRootBits + 2 * kLevelBits)) & kLevelMask];
+	} else {
+		// 超出范围的按最大值放入，到期时再按真实时间重新放入
+		if (idx > 0xffffffffLL) {
+			expire = current_tick_ + 0xffffffffULL;
+			node->expire = expire;
+		}
+		slot = &levels_[3][(expire >> (kRootBits + 3 * kLevelBits)) & kLevelMask];
+	}
+
+	ListAdd(slot, &node->link);
+}
+
+int WheelTimerQueue::cascade(int level, int index) {
+	Link list;
+	ListInit(&list);
+	ListSplice(&levels_[level][index], &list);
+
+	while (!ListEmpty(&list)) {
+		Node* node = NodeOfLink(list.next);
+		ListDel(&node->link);
+		insert(node);
+	}
+
+	return index;
+}
+
+void WheelTimerQueue::advance(uint64_t target) {
+	while (current_tick_ <= target) {
+		int index = static_cast<int>(current_tick_ & kRootMask);
+
+		// 第一层转完一圈，从上层取下一批定时器
+		if (!index) {
+			for (int level = 0; level < kLevels; level++) {
+				int shift = kRootBits + level * kLevelBits;
+				if (cascade(level, static_cast<int>((current_tick_ >> shift) & kLevelMask))) {
+					break;
+				}
+			}
+		}
+
+		current_tick_++;
+		ListSplice(&root_[index], &expired_);
+
+		while (!ListEmpty(&expired_)) {
+			Node* node = NodeOfLink(expired_.next);
+			ListDel(&node->link);
+
+			// 超出时间轮范围的定时器还未真正到期
+			uint64_t due = TickOf(node->timer()->expiration_);
+			if (due > node->expire) {
+				node->expire = due;
+				insert(node);
+				continue;
+			}
+
+			count_--;
+			if (EventLoopMetrics* metrics = loop_->metrics()) {
+				metrics->RecordTimer(Timestamp::now().microSecondsSinceEpoch()
+									 - node->timer()->expiration_.microSecondsSinceEpoch());
+			}
+			running_ = node;
+			node->timer()->run();
+			running_ = nullptr;
+
+			if (node->timer()->repeat() && !node->canceled) {
+				node->timer()->restart(Timestamp::now());
+				node->expire = TickOf(node->timer()->expiration_);
+				insert(node);
+				count_++;
+			} else {
+				FreeNode(node);
+			}
+		}
+	}
+}
+
+void WheelTimerQueue::arm(bool on) {
+	if (armed_ == on) {
+		return;
+	}
+
+	struct itimerspec value;
+	memset(&value, 0, sizeof(value));
+	if (on) {
+		value.it_value.tv_sec = static_cast<time_t>(tick_us_ / Timestamp::kMicroSecondsPerSecond);
+		value.it_value.tv_nsec = static_cast<long>((tick_us_ % Timestamp::kMicroSecondsPerSecond) * 1000);
+		value.it_interval = value.it_value;
+	}
+
+	if (::timerfd_settime(timerfd_, 0, &value, nullptr)) {
+		LOG_SYSERR << "timerfd_settime()";
+		return;
+	}
+	armed_ = on;
+}
+
+} // namespace net
+
+} // namespace brsdk
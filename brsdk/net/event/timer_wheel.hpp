@@ -0,0 +1,171 @@
+/**
+ * MIT License
+ * 
+ * Copyright © 2021 <Jerry.Yu>.
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the “Software”), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * 
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ * 
+ * @file timer_wheel.hpp
+ * @brief 分层时间轮定时器队列
+ * @author Jerry.Yu (jerry.yu512@outlook.com)
+ * @version 1.0.0
+ * @date 2026-10-17
+ * 
+ * @copyright MIT License
+ * 
+ */
+#pragma once
+#include <stddef.h>
+#include <memory>
+#include <type_traits>
+#include <vector>
+#include "timer.hpp"
+#include "event_channel.hpp"
+#include "brsdk/lock/mutex.hpp"
+
+namespace brsdk {
+
+namespace net {
+
+/**
+ * @brief 分层时间轮定时器队列
+ * @details
+ * - 5层时间轮(256/64/64/64/64槽)，覆盖2^32个刻度，超出部分按最大值放入最高层
+ * - 添加/取消为O(1)，定时器节点来自池，loop线程内添加不分配内存；
+ *   其他线程添加的节点来自加锁的共享池，释放后回到共享池复用
+ * - 只有一个周期性timerfd，有定时器时按刻度触发，无定时器时停止
+ * - 定时精度为一个刻度，定时器不会提前触发
+ */
+class WheelTimerQueue : public TimerQueue {
+public:
+	WheelTimerQueue(EventLoop* loop, int tick_ms);
+	~WheelTimerQueue() override;
+
+	// 添加定时器
+	TimerId AddTimer(TimerCallback cb, Timestamp when, double interval = 0.0) override;
+	// 取消定时器
+	void cancel(TimerId timer_id) override;
+
+	// 刻度
+	int tick_ms(void) const { return static_cast<int>(tick_us_ / 1000); }
+	// 当前定时器数量
+	size_t size(void) const { return count_; }
+
+private:
+	// 第一层槽数
+	static const int kRootBits = 8;
+	static const int kRootSize = 1 << kRootBits;
+	static const int kRootMask = kRootSize - 1;
+	// 其余层槽数
+	static const int kLevelBits = 6;
+	static const int kLevelSize = 1 << kLevelBits;
+	static const int kLevelMask = kLevelSize - 1;
+	static const int kLevels = 4;
+	// 每次池扩充的节点数
+	static const int kChunkNodes = 256;
+
+	// 双向循环链表，时间轮槽使用
+	struct Link {
+		Link* prev;
+		Link* next;
+	};
+
+	// 定时器节点
+	struct Node {
+		Link link;				///< 必须为第一个成员
+		uint64_t expire;		///< 到期刻度
+		int64_t sequence;		///< 定时器序号，0表示空闲
+		bool canceled;			///< 回调执行中被取消
+		bool shared;			///< 来自loop线程外使用的共享池
+		Node* free_next;		///< 空闲链表
+		typename std::aligned_storage<sizeof(Timer), alignof(Timer)>::type storage;
+
+		Timer* timer(void) {
+			return reinterpret_cast<Timer*>(&storage);
+		}
+	};
+
+	static void ListInit(Link* head) {
+		head->prev = head;
+		head->next = head;
+	}
+	static bool ListEmpty(const Link* head) {
+		return head->next == head;
+	}
+	static void ListAdd(Link* head, Link* link) {
+		link->prev = head->prev;
+		link->next = head;
+		head->prev->next = link;
+		head->prev = link;
+	}
+	static void ListDel(Link* link) {
+		link->prev->next = link->next;
+		link->next->prev = link->prev;
+		link->prev = link->next = nullptr;
+	}
+	// 整个链表移动到dst尾部
+	static void ListSplice(Link* src, Link* dst);
+
+	static Node* NodeOfLink(Link* link) {
+		return reinterpret_cast<Node*>(link);
+	}
+
+	static Node* NodeOf(Timer* timer) {
+		return reinterpret_cast<Node*>(reinterpret_cast<char*>(timer) - offsetof(Node, storage));
+	}
+
+	// 从节点池取节点，shared为true时从共享池取，任意线程可调用
+	Node* AllocNode(bool shared);
+	void FreeNode(Node* node);
+	// 新分配一块节点串成空闲链表
+	Node* NewChunk(bool shared, std::vector<std::unique_ptr<Node[]>>* chunks);
+	void AddTimerInLoop(Node* node);
+	void CancelInLoop(TimerId timer_id);
+	void HandleRead(void);
+
+	// 时间转换为刻度，向上取整
+	uint64_t TickOf(Timestamp when) const;
+	// 放入时间轮
+	void insert(Node* node);
+	// 将某层某槽的定时器重新放入时间轮
+	int cascade(int level, int index);
+	// 推进到刻度target
+	void advance(uint64_t target);
+	// 启停周期timerfd
+	void arm(bool on);
+
+	const int64_t tick_us_;			///< 刻度，微秒
+	const int timerfd_;				///< 时间描述符
+	EventChannel timerfd_channel_;	///< 时间描述符通道
+	uint64_t current_tick_;			///< 下一个待处理的刻度
+	size_t count_;					///< 时间轮中的定时器数
+	bool armed_;					///< timerfd是否启动
+
+	Link root_[kRootSize];				///< 第一层
+	Link levels_[kLevels][kLevelSize];	///< 其余层
+	Link expired_;						///< 当前刻度到期待执行的定时器
+	Node* running_;						///< 正在执行的定时器
+
+	Node* free_list_;								///< 空闲节点，loop线程内使用
+	std::vector<std::unique_ptr<Node[]>> chunks_;	///< 节点池内存
+
+	MutexLock shared_mutex_;
+	Node* shared_free_list_ GUARDED_BY(shared_mutex_);		///< 共享池空闲节点
+	std::vector<std::unique_ptr<Node[]>> shared_chunks_ GUARDED_BY(shared_mutex_);	///< 共享池内存
+};
+
+} // namespace net
+
+} // namespace brsdk
@@ -0,0 +1,463 @@
+/**
+ * MIT License
+ *
+ * Copyright © 2021 <Jerry.Yu>.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the “Software”), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * @file tls.cpp
+ * @brief 事件循环连接的非阻塞TLS
+ * @author Jerry.Yu (jerry.yu512@outlook.com)
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright MIT License
+ *
+ */
+#include "tls.hpp"
+#include <limits.h>
+#include <string.h>
+#include <algorithm>
+#include "event_log.hpp"
+
+#ifdef WITH_OPENSSL
+#include <openssl/bio.h>
+#include <openssl/err.h>
+#include <openssl/ssl.h>
+#include <openssl/x509v3.h>
+#endif
+
+namespace brsdk {
+
+namespace net {
+
+const size_t TlsStream::kMaxRecordSize;
+
+TlsContext::Options::Options()
+	: verify_peer(false),
+	  session_cache_size(20480),
+	  session_timeout(300),
+	  session_tickets(true) {
+}
+
+namespace {
+
+ssl_ctx_t init_ctx(const TlsContext::Options& options, bool server) {
+	if (server && (options.crt_file.empty() || options.key_file.empty())) {
+		LOG_ERROR << "TlsContext - server requires crt_file and key_file";
+		return nullptr;
+	}
+	ssl_ctx_init_param_t param;
+	memset(&param, 0, sizeof(param));
+	param.crt_file = options.crt_file.c_str();
+	param.key_file = options.key_file.c_str();
+	param.ca_file = options.ca_file.c_str();
+	param.verify_peer = options.verify_peer ? 1 : 0;
+	param.endpoint = server ? 0 : 1;
+	ssl_ctx_t ctx = ssl_ctx_init(&param);
+	if (nullptr == ctx) {
+		LOG_ERROR << "TlsContext - ssl_ctx_init failed, backend " << ssl_backend();
+	}
+	return ctx;
+}
+
+} // namespace
+
+std::shared_ptr<TlsContext> TlsContext::NewServer(const Options& options) {
+	ssl_ctx_t ctx = init_ctx(options, true);
+	return ctx ? std::shared_ptr<TlsContext>(new TlsContext(ctx, true, options)) : nullptr;
+}
+
+std::shared_ptr<TlsContext> TlsContext::NewClient(const Options& options) {
+	ssl_ctx_t ctx = init_ctx(options, false);
+	return ctx ? std::shared_ptr<TlsContext>(new TlsContext(ctx, false, options)) : nullptr;
+}
+
+TlsContext::~TlsContext() {
+	ssl_ctx_cleanup(ctx_);
+}
+
+void TlsContext::SaveSession(const std::string& key, const std::string& der) {
+	MutexLockGuard lock(mutex_);
+	// 已存在的键不会被insert覆盖
+	sessions_.erase(key);
+	sessions_.insert(key, der);
+}
+
+bool TlsContext::LoadSession(const std::string& key, std::string* der) {
+	MutexLockGuard lock(mutex_);
+	auto it = sessions_.find(key);
+	if (it == sessions_.end()) {
+		return false;
+	}
+	*der = it->second;
+	return true;
+}
+
+void TlsContext::HandshakeDone(bool resumed) {
+	handshakes_.fetch_add(1, std::memory_order_relaxed);
+	if (resumed) {
+		resumed_.fetch_add(1, std::memory_order_relaxed);
+	}
+}
+
+#ifdef WITH_OPENSSL
+
+/**
+ * @brief 自定义BIO与会话回调
+ * @details BIO读取直接消费连接收到的密文，写入直接追加到连接的发送队列，
+ *          比内存BIO少一次拷贝，也不需要再把BIO中的密文搬到发送队列
+ */
+struct TlsCallbacks {
+	static BIO_METHOD* method(void) {
+		static BIO_METHOD* s_method = create_method();
+		return s_method;
+	}
+
+	static BIO_METHOD* create_method(void) {
+		BIO_METHOD* m = BIO_meth_new(BIO_get_new_index() | BIO_TYPE_SOURCE_SINK, "brsdk tls");
+		BIO_meth_set_write(m, &TlsCallbacks::write);
+		BIO_meth_set_read(m, &TlsCallbacks::read);
+		BIO_meth_set_ctrl(m, &TlsCallbacks::ctrl);
+		BIO_meth_set_create(m, &TlsCallbacks::create);
+		return m;
+	}
+
+	static int create(BIO* bio) {
+		BIO_set_init(bio, 1);
+		return 1;
+	}
+
+	static int write(BIO* bio, const char* data, int len) {
+		TlsStream* stream = static_cast<TlsStream*>(BIO_get_data(bio));
+		BIO_clear_retry_flags(bio);
+		stream->output_->append(data, static_cast<size_t>(len));
+		return len;
+	}
+
+	static int read(BIO* bio, char* data, int len) {
+		TlsStream* stream = static_cast<TlsStream*>(BIO_get_data(bio));
+		BIO_clear_retry_flags(bio);
+		NetBuffer* input = &stream->input_;
+		size_t n = std::min(input->readable_bytes(), static_cast<size_t>(len));
+		if (0 == n) {
+			BIO_set_retry_read(bio);
+			return -1;
+		}
+		::memcpy(data, input->peek(), n);
+		input->retrieve(n);
+		return static_cast<int>(n);
+	}
+
+	static long ctrl(BIO* bio, int cmd, long num, void* ptr) {
+		// 写入即完成，没有需要刷新的数据
+		return BIO_CTRL_FLUSH == cmd ? 1 : 0;
+	}
+
+	// 客户端收到新会话(TLS1.3在握手之后收到票据)
+	static int new_session(SSL* ssl, SSL_SESSION* session) {
+		TlsStream* stream = static_cast<TlsStream*>(SSL_get_app_data(ssl));
+		int len = i2d_SSL_SESSION(session, nullptr);
+		if (nullptr == stream || len <= 0) {
+			return 0;
+		}
+		std::string der(static_cast<size_t>(len), '\0');
+		unsigned char* p = reinterpret_cast<unsigned char*>(&der[0]);
+		i2d_SSL_SESSION(session, &p);
+		stream->ctx_->SaveSession(stream->session_key_, der);
+		// 未持有session的引用
+		return 0;
+	}
+};
+
+TlsContext::TlsContext(ssl_ctx_t ctx, bool server, const Options& options)
+	: ctx_(ctx),
+	  server_(server),
+	  options_(options),
+	  handshakes_(0),
+	  resumed_(0),
+	  sessions_(options.session_cache_size) {
+	SSL_CTX* ssl_ctx = static_cast<SSL_CTX*>(ctx_);
+	// 空闲连接释放读写缓冲区，大量长连接时节省内存
+	SSL_CTX_set_mode(ssl_ctx, SSL_MODE_RELEASE_BUFFERS);
+	SSL_CTX_set_min_proto_version(ssl_ctx, TLS1_2_VERSION);
+	SSL_CTX_set_timeout(ssl_ctx, options.session_timeout);
+	if (server_) {
+		static const unsigned char kSessionIdContext[] = "brsdk";
+		SSL_CTX_set_session_id_context(ssl_ctx, kSessionIdContext, sizeof(kSessionIdContext) - 1);
+		if (options.session_cache_size > 0) {
+			SSL_CTX_set_session_cache_mode(ssl_ctx, SSL_SESS_CACHE_SERVER);
+			SSL_CTX_sess_set_cache_size(ssl_ctx, static_cast<long>(options.session_cache_size));
+		} else {
+			SSL_CTX_set_session_cache_mode(ssl_ctx, SSL_SESS_CACHE_OFF);
+		}
+		if (!options.session_tickets) {
+			SSL_CTX_set_options(ssl_ctx, SSL_OP_NO_TICKET);
+		}
+	} else if (options.session_cache_size > 0) {
+		// 会话由new_session保存到按服务器区分的缓存，不使用OpenSSL的内部缓存
+		SSL_CTX_set_session_cache_mode(ssl_ctx, SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+		SSL_CTX_sess_set_new_cb(ssl_ctx, &TlsCallbacks::new_session);
+	} else {
+		SSL_CTX_set_session_cache_mode(ssl_ctx, SSL_SESS_CACHE_OFF);
+	}
+}
+
+bool TlsContext::SetTicketKeys(const std::string& keys) {
+	if (!server_ || keys.size() != TicketKeysLength()) {
+		LOG_ERROR << "TlsContext::SetTicketKeys - need " << TicketKeysLength() << " bytes";
+		return false;
+	}
+	std::string copy(keys);
+	return SSL_CTX_set_tlsext_ticket_keys(static_cast<SSL_CTX*>(ctx_), &copy[0], static_cast<long>(copy.size())) == 1;
+}
+
+size_t TlsContext::TicketKeysLength(void) const {
+	return static_cast<size_t>(SSL_CTX_get_tlsext_ticket_keys(static_cast<SSL_CTX*>(ctx_), nullptr, 0));
+}
+
+TlsStream::TlsStream(const std::shared_ptr<TlsContext>& ctx, OutputChain* output,
+					 const std::string& peer, const std::string& server_name)
+	: ctx_(ctx),
+	  ssl_(SSL_new(static_cast<SSL_CTX*>(ctx->native()))),
+	  output_(output),
+	  established_(false),
+	  resumed_(false),
+	  closed_(false) {
+	SSL* ssl = static_cast<SSL*>(ssl_);
+	if (nullptr == ssl) {
+		return;
+	}
+	BIO* bio = BIO_new(TlsCallbacks::method());
+	BIO_set_data(bio, this);
+	// 读写使用同一个BIO，只转移一个引用
+	SSL_set_bio(ssl, bio, bio);
+	SSL_set_app_data(ssl, this);
+	if (ctx->server()) {
+		SSL_set_accept_state(ssl);
+		return;
+	}
+
+	SSL_set_connect_state(ssl);
+	if (!server_name.empty()) {
+		SSL_set_tlsext_host_name(ssl, server_name.c_str());
+		if (ctx->options_.verify_peer) {
+			SSL_set1_host(ssl, server_name.c_str());
+		}
+	}
+	session_key_ = peer + "/" + server_name;
+	std::string der;
+	if (ctx->options_.session_cache_size > 0 && ctx->LoadSession(session_key_, &der)) {
+		const unsigned char* p = reinterpret_cast<const unsigned char*>(der.data());
+		SSL_SESSION* session = d2i_SSL_SESSION(nullptr, &p, static_cast<long>(der.size()));
+		if (session) {
+			SSL_set_session(ssl, session);
+			SSL_SESSION_free(session);
+		}
+	}
+}
+
+TlsStream::~TlsStream() {
+	if (ssl_) {
+		// 未发送close_notify的会话会被OpenSSL移出服务端缓存，已发送的由SSL_shutdown标记；
+		// 对端已发送close_notify但本端回复前断开的也是正常结束，保留会话供恢复
+		SSL* ssl = static_cast<SSL*>(ssl_);
+		int mode = SSL_get_shutdown(ssl);
+		if ((mode & SSL_RECEIVED_SHUTDOWN) && !(mode & SSL_SENT_SHUTDOWN)) {
+			SSL_set_shutdown(ssl, mode | SSL_SENT_SHUTDOWN);
+		}
+		SSL_free(static_cast<SSL*>(ssl_));
+	}
+}
+
+TlsStream::Result TlsStream::handshake(void) {
+	if (established_) {
+		return kDone;
+	}
+	if (nullptr == ssl_) {
+		error_ = "SSL_new failed";
+		return kError;
+	}
+
+	SSL* ssl = static_cast<SSL*>(ssl_);
+	ERR_clear_error();
+	int ret = SSL_do_handshake(ssl);
+	if (ret != 1) {
+		return Fail(ret, "handshake");
+	}
+
+	established_ = true;
+	resumed_ = SSL_session_reused(ssl) == 1;
+	ctx_->HandshakeDone(resumed_);
+	if (!pending_.empty()) {
+		std::string pending;
+		pending.swap(pending_);
+		if (!encrypt(pending.data(), pending.size())) {
+			return kError;
+		}
+	}
+	return kDone;
+}
+
+const char* TlsStream::version(void) const {
+	return ssl_ ? SSL_get_version(static_cast<SSL*>(ssl_)) : "";
+}
+
+TlsStream::Result TlsStream::decrypt(NetBuffer* plain, size_t* n) {
+	*n = 0;
+	if (!established_) {
+		return kWant;
+	}
+
+	SSL* ssl = static_cast<SSL*>(ssl_);
+	ERR_clear_error();
+	// 读到没有完整记录为止
+	for (;;) {
+		plain->ensure_writable_bytes(kMaxRecordSize);
+		int len = static_cast<int>(std::min(plain->writable_bytes(), static_cast<size_t>(INT_MAX)));
+		int ret = SSL_read(ssl, plain->begin_write(), len);
+		if (ret <= 0) {
+			return Fail(ret, "read");
+		}
+		plain->has_written(static_cast<size_t>(ret));
+		*n += static_cast<size_t>(ret);
+	}
+}
+
+bool TlsStream::encrypt(const void* data, size_t len) {
+	if (nullptr == ssl_ || closed_) {
+		error_ = "closed";
+		return false;
+	}
+	if (!established_) {
+		pending_.append(static_cast<const char*>(data), len);
+		return true;
+	}
+
+	SSL* ssl = static_cast<SSL*>(ssl_);
+	const char* p = static_cast<const char*>(data);
+	ERR_clear_error();
+	while (len > 0) {
+		int ret = SSL_write(ssl, p, static_cast<int>(std::min(len, static_cast<size_t>(INT_MAX))));
+		if (ret <= 0) {
+			Fail(ret, "write");
+			return false;
+		}
+		p += ret;
+		len -= static_cast<size_t>(ret);
+	}
+	return true;
+}
+
+bool TlsStream::close(void) {
+	if (nullptr == ssl_ || !established_ || closed_) {
+		return false;
+	}
+	closed_ = true;
+	SSL_shutdown(static_cast<SSL*>(ssl_));
+	ERR_clear_error();
+	return true;
+}
+
+TlsStream::Result TlsStream::Fail(int ret, const char* what) {
+	SSL* ssl = static_cast<SSL*>(ssl_);
+	int err = SSL_get_error(ssl, ret);
+	if (SSL_ERROR_WANT_READ == err || SSL_ERROR_WANT_WRITE == err) {
+		return kWant;
+	}
+	if (SSL_ERROR_ZERO_RETURN == err) {
+		return kClosed;
+	}
+
+	error_ = what;
+	long verify = SSL_get_verify_result(ssl);
+	unsigned long code = ERR_get_error();
+	if (verify != X509_V_OK) {
+		error_ += ": ";
+		error_ += X509_verify_cert_error_string(verify);
+	} else if (code != 0) {
+		char buf[256];
+		ERR_error_string_n(code, buf, sizeof(buf));
+		error_ += ": ";
+		error_ += buf;
+	}
+	ERR_clear_error();
+	return kError;
+}
+
+#else
+
+TlsContext::TlsContext(ssl_ctx_t ctx, bool server, const Options& options)
+	: ctx_(ctx),
+	  server_(server),
+	  options_(options),
+	  handshakes_(0),
+	  resumed_(0),
+	  sessions_(options.session_cache_size) {
+}
+
+bool TlsContext::SetTicketKeys(const std::string& keys) {
+	return false;
+}
+
+size_t TlsContext::TicketKeysLength(void) const {
+	return 0;
+}
+
+// 其他后端不支持，ssl_ctx_init失败，不会创建连接的TLS状态
+TlsStream::TlsStream(const std::shared_ptr<TlsContext>& ctx, OutputChain* output,
+					 const std::string& peer, const std::string& server_name)
+	: ctx_(ctx),
+	  ssl_(nullptr),
+	  output_(output),
+	  established_(false),
+	  resumed_(false),
+	  closed_(false),
+	  error_("recompile WITH_OPENSSL") {
+}
+
+TlsStream::~TlsStream() {
+}
+
+TlsStream::Result TlsStream::handshake(void) {
+	return kError;
+}
+
+const char* TlsStream::version(void) const {
+	return "";
+}
+
+TlsStream::Result TlsStream::decrypt(NetBuffer* plain, size_t* n) {
+	*n = 0;
+	return kError;
+}
+
+bool TlsStream::encrypt(const void* data, size_t len) {
+	return false;
+}
+
+bool TlsStream::close(void) {
+	return false;
+}
+
+TlsStream::Result TlsStream::Fail(int ret, const char* what) {
+	return kError;
+}
+
+#endif
+
+} // namespace net
+
+} // namespace brsdk
@@ -0,0 +1,205 @@
+/**
+ * MIT License
+ *
+ * Copyright © 2021 <Jerry.Yu>.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the “Software”), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * @file tls.hpp
+ * @brief 事件循环连接的非阻塞TLS
+ * @author Jerry.Yu (jerry.yu512@outlook.com)
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright MIT License
+ *
+ */
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+#include <memory>
+#include <string>
+#include "brsdk/ds/lru_map.hpp"
+#include "brsdk/lock/mutex.hpp"
+#include "brsdk/mix/noncopyable.hpp"
+#include "brsdk/net/buffer.hpp"
+#include "brsdk/net/output_chain.hpp"
+#include "brsdk/net/ssl.hpp"
+
+namespace brsdk {
+
+namespace net {
+
+/**
+ * @brief TLS配置，可以被多个连接、多个loop共享，线程安全
+ * @details
+ * - 服务端会话缓存与会话票据密钥保存在同一个SSL_CTX中，所有IO loop共享，
+ *   客户端重连到任意loop都能恢复会话，省去完整握手
+ * - 多进程部署时通过 @c SetTicketKeys 设置相同的票据密钥，票据跨进程有效
+ * - 客户端按服务器名(未指定时为对端地址)缓存会话，下次连接同一服务器时尝试恢复
+ */
+class TlsContext : noncopyable {
+public:
+	struct Options {
+		Options();
+
+		std::string crt_file;		///< 证书文件(PEM)，服务端必须
+		std::string key_file;		///< 私钥文件(PEM)，服务端必须
+		std::string ca_file;		///< CA证书文件(PEM)，校验对端时使用
+		bool verify_peer;			///< 校验对端证书
+		size_t session_cache_size;	///< 会话缓存条数，0关闭会话缓存
+		long session_timeout;		///< 会话有效期(秒)
+		bool session_tickets;		///< 服务端签发会话票据，关闭时使用服务端会话缓存恢复
+	};
+
+	/**
+	 * @brief 创建服务端配置
+	 *
+	 * @param options 配置
+	 * @return std::shared_ptr<TlsContext> 失败返回nullptr
+	 */
+	static std::shared_ptr<TlsContext> NewServer(const Options& options);
+	// 创建客户端配置，失败返回nullptr
+	static std::shared_ptr<TlsContext> NewClient(const Options& options);
+
+	~TlsContext();
+
+	/**
+	 * @brief 设置会话票据密钥，多个进程使用相同的密钥时票据可以跨进程恢复
+	 * @details 长度必须为 @c TicketKeysLength() ，不调用时使用进程内随机生成的密钥
+	 *
+	 * @param keys 密钥
+	 * @return true 成功
+	 */
+	bool SetTicketKeys(const std::string& keys);
+	// 票据密钥长度
+	size_t TicketKeysLength(void) const;
+
+	bool server(void) const { return server_; }
+	ssl_ctx_t native(void) const { return ctx_; }
+
+	// 完成的握手次数
+	uint64_t handshakes(void) const { return handshakes_.load(std::memory_order_relaxed); }
+	// 其中恢复会话的次数
+	uint64_t resumed(void) const { return resumed_.load(std::memory_order_relaxed); }
+
+private:
+	friend class TlsStream;
+	friend struct TlsCallbacks;
+
+	TlsContext(ssl_ctx_t ctx, bool server, const Options& options);
+
+	// 客户端会话缓存，会话以DER编码保存
+	void SaveSession(const std::string& key, const std::string& der);
+	bool LoadSession(const std::string& key, std::string* der);
+	void HandshakeDone(bool resumed);
+
+	ssl_ctx_t ctx_;					///< SSL_CTX
+	const bool server_;				///< 服务端
+	const Options options_;			///< 配置
+	std::atomic<uint64_t> handshakes_;	///< 完成的握手次数
+	std::atomic<uint64_t> resumed_;		///< 恢复会话的次数
+	mutable MutexLock mutex_;
+	ds::LruMap<std::string, std::string> sessions_ GUARDED_BY(mutex_);	///< 客户端会话缓存
+};
+
+/**
+ * @brief 单个连接的TLS状态机，只在连接所属loop线程内使用
+ * @details 不直接读写套接字：收到的密文放入 @c cipher_input ，解密后的明文追加到接收缓冲区；
+ *          握手消息与加密后的记录直接追加到连接的发送队列，由连接按原有方式写出，
+ *          writev合并、边沿触发与流控都不受影响
+ */
+class TlsStream : noncopyable {
+public:
+	// 处理结果
+	enum Result {
+		kWant,		///< 等待更多数据
+		kDone,		///< 握手完成
+		kClosed,	///< 对端发送了close_notify
+		kError,		///< 协议错误或者证书校验失败
+	};
+
+	/**
+	 * @brief 构造
+	 *
+	 * @param ctx 配置
+	 * @param output 密文输出的发送队列，生命周期长于本对象
+	 * @param peer 对端地址，客户端未指定服务器名时作为会话缓存的键
+	 * @param server_name 客户端的服务器名，用于SNI与证书主机名校验
+	 */
+	TlsStream(const std::shared_ptr<TlsContext>& ctx, OutputChain* output,
+			  const std::string& peer, const std::string& server_name);
+	~TlsStream();
+
+	// 待解密的密文
+	NetBuffer* cipher_input(void) { return &input_; }
+
+	// 推进握手，握手消息写入发送队列
+	Result handshake(void);
+	bool established(void) const { return established_; }
+	// 本次握手是否恢复了会话
+	bool resumed(void) const { return resumed_; }
+	// 协商的协议版本，如"TLSv1.3"
+	const char* version(void) const;
+	// 最近一次错误的描述
+	const std::string& error(void) const { return error_; }
+
+	/**
+	 * @brief 解密全部已收到的完整记录
+	 *
+	 * @param plain 明文追加到的缓冲区
+	 * @param n 本次解密出的字节数
+	 * @return Result kWant/kClosed/kError
+	 */
+	Result decrypt(NetBuffer* plain, size_t* n);
+	/**
+	 * @brief 加密明文写入发送队列，握手完成前暂存，握手完成后依次加密
+	 *
+	 * @return false 连接已不可写
+	 */
+	bool encrypt(const void* data, size_t len);
+	/**
+	 * @brief 发送close_notify，只发送一次
+	 *
+	 * @return true 本次写入了close_notify
+	 */
+	bool close(void);
+
+private:
+	friend struct TlsCallbacks;
+
+	// 加密记录的最大明文长度
+	static const size_t kMaxRecordSize = 16 * 1024;
+
+	// 记录SSL错误，返回对应的结果
+	Result Fail(int ret, const char* what);
+
+	std::shared_ptr<TlsContext> ctx_;	///< 配置
+	ssl_t ssl_;						///< SSL
+	NetBuffer input_;				///< 待解密的密文
+	OutputChain* output_;			///< 密文输出
+	std::string session_key_;		///< 客户端会话缓存的键
+	std::string pending_;			///< 握手完成前写入的明文
+	bool established_;				///< 握手完成
+	bool resumed_;					///< 恢复了会话
+	bool closed_;					///< 已发送close_notify
+	std::string error_;				///< 错误描述
+};
+
+} // namespace net
+
+} // namespace brsdk
@@ -0,0 +1,93 @@
+/**
+ * MIT License
+ *
+ * Copyright © 2021 <Jerry.Yu>.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the “Software”), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * @file udp_client.cpp
+ * @brief udp客户端
+ * @author Jerry.Yu (jerry.yu512@outlook.com)
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright MIT License
+ *
+ */
+#include "event_log.hpp"
+#include "event_loop.hpp"
+#include "udp_client.hpp"
+
+namespace brsdk {
+
+namespace net {
+
+namespace {
+
+// 创建非阻塞udp套接字并connect到服务器，udp的connect只记录对端地址，不会阻塞
+int create_connected_socket(const Address& addr) {
+	int sockfd = sock_creat(addr.family(), SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+	if (sockfd < 0) {
+		LOG_SYSFATAL << "UdpClient create socket";
+	}
+
+	if (::connect(sockfd, addr.sockaddr(), sock_addr_len(addr.addr())) < 0) {
+		LOG_SYSERR << "UdpClient connect " << addr.ipport();
+	}
+
+	return sockfd;
+}
+
+} // namespace
+
+UdpClient::UdpClient(EventLoop* loop, const Address& serverAddr, const std::string& nameArg)
+	: loop_(loop),
+	  server_addr_(serverAddr),
+	  name_(nameArg),
+	  endpoint_(new UdpEndpoint(loop, create_connected_socket(serverAddr))),
+	  started_(0) {
+}
+
+UdpClient::~UdpClient() {
+	loop_->AssertInLoopThread();
+	LOG_TRACE << "UdpClient::~UdpClient [" << name_ << "] destructing";
+}
+
+void UdpClient::start(void) {
+	if (0 == started_.exchange(1)) {
+		loop_->RunInLoop(std::bind(&UdpEndpoint::start, get_pointer(endpoint_)));
+	}
+}
+
+void UdpClient::send(const void* data, size_t len) {
+	if (loop_->IsInLoopThread()) {
+		endpoint_->SendTo(data, len, nullptr);
+	} else {
+		loop_->RunInLoop(std::bind(&UdpClient::SendInLoop, this,
+								   std::string(static_cast<const char*>(data), len)));
+	}
+}
+
+void UdpClient::send(const str::StringPiece& message) {
+	send(message.data(), static_cast<size_t>(message.size()));
+}
+
+void UdpClient::SendInLoop(const std::string& message) {
+	endpoint_->SendTo(message.data(), message.size(), nullptr);
+}
+
+} // namespace net
+
+} // namespace brsdk
@@ -0,0 +1,94 @@
+/**
+ * MIT License
+ *
+ * Copyright © 2021 <Jerry.Yu>.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the “Software”), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * @file udp_client.hpp
+ * @brief udp客户端
+ * @author Jerry.Yu (jerry.yu512@outlook.com)
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright MIT License
+ *
+ */
+#pragma once
+#include <memory>
+#include <atomic>
+#include <string>
+#include "brsdk/mix/noncopyable.hpp"
+#include "brsdk/net/socket/address.hpp"
+#include "udp_endpoint.hpp"
+#include "event_typedef.hpp"
+
+namespace brsdk {
+
+namespace net {
+
+/**
+ * @brief udp客户端
+ * @details 套接字connect到服务器地址，只收发该地址的数据报，收发由 @c UdpEndpoint 批量完成
+ *
+ */
+class UdpClient : noncopyable {
+public:
+	UdpClient(EventLoop* loop, const Address& serverAddr, const std::string& nameArg);
+	~UdpClient();
+
+	const std::string& name(void) const { return name_; }
+	EventLoop* GetLoop(void) const { return loop_; }
+	const Address& server(void) const { return server_addr_; }
+
+	// 每批收发的数据报数，必须在 @c start 之前调用
+	void SetBatchSize(size_t batch) { endpoint_->SetBatchSize(batch); }
+	// 单个数据报最大长度，必须在 @c start 之前调用
+	void SetDatagramSize(size_t size) { endpoint_->SetDatagramSize(size); }
+	// 开启GRO/GSO，内核不支持时返回false，必须在 @c start 之前调用
+	bool SetSegmentationOffload(bool on) { return endpoint_->SetSegmentationOffload(on); }
+
+	// 设置消息接收回调接口
+	void SetMessageCallback(const UdpMessageCallback& cb) { endpoint_->SetMessageCallback(cb); }
+
+	// 开始收发，可重复调用，线程安全
+	void start(void);
+
+	/**
+	 * @brief 发送数据报到服务器
+	 * @details loop线程内直接拷贝进发送槽，其他线程调用时数据先拷贝再转入loop线程
+	 *
+	 * @param data 数据
+	 * @param len 长度
+	 */
+	void send(const void* data, size_t len);
+	void send(const str::StringPiece& message);
+
+	// 丢弃的数据报数
+	uint64_t dropped(void) const { return endpoint_->dropped(); }
+
+private:
+	void SendInLoop(const std::string& message);
+
+	EventLoop* loop_;					///< 事件循环
+	const Address server_addr_;			///< 服务器地址
+	const std::string name_;			///< 名称
+	std::unique_ptr<UdpEndpoint> endpoint_;	///< 收发端点
+	std::atomic_int started_;			///< 已启动
+};
+
+} // namespace net
+
+} // namespace brsdk
@@ -0,0 +1,425 @@
+/**
+ * MIT License
+ *
+ * Copyright © 2021 <Jerry.Yu>.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the “Software”), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * @file udp_endpoint.cpp
+ * @brief udp批量收发端点
+ * @author Jerry.Yu (jerry.yu512@outlook.com)
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright MIT License
+ *
+ */
+#include "event_log.hpp"
+#include "event_loop.hpp"
+#include "udp_endpoint.hpp"
+#include <netinet/in.h>
+#include <netinet/udp.h>
+#include <assert.h>
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+#include <algorithm>
+
+#ifndef SOL_UDP
+#define SOL_UDP IPPROTO_UDP
+#endif
+#ifndef UDP_SEGMENT
+#define UDP_SEGMENT 103
+#endif
+#ifndef UDP_GRO
+#define UDP_GRO 104
+#endif
+
+namespace brsdk {
+
+namespace net {
+
+const size_t UdpEndpoint::kDefaultBatchSize;
+const size_t UdpEndpoint::kDefaultDatagramSize;
+const size_t UdpEndpoint::kMaxAggregateSize;
+const size_t UdpEndpoint::kMaxSegments;
+const int UdpEndpoint::kMaxBatchesPerRound;
+
+namespace {
+
+// GSO聚合报文负载上限(ipv4最大udp负载)
+const size_t kMaxGsoPayload = 65507;
+
+bool would_block(int err) {
+	return err == EAGAIN || err == EWOULDBLOCK;
+}
+
+bool same_peer(const sock_addr_t& a, const sock_addr_t* b) {
+	if (nullptr == b) {
+		return true;
+	}
+	socklen_t len = sock_addr_len(b);
+	return a.sa.sa_family == b->sa.sa_family && 0 == ::memcmp(&a, b, len);
+}
+
+} // namespace
+
+void UdpEndpoint::MessageSlab::reset(size_t batch, size_t slot) {
+	data.reset(new char[batch * slot]);
+	msgs.assign(batch, mmsghdr());
+	iovs.assign(batch, iovec());
+	addrs.assign(batch, sock_addr_t());
+	controls.assign(batch, Control());
+	slot_size = slot;
+
+	for (size_t i = 0; i < batch; i++) {
+		iovs[i].iov_base = buffer(i);
+		iovs[i].iov_len = slot;
+		msgs[i].msg_hdr.msg_iov = &iovs[i];
+		msgs[i].msg_hdr.msg_iovlen = 1;
+	}
+}
+
+UdpEndpoint::UdpEndpoint(EventLoop* loop, int sockfd)
+	: loop_(loop),
+	  sockfd_(sockfd),
+	  channel_(loop, sockfd),
+	  batch_(kDefaultBatchSize),
+	  datagram_size_(kDefaultDatagramSize),
+	  gro_(false),
+	  gso_(false),
+	  reading_(false),
+	  send_count_(0),
+	  dropped_(0) {
+	channel_.SetReadCallback(std::bind(&UdpEndpoint::HandleRead, this, _1));
+	channel_.SetWriteCallback(std::bind(&UdpEndpoint::HandleWrite, this));
+}
+
+UdpEndpoint::~UdpEndpoint() {
+	channel_.DisableAll();
+	channel_.remove();
+	::close(sockfd_);
+}
+
+void UdpEndpoint::SetBatchSize(size_t batch) {
+	assert(batch > 0);
+	batch_ = batch;
+}
+
+void UdpEndpoint::SetDatagramSize(size_t size) {
+	assert(size > 0 && size <= kMaxAggregateSize);
+	datagram_size_ = size;
+}
+
+bool UdpEndpoint::SetSegmentationOffload(bool on) {
+	int optval = on ? 1 : 0;
+	gro_ = 0 == ::setsockopt(sockfd_, SOL_UDP, UDP_GRO, &optval, static_cast<socklen_t>(sizeof optval)) && on;
+
+	// UDP_SEGMENT可读即表示内核支持GSO
+	socklen_t optlen = static_cast<socklen_t>(sizeof optval);
+	gso_ = on && 0 == ::getsockopt(sockfd_, SOL_UDP, UDP_SEGMENT, &optval, &optlen);
+
+	if (on && !(gro_ && gso_)) {
+		LOG_WARN << "UDP segmentation offload is not supported, gro = " << gro_ << ", gso = " << gso_;
+	}
+
+	return !on || (gro_ && gso_);
+}
+
+void UdpEndpoint::start(void) {
+	loop_->AssertInLoopThread();
+	recv_.reset(batch_, gro_ ? kMaxAggregateSize : datagram_size_);
+	send_.reset(batch_, gso_ ? kMaxAggregateSize : datagram_size_);
+	send_slots_.assign(batch_, SendSlot());
+	send_count_ = 0;
+	channel_.EnableReading();
+}
+
+void UdpEndpoint::HandleRead(Timestamp receive_time) {
+	loop_->AssertInLoopThread();
+	reading_ = true;
+
+	for (int round = 0; round < kMaxBatchesPerRound; round++) {
+		// 内核会改写地址与控制消息长度，每批重置
+		for (size_t i = 0; i < batch_; i++) {
+			struct msghdr& hdr = recv_.msgs[i].msg_hdr;
+			hdr.msg_name = &recv_.addrs[i];
+			hdr.msg_namelen = static_cast<socklen_t>(sizeof(sock_addr_t));
+			hdr.msg_control = gro_ ? recv_.controls[i].buf : nullptr;
+			hdr.msg_controllen = gro_ ? sizeof(Control) : 0;
+			hdr.msg_flags = 0;
+		}
+
+		int n = ::recvmmsg(sockfd_, recv_.msgs.data(), static_cast<unsigned int>(batch_), MSG_DONTWAIT, nullptr);
+		if (n < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			// 已connect的套接字收到icmp不可达，错误被取走后继续接收
+			if (errno == ECONNREFUSED) {
+				LOG_DEBUG << "UdpEndpoint fd = " << sockfd_ << " peer refused";
+				continue;
+			}
+			if (!would_block(errno)) {
+				LOG_SYSERR << "UdpEndpoint::HandleRead recvmmsg";
+			}
+			break;
+		}
+
+		for (int i = 0; i < n; i++) {
+			deliver(static_cast<size_t>(i), receive_time);
+		}
+
+		if (static_cast<size_t>(n) < batch_) {
+			break;
+		}
+	}
+
+	reading_ = false;
+	// 回调中产生的应答一次发出
+	flush();
+}
+
+void UdpEndpoint::deliver(size_t i, Timestamp receive_time) {
+	const struct mmsghdr& msg = recv_.msgs[i];
+	size_t len = msg.msg_len;
+	size_t segment = len;
+	if (gro_) {
+		for (struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg.msg_hdr); cmsg; cmsg = CMSG_NXTHDR(const_cast<struct msghdr*>(&msg.msg_hdr), cmsg)) {
+			if (cmsg->cmsg_level == SOL_UDP && cmsg->cmsg_type == UDP_GRO) {
+				int gso_size = 0;
+				::memcpy(&gso_size, CMSG_DATA(cmsg), sizeof(gso_size));
+				if (gso_size > 0) {
+					segment = static_cast<size_t>(gso_size);
+				}
+				break;
+			}
+		}
+	}
+
+	if (msg.msg_hdr.msg_flags & MSG_TRUNC) {
+		dropped_++;
+		LOG_WARN << "UdpEndpoint fd = " << sockfd_ << " datagram exceeds " << recv_.slot_size << " bytes, dropped";
+		return;
+	}
+
+	Address peer(recv_.addrs[i]);
+	const char* data = recv_.buffer(i);
+	if (0 == len) {
+		if (message_callback_) {
+			message_callback_(str::StringPiece(data, 0), peer, receive_time);
+		}
+		return;
+	}
+
+	// GRO聚合报文按分段长度拆回原始数据报，只有最后一段可能较短
+	for (size_t offset = 0; offset < len; offset += segment) {
+		size_t n = std::min(segment, len - offset);
+		// GRO接收槽大于数据报上限，超长数据报同样丢弃
+		if (n > datagram_size_) {
+			dropped_++;
+			LOG_WARN << "UdpEndpoint fd = " << sockfd_ << " datagram exceeds " << datagram_size_ << " bytes, dropped";
+		} else if (message_callback_) {
+			message_callback_(str::StringPiece(data + offset, static_cast<int>(n)), peer, receive_time);
+		}
+	}
+}
+
+bool UdpEndpoint::SendTo(const void* data, size_t len, const sock_addr_t* peer) {
+	loop_->AssertInLoopThread();
+	if (len > datagram_size_ || send_slots_.empty()) {
+		dropped_++;
+		LOG_ERROR << "UdpEndpoint fd = " << sockfd_ << " drop datagram of " << len << " bytes";
+		return false;
+	}
+
+	if (gso_ && coalesce(data, len, peer)) {
+		return true;
+	}
+
+	if (send_count_ == batch_) {
+		flush();
+		if (send_count_ == batch_) {
+			dropped_++;
+			return false;
+		}
+	}
+
+	size_t i = send_count_++;
+	struct msghdr& hdr = send_.msgs[i].msg_hdr;
+	::memcpy(send_.buffer(i), data, len);
+	send_.iovs[i].iov_len = len;
+	if (peer) {
+		::memcpy(&send_.addrs[i], peer, sock_addr_len(peer));
+		hdr.msg_name = &send_.addrs[i];
+		hdr.msg_namelen = sock_addr_len(peer);
+	} else {
+		hdr.msg_name = nullptr;
+		hdr.msg_namelen = 0;
+	}
+	hdr.msg_control = nullptr;
+	hdr.msg_controllen = 0;
+	send_slots_[i].segment = len;
+	send_slots_[i].segments = 1;
+	send_slots_[i].closed = false;
+
+	// 读事件外的发送借写事件在本轮循环末尾统一发出
+	if (!reading_ && !channel_.iswriting()) {
+		channel_.EnableWriting();
+	}
+
+	return true;
+}
+
+bool UdpEndpoint::coalesce(const void* data, size_t len, const sock_addr_t* peer) {
+	if (0 == send_count_ || 0 == len) {
+		return false;
+	}
+
+	size_t i = send_count_ - 1;
+	SendSlot& slot = send_slots_[i];
+	struct msghdr& hdr = send_.msgs[i].msg_hdr;
+	size_t total = send_.iovs[i].iov_len;
+	// 分段长度相同(最后一段可以较短)且发往同一对端的数据报才能合并
+	if (slot.closed || len > slot.segment || slot.segments >= kMaxSegments
+		|| total + len > kMaxGsoPayload
+		|| (peer ? nullptr == hdr.msg_name : nullptr != hdr.msg_name)
+		|| (peer && !same_peer(send_.addrs[i], peer))) {
+		return false;
+	}
+
+	::memcpy(send_.buffer(i) + total, data, len);
+	send_.iovs[i].iov_len = total + len;
+	slot.segments++;
+	slot.closed = len < slot.segment;
+
+	if (!reading_ && !channel_.iswriting()) {
+		channel_.EnableWriting();
+	}
+
+	return true;
+}
+
+void UdpEndpoint::flush(void) {
+	loop_->AssertInLoopThread();
+	size_t sent = 0;
+
+	// 多于一段的槽附带UDP_SEGMENT控制消息
+	for (size_t i = 0; i < send_count_; i++) {
+		struct msghdr& hdr = send_.msgs[i].msg_hdr;
+		if (send_slots_[i].segments > 1) {
+			hdr.msg_control = send_.controls[i].buf;
+			hdr.msg_controllen = CMSG_SPACE(sizeof(uint16_t));
+			struct cmsghdr* cmsg = CMSG_FIRSTHDR(&hdr);
+			cmsg->cmsg_level = SOL_UDP;
+			cmsg->cmsg_type = UDP_SEGMENT;
+			cmsg->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+			uint16_t segment = static_cast<uint16_t>(send_slots_[i].segment);
+			::memcpy(CMSG_DATA(cmsg), &segment, sizeof(segment));
+		} else {
+			hdr.msg_control = nullptr;
+			hdr.msg_controllen = 0;
+		}
+	}
+
+	while (sent < send_count_) {
+		int n = ::sendmmsg(sockfd_, &send_.msgs[sent], static_cast<unsigned int>(send_count_ - sent), MSG_DONTWAIT);
+		if (n > 0) {
+			sent += static_cast<size_t>(n);
+			continue;
+		}
+
+		if (errno == EINTR) {
+			continue;
+		}
+		// 已connect的套接字上报之前的icmp不可达，报文并未发出，错误取走后重发
+		if (errno == ECONNREFUSED) {
+			LOG_DEBUG << "UdpEndpoint fd = " << sockfd_ << " peer refused";
+			continue;
+		}
+		// 发送缓冲区满，等待写事件
+		if (would_block(errno)) {
+			break;
+		}
+
+		// 队首报文发送失败，聚合报文退化为逐个发送，其余报文丢弃
+		if (send_slots_[sent].segments > 1) {
+			LOG_SYSERR << "UdpEndpoint fd = " << sockfd_ << " UDP_SEGMENT send failed, disable gso";
+			gso_ = false;
+			SendSegments(sent);
+		} else {
+			LOG_SYSERR << "UdpEndpoint fd = " << sockfd_ << " sendmmsg";
+			dropped_++;
+		}
+		sent++;
+	}
+
+	compact(sent);
+
+	if (send_count_ > 0) {
+		if (!channel_.iswriting()) {
+			channel_.EnableWriting();
+		}
+	} else if (channel_.iswriting()) {
+		channel_.DisableWriting();
+	}
+}
+
+void UdpEndpoint::SendSegments(size_t i) {
+	const struct msghdr& hdr = send_.msgs[i].msg_hdr;
+	const char* data = send_.buffer(i);
+	size_t len = send_.iovs[i].iov_len;
+	size_t segment = send_slots_[i].segment;
+
+	for (size_t offset = 0; offset < len; offset += segment) {
+		size_t n = std::min(segment, len - offset);
+		if (::sendto(sockfd_, data + offset, n, MSG_DONTWAIT,
+					 static_cast<const struct sockaddr*>(hdr.msg_name), hdr.msg_namelen) < 0) {
+			dropped_++;
+		}
+	}
+}
+
+void UdpEndpoint::compact(size_t sent) {
+	if (0 == sent) {
+		return;
+	}
+
+	// 发送缓冲区满时才会剩余，数量很少
+	size_t left = send_count_ - sent;
+	for (size_t i = 0; i < left; i++) {
+		size_t from = sent + i;
+		struct msghdr& hdr = send_.msgs[i].msg_hdr;
+		const struct msghdr& src = send_.msgs[from].msg_hdr;
+		::memcpy(send_.buffer(i), send_.buffer(from), send_.iovs[from].iov_len);
+		send_.iovs[i].iov_len = send_.iovs[from].iov_len;
+		send_.addrs[i] = send_.addrs[from];
+		hdr.msg_name = src.msg_name ? &send_.addrs[i] : nullptr;
+		hdr.msg_namelen = src.msg_namelen;
+		hdr.msg_control = nullptr;
+		hdr.msg_controllen = 0;
+		send_slots_[i] = send_slots_[from];
+	}
+	send_count_ = left;
+}
+
+void UdpEndpoint::HandleWrite(void) {
+	loop_->AssertInLoopThread();
+	flush();
+}
+
+} // namespace net
+
+} // namespace brsdk
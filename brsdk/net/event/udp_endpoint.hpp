@@ -0,0 +1,169 @@
+/**
+ * MIT License
+ *
+ * Copyright © 2021 <Jerry.Yu>.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the “Software”), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * @file udp_endpoint.hpp
+ * @brief udp批量收发端点
+ * @author Jerry.Yu (jerry.yu512@outlook.com)
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright MIT License
+ *
+ */
+#pragma once
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <stdint.h>
+#include <memory>
+#include <vector>
+#include "brsdk/mix/noncopyable.hpp"
+#include "brsdk/net/socket/socket_util.hpp"
+#include "event_channel.hpp"
+#include "event_typedef.hpp"
+
+namespace brsdk {
+
+namespace net {
+
+/**
+ * @brief udp端点，UdpServer/UdpClient共用的批量收发实现
+ * @details
+ * - 接收使用recvmmsg，一次系统调用读取一批数据报
+ * - 发送先排队到发送槽，批量满、读事件处理结束或者写事件到来时sendmmsg一次发出
+ * - 收发槽在start时一次分配，数据报路径上不再分配内存
+ * - 可选GRO/GSO：内核把同一对端的多个数据报聚合成一个大报文收发，接收时按分段长度拆开回调，
+ *   发送时把连续发往同一对端、长度相同的数据报合并为一个分段报文
+ * - 除设置接口外只能在loop线程调用
+ */
+class UdpEndpoint : noncopyable {
+public:
+	// 默认每批数据报数
+	static const size_t kDefaultBatchSize = 32;
+	// 默认单个数据报最大长度
+	static const size_t kDefaultDatagramSize = 2048;
+	// GRO/GSO聚合报文最大长度
+	static const size_t kMaxAggregateSize = 65535;
+	// GSO单个聚合报文最多分段数
+	static const size_t kMaxSegments = 64;
+	// 单次读事件最多接收的批次，避免饿死其他通道
+	static const int kMaxBatchesPerRound = 8;
+
+	/**
+	 * @brief 构造
+	 *
+	 * @param loop 所属事件循环
+	 * @param sockfd 非阻塞udp套接字，由端点接管并负责关闭
+	 */
+	UdpEndpoint(EventLoop* loop, int sockfd);
+	~UdpEndpoint();
+
+	int fd(void) const { return sockfd_; }
+
+	// 每批收发的数据报数，必须在 @c start 之前调用
+	void SetBatchSize(size_t batch);
+	// 单个数据报最大长度，超长的接收数据报被丢弃，必须在 @c start 之前调用
+	void SetDatagramSize(size_t size);
+	/**
+	 * @brief 开启/关闭GRO/GSO，必须在 @c start 之前调用
+	 *
+	 * @return true 内核支持
+	 * @return false 内核不支持，退化为普通批量收发
+	 */
+	bool SetSegmentationOffload(bool on);
+	void SetMessageCallback(const UdpMessageCallback& cb) { message_callback_ = cb; }
+
+	// 分配收发槽并开始接收，loop线程调用
+	void start(void);
+
+	/**
+	 * @brief 发送数据报，数据拷贝进发送槽后立即返回
+	 *
+	 * @param data 数据
+	 * @param len 长度
+	 * @param peer 对端地址，已connect的套接字传nullptr
+	 * @return true 已排队
+	 * @return false 数据报超长或者发送槽已满，数据报被丢弃
+	 */
+	bool SendTo(const void* data, size_t len, const sock_addr_t* peer);
+	// 发出已排队的数据报
+	void flush(void);
+
+	// 已排队未发出的报文数
+	size_t pending(void) const { return send_count_; }
+	// 丢弃的数据报数
+	uint64_t dropped(void) const { return dropped_; }
+
+private:
+	// 控制消息缓冲区，GRO上报int，GSO设置uint16_t
+	union Control {
+		char buf[CMSG_SPACE(sizeof(int))];
+		struct cmsghdr align;
+	};
+
+	// 发送槽状态
+	struct SendSlot {
+		size_t segment = 0;		///< 分段长度
+		size_t segments = 0;	///< 分段数
+		bool closed = false;	///< 最后一段较短，不能再合并
+	};
+
+	/**
+	 * @brief 预分配的消息槽，收发各一组
+	 */
+	struct MessageSlab {
+		std::unique_ptr<char[]> data;		///< 数据区，batch个slot_size的槽
+		std::vector<struct mmsghdr> msgs;	///< recvmmsg/sendmmsg消息头
+		std::vector<struct iovec> iovs;		///< 每槽一个iovec
+		std::vector<sock_addr_t> addrs;		///< 对端地址
+		std::vector<Control> controls;		///< 控制消息
+		size_t slot_size = 0;				///< 槽大小
+
+		void reset(size_t batch, size_t slot);
+		char* buffer(size_t i) const { return data.get() + i * slot_size; }
+	};
+
+	void HandleRead(Timestamp receive_time);
+	void HandleWrite(void);
+	void deliver(size_t i, Timestamp receive_time);
+	// GSO合并到最后一个发送槽
+	bool coalesce(const void* data, size_t len, const sock_addr_t* peer);
+	// 聚合报文发送失败时逐个发送其分段
+	void SendSegments(size_t i);
+	// 未发完的槽搬到队首
+	void compact(size_t sent);
+
+	EventLoop* loop_;
+	const int sockfd_;
+	EventChannel channel_;
+	size_t batch_;					///< 每批数据报数
+	size_t datagram_size_;			///< 单个数据报最大长度
+	bool gro_;						///< 接收聚合
+	bool gso_;						///< 发送分段
+	bool reading_;					///< 正在处理读事件，应答在读事件结束时一起发出
+	MessageSlab recv_;				///< 接收槽
+	MessageSlab send_;				///< 发送槽
+	std::vector<SendSlot> send_slots_;	///< 发送槽状态
+	size_t send_count_;				///< 已排队的发送槽数
+	uint64_t dropped_;				///< 丢弃的数据报数
+	UdpMessageCallback message_callback_;
+};
+
+} // namespace net
+
+} // namespace brsdk
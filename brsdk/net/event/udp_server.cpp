@@ -0,0 +1,105 @@
+/**
+ * MIT License
+ *
+ * Copyright © 2021 <Jerry.Yu>.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the “Software”), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * @file udp_server.cpp
+ * @brief udp服务器
+ * @author Jerry.Yu (jerry.yu512@outlook.com)
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright MIT License
+ *
+ */
+#include "event_log.hpp"
+#include "event_loop.hpp"
+#include "udp_server.hpp"
+
+namespace brsdk {
+
+namespace net {
+
+namespace {
+
+// 创建并绑定非阻塞udp套接字
+int create_bound_socket(const Address& addr, bool reuseport) {
+	int sockfd = sock_creat(addr.family(), SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+	if (sockfd < 0) {
+		LOG_SYSFATAL << "UdpServer create socket";
+	}
+
+	sock_set_addr_reuse(sockfd);
+	if (reuseport) {
+#ifdef SO_REUSEPORT
+		int optval = 1;
+		if (::setsockopt(sockfd, SOL_SOCKET, SO_REUSEPORT, &optval, static_cast<socklen_t>(sizeof optval)) < 0) {
+			LOG_SYSERR << "SO_REUSEPORT failed.";
+		}
+#else
+		LOG_ERROR << "SO_REUSEPORT is not supported.";
+#endif
+	}
+
+	if (::bind(sockfd, addr.sockaddr(), sock_addr_len(addr.addr())) < 0) {
+		LOG_SYSFATAL << "UdpServer bind " << addr.ipport();
+	}
+
+	return sockfd;
+}
+
+} // namespace
+
+UdpServer::UdpServer(EventLoop* loop, const Address& listenAddr, const std::string& nameArg, bool reuseport)
+	: loop_(loop),
+	  ipport_(listenAddr.ipport()),
+	  name_(nameArg),
+	  endpoint_(new UdpEndpoint(loop, create_bound_socket(listenAddr, reuseport))),
+	  started_(0) {
+}
+
+UdpServer::~UdpServer() {
+	loop_->AssertInLoopThread();
+	LOG_TRACE << "UdpServer::~UdpServer [" << name_ << "] destructing";
+}
+
+void UdpServer::start(void) {
+	if (0 == started_.exchange(1)) {
+		loop_->RunInLoop(std::bind(&UdpEndpoint::start, get_pointer(endpoint_)));
+	}
+}
+
+void UdpServer::SendTo(const void* data, size_t len, const Address& peer) {
+	if (loop_->IsInLoopThread()) {
+		endpoint_->SendTo(data, len, peer.addr());
+	} else {
+		loop_->RunInLoop(std::bind(&UdpServer::SendToInLoop, this,
+								   std::string(static_cast<const char*>(data), len), peer));
+	}
+}
+
+void UdpServer::SendTo(const str::StringPiece& message, const Address& peer) {
+	SendTo(message.data(), static_cast<size_t>(message.size()), peer);
+}
+
+void UdpServer::SendToInLoop(const std::string& message, const Address& peer) {
+	endpoint_->SendTo(message.data(), message.size(), peer.addr());
+}
+
+} // namespace net
+
+} // namespace brsdk
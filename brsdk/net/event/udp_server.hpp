@@ -0,0 +1,103 @@
+/**
+ * MIT License
+ *
+ * Copyright © 2021 <Jerry.Yu>.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the “Software”), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * @file udp_server.hpp
+ * @brief udp服务器
+ * @author Jerry.Yu (jerry.yu512@outlook.com)
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright MIT License
+ *
+ */
+#pragma once
+#include <memory>
+#include <atomic>
+#include <string>
+#include "brsdk/mix/noncopyable.hpp"
+#include "brsdk/net/socket/address.hpp"
+#include "udp_endpoint.hpp"
+#include "event_typedef.hpp"
+
+namespace brsdk {
+
+namespace net {
+
+/**
+ * @brief udp服务器
+ * @details 收发由 @c UdpEndpoint 批量完成，回调中的应答在本批数据报处理完后一次发出
+ *
+ */
+class UdpServer : noncopyable {
+public:
+	/**
+	 * @brief 构造并绑定监听地址
+	 *
+	 * @param loop 事件循环
+	 * @param listenAddr 监听地址
+	 * @param nameArg 名称
+	 * @param reuseport 开启SO_REUSEPORT，多个服务器可以绑定同一地址由内核分发
+	 */
+	UdpServer(EventLoop* loop, const Address& listenAddr, const std::string& nameArg, bool reuseport = false);
+	~UdpServer();
+
+	const std::string& ipport(void) const { return ipport_; }
+	const std::string& name(void) const { return name_; }
+	EventLoop* GetLoop(void) const { return loop_; }
+
+	// 每批收发的数据报数，必须在 @c start 之前调用
+	void SetBatchSize(size_t batch) { endpoint_->SetBatchSize(batch); }
+	// 单个数据报最大长度，必须在 @c start 之前调用
+	void SetDatagramSize(size_t size) { endpoint_->SetDatagramSize(size); }
+	// 开启GRO/GSO，内核不支持时返回false，必须在 @c start 之前调用
+	bool SetSegmentationOffload(bool on) { return endpoint_->SetSegmentationOffload(on); }
+
+	// 设置消息接收回调接口
+	void SetMessageCallback(const UdpMessageCallback& cb) { endpoint_->SetMessageCallback(cb); }
+
+	// 开始接收，可重复调用，线程安全
+	void start(void);
+
+	/**
+	 * @brief 发送数据报
+	 * @details loop线程内直接拷贝进发送槽，其他线程调用时数据先拷贝再转入loop线程
+	 *
+	 * @param data 数据
+	 * @param len 长度
+	 * @param peer 对端地址
+	 */
+	void SendTo(const void* data, size_t len, const Address& peer);
+	void SendTo(const str::StringPiece& message, const Address& peer);
+
+	// 丢弃的数据报数
+	uint64_t dropped(void) const { return endpoint_->dropped(); }
+
+private:
+	void SendToInLoop(const std::string& message, const Address& peer);
+
+	EventLoop* loop_;					///< 事件循环
+	const std::string ipport_;			///< 监听地址
+	const std::string name_;			///< 名称
+	std::unique_ptr<UdpEndpoint> endpoint_;	///< 收发端点
+	std::atomic_int started_;			///< 已启动
+};
+
+} // namespace net
+
+} // namespace brsdk
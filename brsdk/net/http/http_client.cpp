@@ -0,0 +1,388 @@
+/**
+ * MIT License
+ *
+ * Copyright © 2021 <Jerry.Yu>.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the “Software”), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * @file http_client.cpp
+ * @brief 基于事件循环的HTTP/1.1客户端
+ * @author Jerry.Yu (jerry.yu512@outlook.com)
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright MIT License
+ *
+ */
+#include "http_client.hpp"
+#include <stdio.h>
+#include <algorithm>
+#include "brsdk/net/event/connector.hpp"
+#include "brsdk/net/event/connection.hpp"
+#include "brsdk/net/event/event_loop.hpp"
+#include "brsdk/net/event/tcp_client.hpp"
+#include "http_log.hpp"
+
+namespace brsdk {
+
+namespace net {
+
+const double HttpClient::kDefaultTimeout = 5.0;
+const double HttpClient::kDefaultIdleTimeout = 60.0;
+
+namespace {
+
+// 空闲检查间隔，秒
+const double kIdleCheckInterval = 1.0;
+
+} // namespace
+
+// 一个请求
+struct HttpClient::Call {
+	std::string data;		///< 编码后的请求，发送后释放
+	ResponseCallback cb;	///< 应答回调
+	TimerId timer;			///< 超时定时器
+	Host* host = nullptr;	///< 所属连接池
+	Link* link = nullptr;	///< 已发送时所在的连接
+	bool head = false;		///< HEAD请求
+	bool done = false;		///< 已回调
+};
+
+// 一条keep-alive连接
+struct HttpClient::Link {
+	explicit Link(Host* h) : host(h) {}
+
+	Host* host;					///< 所属连接池
+	TcpConnectorPtr connector;	///< 连接器
+	TcpConnectionPtr conn;		///< 连接，建立之前为空
+	std::deque<CallPtr> inflight;	///< 在途请求，按发送顺序
+	HttpResponseParser parser;	///< 应答解析器
+	Timestamp last_active;		///< 最近一次收发时间
+	bool reusable = true;		///< 可以发送新请求
+};
+
+// 一个服务器地址的连接池
+struct HttpClient::Host {
+	explicit Host(const Address& addr) : server(addr), host_header("Host: " + addr.ipport() + "\r\n") {}
+
+	Address server;				///< 服务器地址
+	std::string host_header;	///< Host头部
+	std::vector<std::unique_ptr<Link>> links;	///< 连接
+	std::deque<CallPtr> waiting;	///< 排队的请求
+};
+
+HttpClient::HttpClient(EventLoop* loop, const std::string& name)
+	: loop_(loop),
+	  name_(name),
+	  max_connections_(8),
+	  pipeline_depth_(1),
+	  timeout_(kDefaultTimeout),
+	  idle_timeout_(kDefaultIdleTimeout),
+	  next_conn_id_(1) {
+	idle_timer_ = loop_->RunEvery(kIdleCheckInterval, std::bind(&HttpClient::EvictIdle, this));
+}
+
+HttpClient::~HttpClient() {
+	loop_->cancel(idle_timer_);
+	for (auto& item : hosts_) {
+		Host* host = item.second.get();
+		for (const CallPtr& call : host->waiting) {
+			loop_->cancel(call->timer);
+		}
+		for (auto& link : host->links) {
+			for (const CallPtr& call : link->inflight) {
+				if (!call->done) {
+					loop_->cancel(call->timer);
+				}
+			}
+			if (link->conn) {
+				AbandonConnection(loop_, link->conn);
+			} else {
+				AbandonConnector(loop_, link->connector);
+			}
+		}
+	}
+}
+
+void HttpClient::request(const Address& server, HttpRequest::Method method, const str::StringPiece& target,
+						 const str::StringPiece& body, const ResponseCallback& cb,
+						 const str::StringPiece& headers) {
+	loop_->AssertInLoopThread();
+	Host* host = GetHost(server);
+	CallPtr call = std::make_shared<Call>();
+	call->cb = cb;
+	call->host = host;
+	call->head = method == HttpRequest::kHead;
+
+	std::string& data = call->data;
+	data.reserve(64 + target.size() + host->host_header.size() + headers.size() + body.size());
+	data.append(HttpRequest::MethodString(method));
+	data.push_back(' ');
+	data.append(target.data(), target.size());
+	data.append(" HTTP/1.1\r\n", 11);
+	data.append(host->host_header);
+	if (!body.empty() || method == HttpRequest::kPost || method == HttpRequest::kPut
+		|| method == HttpRequest::kPatch) {
+		char length[48];
+		int n = ::snprintf(length, sizeof(length), "Content-Length: %d\r\n", body.size());
+		data.append(length, n);
+	}
+	data.append(headers.data(), headers.size());
+	data.append("\r\n", 2);
+	data.append(body.data(), body.size());
+
+	call->timer = loop_->RunAfter(timeout_, std::bind(&HttpClient::OnTimeout, this, std::weak_ptr<Call>(call)));
+	host->waiting.push_back(call);
+	dispatch(host);
+}
+
+size_t HttpClient::connection_count(void) const {
+	size_t count = 0;
+	for (const auto& item : hosts_) {
+		count += item.second->links.size();
+	}
+	return count;
+}
+
+HttpClient::Host* HttpClient::GetHost(const Address& server) {
+	std::unique_ptr<Host>& host = hosts_[server.ipport()];
+	if (!host) {
+		host.reset(new Host(server));
+	}
+	return host.get();
+}
+
+void HttpClient::dispatch(Host* host) {
+	size_t connecting = 0;
+	while (!host->waiting.empty()) {
+		// 在途请求最少的可用连接
+		Link* best = nullptr;
+		connecting = 0;
+		for (auto& link : host->links) {
+			if (!link->conn) {
+				++connecting;
+			} else if (link->reusable && link->inflight.size() < pipeline_depth_
+					   && (nullptr == best || link->inflight.size() < best->inflight.size())) {
+				best = link.get();
+			}
+		}
+		if (nullptr == best) {
+			break;
+		}
+		CallPtr call = host->waiting.front();
+		host->waiting.pop_front();
+		SendCall(best, call);
+	}
+
+	// 排队的请求多于正在建立的连接时新建连接，立即失败时排队的请求可能已经回调
+	size_t need = host->waiting.size() > connecting ? host->waiting.size() - connecting : 0;
+	for (; need > 0 && !host->waiting.empty() && host->links.size() < max_connections_; --need) {
+		connect(host);
+	}
+}
+
+void HttpClient::connect(Host* host) {
+	Link* link = new Link(host);
+	host->links.emplace_back(link);
+	link->connector = std::make_shared<Connector>(loop_, host->server);
+	link->connector->SetNewConnectionCallback(std::bind(&HttpClient::OnNewConnection, this, link, _1));
+	link->connector->SetConnectionFailedCallback(std::bind(&HttpClient::OnConnectFailed, this, link));
+	link->connector->start();
+}
+
+void HttpClient::SendCall(Link* link, const CallPtr& call) {
+	call->link = link;
+	link->inflight.push_back(call);
+	link->last_active = Timestamp::now();
+	link->conn->send(call->data);
+	std::string().swap(call->data);
+}
+
+void HttpClient::complete(const CallPtr& call, Error error, const HttpClientResponse& response) {
+	call->done = true;
+	call->link = nullptr;
+	if (error != kTimeout) {
+		loop_->cancel(call->timer);
+	}
+	ResponseCallback cb;
+	cb.swap(call->cb);
+	if (cb) {
+		cb(error, response);
+	}
+}
+
+void HttpClient::FailInflight(Link* link, Error error) {
+	std::deque<CallPtr> calls;
+	calls.swap(link->inflight);
+	HttpClientResponse empty;
+	for (const CallPtr& call : calls) {
+		if (!call->done) {
+			complete(call, error, empty);
+		}
+	}
+}
+
+void HttpClient::RemoveLink(Link* link) {
+	std::vector<std::unique_ptr<Link>>& links = link->host->links;
+	for (auto it = links.begin(); it != links.end(); ++it) {
+		if (it->get() == link) {
+			ReleaseConnectorLater(loop_, link->connector);
+			links.erase(it);
+			return;
+		}
+	}
+}
+
+void HttpClient::OnNewConnection(Link* link, int sockfd) {
+	TcpConnectionPtr conn = NewClientConnection(loop_, name_, sockfd, &next_conn_id_);
+	conn->SetConnectionCallback(TcpConnection::DefaultConnectionCallback);
+	conn->SetMessageCallback(std::bind(&HttpClient::OnMessage, this, link, _1, _2));
+	conn->SetCloseCallback(std::bind(&HttpClient::OnClose, this, link, _1));
+	conn->SetNoDelay(true);
+	link->conn = conn;
+	link->last_active = Timestamp::now();
+	conn->ConnectEstablished();
+	dispatch(link->host);
+}
+
+void HttpClient::OnConnectFailed(Link* link) {
+	LOG_WARN << "HttpClient [" << name_ << "] - connect to " << link->host->server.ipport() << " failed";
+	// 异步失败后连接器会自动重连，连接已经移除，停止重连
+	link->connector->stop();
+	Host* host = link->host;
+	RemoveLink(link);
+	if (!host->links.empty()) {
+		return;
+	}
+	std::deque<CallPtr> calls;
+	calls.swap(host->waiting);
+	HttpClientResponse empty;
+	for (const CallPtr& call : calls) {
+		complete(call, kConnectFailed, empty);
+	}
+}
+
+void HttpClient::OnMessage(Link* link, const TcpConnectionPtr& conn, NetBuffer* buf) {
+	while (!link->inflight.empty()) {
+		CallPtr call = link->inflight.front();
+		HttpResponseParser::Result result = link->parser.parse(*buf, call->head, &response_);
+		if (result == HttpResponseParser::kIncomplete) {
+			break;
+		}
+		if (result == HttpResponseParser::kError) {
+			LOG_ERROR << "HttpClient [" << conn->name() << "] - bad response";
+			link->reusable = false;
+			buf->retrieve_all();
+			FailInflight(link, kBadResponse);
+			conn->ForceClose();
+			return;
+		}
+
+		size_t size = link->parser.consumed();
+		int status = response_.status();
+		if (status < 200) {
+			// 100 Continue等中间应答
+			buf->retrieve(size);
+			link->parser.reset();
+			continue;
+		}
+		link->inflight.pop_front();
+		link->last_active = Timestamp::now();
+		if (!response_.keep_alive()) {
+			link->reusable = false;
+		}
+		if (!call->done) {
+			complete(call, kOk, response_);
+		}
+		buf->retrieve(size);
+		link->parser.reset();
+	}
+
+	if (link->inflight.empty()) {
+		if (buf->readable_bytes() > 0) {
+			LOG_ERROR << "HttpClient [" << conn->name() << "] - unexpected data";
+			buf->retrieve_all();
+			link->reusable = false;
+			conn->ForceClose();
+			return;
+		}
+		if (!link->reusable) {
+			conn->shutdown();
+		}
+	}
+	dispatch(link->host);
+}
+
+void HttpClient::OnClose(Link* link, const TcpConnectionPtr& conn) {
+	loop_->AssertInLoopThread();
+	link->reusable = false;
+	// 以连接关闭界定body的应答
+	if (!link->inflight.empty()) {
+		CallPtr call = link->inflight.front();
+		NetBuffer* buf = conn->input_buffer();
+		if (link->parser.finish(*buf, &response_) == HttpResponseParser::kComplete) {
+			link->inflight.pop_front();
+			if (!call->done) {
+				complete(call, kOk, response_);
+			}
+		}
+		buf->retrieve_all();
+	}
+	FailInflight(link, kConnectionClosed);
+
+	Host* host = link->host;
+	RemoveLink(link);
+	loop_->QueueInLoop(std::bind(&TcpConnection::ConnectDestroyed, conn));
+	dispatch(host);
+}
+
+void HttpClient::OnTimeout(const std::weak_ptr<Call>& weak_call) {
+	CallPtr call = weak_call.lock();
+	if (!call || call->done) {
+		return;
+	}
+
+	HttpClientResponse empty;
+	Link* link = call->link;
+	if (nullptr == link) {
+		std::deque<CallPtr>& waiting = call->host->waiting;
+		waiting.erase(std::find(waiting.begin(), waiting.end(), call));
+		complete(call, kTimeout, empty);
+		return;
+	}
+
+	// 已发送的请求无法撤回，关闭连接，同一连接上的其他请求在关闭时回调
+	LOG_WARN << "HttpClient [" << link->conn->name() << "] - request timeout";
+	link->reusable = false;
+	complete(call, kTimeout, empty);
+	link->conn->ForceClose();
+}
+
+void HttpClient::EvictIdle(void) {
+	Timestamp now = Timestamp::now();
+	for (auto& item : hosts_) {
+		for (auto& link : item.second->links) {
+			if (link->conn && link->reusable && link->inflight.empty()
+				&& timeDifference(now, link->last_active) > idle_timeout_) {
+				link->reusable = false;
+				link->conn->shutdown();
+			}
+		}
+	}
+}
+
+} // namespace net
+
+} // namespace brsdk
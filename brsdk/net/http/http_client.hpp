@@ -0,0 +1,160 @@
+/**
+ * MIT License
+ *
+ * Copyright © 2021 <Jerry.Yu>.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the “Software”), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * @file http_client.hpp
+ * @brief 基于事件循环的HTTP/1.1客户端
+ * @author Jerry.Yu (jerry.yu512@outlook.com)
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright MIT License
+ *
+ */
+#pragma once
+
+#include "brsdk/mix/noncopyable.hpp"
+#include "brsdk/net/socket/address.hpp"
+#include "brsdk/net/event/event_typedef.hpp"
+#include "brsdk/net/event/timer.hpp"
+#include "http_parser.hpp"
+#include "http_request.hpp"
+#include "http_response.hpp"
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace brsdk {
+
+namespace net {
+
+/**
+ * @brief 基于事件循环的HTTP/1.1客户端
+ * @details
+ * - 所有接口都在所属loop线程调用，连接、超时定时器与回调都在该loop内，不阻塞线程
+ * - 按服务器地址维护keep-alive连接池，每个地址最多 @c SetMaxConnections 条连接；
+ *   请求优先交给在途请求最少的空闲连接，都忙时新建连接，达到上限后排队
+ * - 每条连接最多 @c SetPipelineDepth 个在途请求，大于1时在同一连接上流水线发送
+ * - 请求超时后回调kTimeout；已发送的请求超时会关闭所在连接，同一连接上的其他在途请求回调kConnectionClosed
+ * - 应答的头部与body是接收缓冲区的视图，只在回调期间有效
+ * - 空闲超过 @c SetIdleTimeout 的连接被关闭
+ * - 建立连接失败(含异步的连接被拒绝)时移除该连接，没有其他连接时排队的请求回调kConnectFailed
+ * - 不在回调中析构客户端；析构时未完成的请求不再回调
+ */
+class HttpClient : noncopyable {
+public:
+	enum Error {
+		kOk,				///< 成功
+		kTimeout,			///< 超时
+		kConnectionClosed,	///< 应答之前连接关闭
+		kBadResponse,		///< 应答非法
+		kConnectFailed,		///< 建立连接失败
+	};
+
+	// 应答回调，error不为kOk时response为空
+	using ResponseCallback = std::function<void(Error error, const HttpClientResponse& response)>;
+
+	// 默认请求超时，秒
+	static const double kDefaultTimeout;
+	// 默认空闲连接超时，秒
+	static const double kDefaultIdleTimeout;
+
+	HttpClient(EventLoop* loop, const std::string& name);
+	~HttpClient();
+
+	EventLoop* GetLoop(void) const { return loop_; }
+	const std::string& name(void) const { return name_; }
+
+	// 每个服务器地址的最大连接数
+	void SetMaxConnections(size_t max_connections) { max_connections_ = max_connections; }
+	// 每条连接的最大在途请求数，1表示不使用流水线
+	void SetPipelineDepth(size_t depth) { pipeline_depth_ = depth; }
+	// 请求超时，从调用 @c request 开始计时，含排队与建立连接的时间
+	void SetTimeout(double seconds) { timeout_ = seconds; }
+	// 空闲连接超时，只影响之后的检查
+	void SetIdleTimeout(double seconds) { idle_timeout_ = seconds; }
+
+	/**
+	 * @brief 发送请求
+	 *
+	 * @param server 服务器地址
+	 * @param method 方法
+	 * @param target 请求目标，如"/users/1?x=y"
+	 * @param body 请求body，为空时不发送Content-Length(POST/PUT/PATCH除外)
+	 * @param cb 应答回调
+	 * @param headers 附加头部，每行以"\r\n"结尾，不含Host与Content-Length
+	 * @note 建立连接立即失败时在本函数返回之前回调kConnectFailed
+	 */
+	void request(const Address& server, HttpRequest::Method method, const str::StringPiece& target,
+				 const str::StringPiece& body, const ResponseCallback& cb,
+				 const str::StringPiece& headers = str::StringPiece());
+	void get(const Address& server, const str::StringPiece& target, const ResponseCallback& cb) {
+		request(server, HttpRequest::kGet, target, str::StringPiece(), cb);
+	}
+	void post(const Address& server, const str::StringPiece& target, const str::StringPiece& body,
+			  const ResponseCallback& cb) {
+		request(server, HttpRequest::kPost, target, body, cb);
+	}
+
+	// 当前连接总数，含正在建立的连接
+	size_t connection_count(void) const;
+
+private:
+	struct Call;
+	struct Link;
+	struct Host;
+	using CallPtr = std::shared_ptr<Call>;
+
+	Host* GetHost(const Address& server);
+	// 把排队的请求分配给连接，需要时新建连接
+	void dispatch(Host* host);
+	void connect(Host* host);
+	void SendCall(Link* link, const CallPtr& call);
+	// 结束请求，取消定时器并回调
+	void complete(const CallPtr& call, Error error, const HttpClientResponse& response);
+	// 回调连接上的全部在途请求
+	void FailInflight(Link* link, Error error);
+	// 从连接池移除并释放连接
+	void RemoveLink(Link* link);
+
+	void OnNewConnection(Link* link, int sockfd);
+	void OnConnectFailed(Link* link);
+	void OnMessage(Link* link, const TcpConnectionPtr& conn, NetBuffer* buf);
+	void OnClose(Link* link, const TcpConnectionPtr& conn);
+	void OnTimeout(const std::weak_ptr<Call>& weak_call);
+	// 关闭空闲连接
+	void EvictIdle(void);
+
+	EventLoop* loop_;			///< 所属事件循环
+	const std::string name_;	///< 名称
+	size_t max_connections_;	///< 每个地址的最大连接数
+	size_t pipeline_depth_;		///< 每条连接的最大在途请求数
+	double timeout_;			///< 请求超时
+	double idle_timeout_;		///< 空闲连接超时
+	int next_conn_id_;			///< 连接编号
+	TimerId idle_timer_;		///< 空闲检查定时器
+	std::map<std::string, std::unique_ptr<Host>> hosts_;	///< 各服务器地址的连接池
+	HttpClientResponse response_;	///< 复用的应答视图
+};
+
+} // namespace net
+
+} // namespace brsdk
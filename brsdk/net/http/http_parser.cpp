@@ -0,0 +1,443 @@
+/**
+ * MIT License
+ *
+ * Copyright © 2021 <Jerry.Yu>.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the “Software”), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * @file http_parser.cpp
+ * @brief http请求增量解析
+ * @author Jerry.Yu (jerry.yu512@outlook.com)
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright MIT License
+ *
+ */
+#include "http_parser.hpp"
+#include <string.h>
+#include <strings.h>
+#include "brsdk/str/scan.hpp"
+
+namespace brsdk {
+
+namespace net {
+
+const size_t HttpRequestParser::kDefaultMaxHeaderSize;
+const size_t HttpRequestParser::kDefaultMaxBodySize;
+const size_t HttpRequestParser::kMaxHeaders;
+const size_t HttpResponseParser::kDefaultMaxBodySize;
+
+namespace {
+
+inline bool is_space(char c) {
+	return c == ' ' || c == '\t';
+}
+
+inline bool equals_ignore_case(const char* data, size_t len, const char* name, size_t name_len) {
+	return len == name_len && 0 == ::strncasecmp(data, name, len);
+}
+
+// 十进制长度，不允许符号与空白，溢出返回false
+bool parse_length(const char* begin, const char* end, size_t* value) {
+	if (begin == end) {
+		return false;
+	}
+	size_t n = 0;
+	for (const char* p = begin; p < end; ++p) {
+		if (*p < '0' || *p > '9' || n > (static_cast<size_t>(-1) - 9) / 10) {
+			return false;
+		}
+		n = n * 10 + static_cast<size_t>(*p - '0');
+	}
+	*value = n;
+	return true;
+}
+
+// chunk长度行的上限，含扩展
+const size_t kMaxChunkLine = 1024;
+
+// 十六进制chunk长度，忽略';'之后的扩展
+bool parse_chunk_size(const char* begin, const char* end, size_t* value) {
+	size_t n = 0;
+	const char* p = begin;
+	for (; p < end && *p != ';' && !is_space(*p); ++p) {
+		int digit;
+		if (*p >= '0' && *p <= '9') {
+			digit = *p - '0';
+		} else if ((*p | 0x20) >= 'a' && (*p | 0x20) <= 'f') {
+			digit = (*p | 0x20) - 'a' + 10;
+		} else {
+			return false;
+		}
+		if (n > (static_cast<size_t>(-1) >> 4)) {
+			return false;
+		}
+		n = (n << 4) | static_cast<size_t>(digit);
+	}
+	*value = n;
+	return p != begin;
+}
+
+} // namespace
+
+HttpRequestParser::Result HttpRequestParser::parse(const NetBuffer& buf, HttpRequest* request) {
+	const char* begin = buf.peek();
+	size_t readable = buf.readable_bytes();
+	if (0 == header_size_) {
+		// 请求之前的空行可以忽略
+		while (readable - skipped_ >= 2 && begin[skipped_] == '\r' && begin[skipped_ + 1] == '\n') {
+			skipped_ += 2;
+		}
+		const char* start = begin + skipped_;
+		const char* end = 0 == skipped_ ? buf.find_CRLFCRLF() : buf.find_CRLFCRLF(start);
+		if (nullptr == end) {
+			if (readable - skipped_ > max_header_size_) {
+				return fail(431);
+			}
+			return kIncomplete;
+		}
+
+		header_size_ = static_cast<size_t>(end + 4 - start);
+		if (header_size_ > max_header_size_) {
+			return fail(431);
+		}
+		request->reset();
+		if (!ParseHeaders(start, end + 4, request)) {
+			return kError;
+		}
+		if (readable < consumed()) {
+			// 头部已收齐，等待body
+			str::StringPiece expect = request->header("Expect");
+			expect_continue_ = request->version_ == HttpRequest::kHttp11
+				&& equals_ignore_case(expect.data(), static_cast<size_t>(expect.size()), "100-continue", 12);
+			return kIncomplete;
+		}
+	} else {
+		if (readable < consumed()) {
+			return kIncomplete;
+		}
+		// 等待body期间缓冲区可能被搬移，重新切分头部
+		request->reset();
+		ParseHeaders(begin + skipped_, begin + skipped_ + header_size_, request);
+	}
+
+	request->body_ = str::StringPiece(begin + skipped_ + header_size_, static_cast<int>(body_size_));
+	return kComplete;
+}
+
+bool HttpRequestParser::ParseHeaders(const char* begin, const char* end, HttpRequest* request) {
+	const char* eol = str::find_crlf(begin, end);
+	if (!ParseRequestLine(begin, eol, request)) {
+		return false;
+	}
+
+	bool has_length = false;
+	bool has_host = false;
+	body_size_ = 0;
+	// 最后一个CRLF是头部结束的空行
+	const char* p = eol + 2;
+	while (p < end - 2) {
+		eol = str::find_crlf(p, end);
+		if (is_space(*p)) {
+			// 不支持折行
+			error_status_ = 400;
+			return false;
+		}
+		const char* colon = static_cast<const char*>(::memchr(p, ':', eol - p));
+		if (nullptr == colon || colon == p || is_space(colon[-1])) {
+			error_status_ = 400;
+			return false;
+		}
+		if (request->headers_.size() >= kMaxHeaders) {
+			error_status_ = 431;
+			return false;
+		}
+
+		const char* value = colon + 1;
+		const char* value_end = eol;
+		while (value < value_end && is_space(*value)) {
+			++value;
+		}
+		while (value_end > value && is_space(value_end[-1])) {
+			--value_end;
+		}
+		size_t name_len = static_cast<size_t>(colon - p);
+		request->headers_.emplace_back(str::StringPiece(p, static_cast<int>(name_len)),
+									   str::StringPiece(value, static_cast<int>(value_end - value)));
+
+		if (equals_ignore_case(p, name_len, "Content-Length", 14)) {
+			size_t length = 0;
+			// 多个Content-Length必须一致
+			if (!parse_length(value, value_end, &length) || (has_length && length != body_size_)) {
+				error_status_ = 400;
+				return false;
+			}
+			if (length > max_body_size_) {
+				error_status_ = 413;
+				return false;
+			}
+			body_size_ = length;
+			has_length = true;
+		} else if (equals_ignore_case(p, name_len, "Transfer-Encoding", 17)) {
+			// 不支持分块上传
+			error_status_ = 501;
+			return false;
+		} else if (equals_ignore_case(p, name_len, "Host", 4)) {
+			has_host = true;
+		}
+		p = eol + 2;
+	}
+
+	if (request->version_ == HttpRequest::kHttp11 && !has_host) {
+		error_status_ = 400;
+		return false;
+	}
+	return true;
+}
+
+bool HttpRequestParser::ParseRequestLine(const char* begin, const char* end, HttpRequest* request) {
+	error_status_ = 400;
+	const char* space = static_cast<const char*>(::memchr(begin, ' ', end - begin));
+	if (nullptr == space) {
+		return false;
+	}
+	request->method_ = HttpRequest::ParseMethod(str::StringPiece(begin, static_cast<int>(space - begin)));
+	if (request->method_ == HttpRequest::kInvalid) {
+		error_status_ = 501;
+		return false;
+	}
+
+	const char* target = space + 1;
+	space = static_cast<const char*>(::memchr(target, ' ', end - target));
+	if (nullptr == space || space == target) {
+		return false;
+	}
+
+	const char* version = space + 1;
+	if (end - version != 8 || 0 != ::memcmp(version, "HTTP/1.", 7)) {
+		if (end - version >= 5 && 0 == ::memcmp(version, "HTTP/", 5)) {
+			error_status_ = 505;
+		}
+		return false;
+	}
+	if (version[7] == '1') {
+		request->version_ = HttpRequest::kHttp11;
+	} else if (version[7] == '0') {
+		request->version_ = HttpRequest::kHttp10;
+	} else {
+		error_status_ = 505;
+		return false;
+	}
+
+	// 绝对形式的目标去掉协议与主机部分
+	if (*target != '/' && *target != '*') {
+		const char* scheme = static_cast<const char*>(::memmem(target, space - target, "://", 3));
+		if (nullptr == scheme) {
+			return false;
+		}
+		const char* path = static_cast<const char*>(::memchr(scheme + 3, '/', space - scheme - 3));
+		target = path ? path : space;
+	}
+	const char* query = static_cast<const char*>(::memchr(target, '?', space - target));
+	if (query) {
+		request->path_ = str::StringPiece(target, static_cast<int>(query - target));
+		request->query_ = str::StringPiece(query + 1, static_cast<int>(space - query - 1));
+	} else {
+		request->path_ = target == space ? str::StringPiece("/") : str::StringPiece(target, static_cast<int>(space - target));
+	}
+
+	error_status_ = 0;
+	return true;
+}
+
+HttpResponseParser::Result HttpResponseParser::parse(const NetBuffer& buf, bool head_request,
+													 HttpClientResponse* response) {
+	const char* begin = buf.peek();
+	size_t readable = buf.readable_bytes();
+	bool split = false;
+	if (0 == header_size_) {
+		const char* end = buf.find_CRLFCRLF();
+		if (nullptr == end) {
+			return readable > max_header_size_ ? kError : kIncomplete;
+		}
+		header_size_ = static_cast<size_t>(end + 4 - begin);
+		if (header_size_ > max_header_size_ || !ParseHeaders(begin, end + 4, response)
+			|| !DetectBody(head_request, *response)) {
+			return kError;
+		}
+		split = true;
+	}
+
+	switch (mode_) {
+	case kLength:
+		if (readable < consumed()) {
+			return kIncomplete;
+		}
+		break;
+	case kChunked: {
+		Result result = ParseChunks(buf);
+		if (result != kComplete) {
+			return result;
+		}
+		break;
+	}
+	case kUntilClose:
+		return kIncomplete;
+	default:
+		break;
+	}
+
+	if (!split) {
+		// 等待body期间缓冲区可能被搬移，重新切分头部
+		ParseHeaders(begin, begin + header_size_, response);
+	}
+	response->body_ = mode_ == kChunked
+		? str::StringPiece(decoded_)
+		: str::StringPiece(begin + header_size_, static_cast<int>(body_size_));
+	return kComplete;
+}
+
+HttpResponseParser::Result HttpResponseParser::finish(const NetBuffer& buf, HttpClientResponse* response) {
+	if (0 == header_size_) {
+		return buf.readable_bytes() > 0 ? kError : kIncomplete;
+	}
+	if (mode_ != kUntilClose) {
+		return kError;
+	}
+	body_size_ = buf.readable_bytes() - header_size_;
+	if (body_size_ > max_body_size_) {
+		return kError;
+	}
+	ParseHeaders(buf.peek(), buf.peek() + header_size_, response);
+	response->body_ = str::StringPiece(buf.peek() + header_size_, static_cast<int>(body_size_));
+	return kComplete;
+}
+
+bool HttpResponseParser::ParseHeaders(const char* begin, const char* end, HttpClientResponse* response) {
+	response->reset();
+	// 状态行："HTTP/1.x 200 OK"
+	const char* eol = str::find_crlf(begin, end);
+	if (eol - begin < 12 || 0 != ::memcmp(begin, "HTTP/1.", 7) || begin[8] != ' ') {
+		return false;
+	}
+	if (begin[7] == '1') {
+		response->version_ = HttpRequest::kHttp11;
+	} else if (begin[7] == '0') {
+		response->version_ = HttpRequest::kHttp10;
+	} else {
+		return false;
+	}
+	int status = 0;
+	for (const char* p = begin + 9; p < begin + 12; ++p) {
+		if (*p < '0' || *p > '9') {
+			return false;
+		}
+		status = status * 10 + (*p - '0');
+	}
+	response->status_ = status;
+	const char* reason = begin + 12 < eol ? begin + 13 : eol;
+	response->reason_ = str::StringPiece(reason, static_cast<int>(eol - reason));
+
+	const char* p = eol + 2;
+	while (p < end - 2) {
+		eol = str::find_crlf(p, end);
+		const char* colon = static_cast<const char*>(::memchr(p, ':', eol - p));
+		if (nullptr == colon || colon == p || response->headers_.size() >= HttpRequestParser::kMaxHeaders) {
+			return false;
+		}
+		const char* value = colon + 1;
+		const char* value_end = eol;
+		while (value < value_end && is_space(*value)) {
+			++value;
+		}
+		while (value_end > value && is_space(value_end[-1])) {
+			--value_end;
+		}
+		response->headers_.emplace_back(str::StringPiece(p, static_cast<int>(colon - p)),
+										str::StringPiece(value, static_cast<int>(value_end - value)));
+		p = eol + 2;
+	}
+	return true;
+}
+
+bool HttpResponseParser::DetectBody(bool head_request, const HttpClientResponse& response) {
+	int status = response.status();
+	body_size_ = 0;
+	if (head_request || status < 200 || status == 204 || status == 304) {
+		mode_ = kNoBody;
+		return true;
+	}
+	if (HttpHeaderHasToken(response.header("Transfer-Encoding"), "chunked")) {
+		mode_ = kChunked;
+		return true;
+	}
+	str::StringPiece length = response.header("Content-Length");
+	if (length.empty()) {
+		mode_ = kUntilClose;
+		return true;
+	}
+	mode_ = kLength;
+	return parse_length(length.data(), length.data() + length.size(), &body_size_) && body_size_ <= max_body_size_;
+}
+
+HttpResponseParser::Result HttpResponseParser::ParseChunks(const NetBuffer& buf) {
+	const char* begin = buf.peek() + header_size_;
+	const char* end = buf.peek() + buf.readable_bytes();
+	for (;;) {
+		const char* p = begin + chunk_offset_;
+		const char* eol = str::find_crlf(p, end);
+		if (nullptr == eol) {
+			return static_cast<size_t>(end - p) > kMaxChunkLine ? kError : kIncomplete;
+		}
+		size_t size = 0;
+		if (!parse_chunk_size(p, eol, &size)) {
+			return kError;
+		}
+
+		if (0 == size) {
+			// 最后一块之后是可选的trailer，以空行结束
+			const char* line = eol + 2;
+			for (;;) {
+				const char* next = str::find_crlf(line, end);
+				if (nullptr == next) {
+					return static_cast<size_t>(end - line) > max_header_size_ ? kError : kIncomplete;
+				}
+				if (next == line) {
+					body_size_ = static_cast<size_t>(next + 2 - begin);
+					return kComplete;
+				}
+				line = next + 2;
+			}
+		}
+
+		const char* data = eol + 2;
+		if (size > max_body_size_ - decoded_.size()) {
+			return kError;
+		}
+		if (static_cast<size_t>(end - data) < size + 2) {
+			return kIncomplete;
+		}
+		if (data[size] != '\r' || data[size + 1] != '\n') {
+			return kError;
+		}
+		decoded_.append(data, size);
+		chunk_offset_ = static_cast<size_t>(data + size + 2 - begin);
+	}
+}
+
+} // namespace net
+
+} // namespace brsdk
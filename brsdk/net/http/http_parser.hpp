@@ -0,0 +1,205 @@
+/**
+ * MIT License
+ *
+ * Copyright © 2021 <Jerry.Yu>.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the “Software”), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * @file http_parser.hpp
+ * @brief http请求增量解析
+ * @author Jerry.Yu (jerry.yu512@outlook.com)
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright MIT License
+ *
+ */
+#pragma once
+
+#include "brsdk/net/buffer.hpp"
+#include "http_request.hpp"
+#include "http_response.hpp"
+#include <stddef.h>
+#include <string>
+
+namespace brsdk {
+
+namespace net {
+
+/**
+ * @brief http请求增量解析器，每个连接一个
+ * @details
+ * - 查找头部结束位置使用缓冲区的续查位置，头部分多次到达时只检查新数据
+ * - 头部收齐后一次切分请求行与各头部行，结果都是指向缓冲区的视图，不拷贝
+ * - 只支持Content-Length表示的body；body未收齐时只比较长度，收齐后重新切分一次头部，
+ *   期间读事件可能搬移缓冲区数据，不能保留旧视图
+ * - 请求处理完后调用者移出 @c consumed 字节并 @c reset，继续解析流水线上的下一个请求
+ */
+class HttpRequestParser {
+public:
+	enum Result {
+		kIncomplete,	///< 数据不足
+		kComplete,		///< 请求完整
+		kError,			///< 请求非法，应答 @c error_status 后关闭连接
+	};
+
+	// 默认头部最大长度
+	static const size_t kDefaultMaxHeaderSize = 64 * 1024;
+	// 默认body最大长度
+	static const size_t kDefaultMaxBodySize = 8 * 1024 * 1024;
+	// 头部最多行数
+	static const size_t kMaxHeaders = 128;
+
+	explicit HttpRequestParser(size_t max_header_size = kDefaultMaxHeaderSize,
+							   size_t max_body_size = kDefaultMaxBodySize)
+		: max_header_size_(max_header_size),
+		  max_body_size_(max_body_size),
+		  skipped_(0),
+		  header_size_(0),
+		  body_size_(0),
+		  error_status_(0),
+		  expect_continue_(false) {}
+
+	/**
+	 * @brief 从缓冲区可读数据开头解析一个请求
+	 *
+	 * @param buf 接收缓冲区
+	 * @param request 解析结果，返回kComplete时有效
+	 * @return Result 解析状态
+	 */
+	Result parse(const NetBuffer& buf, HttpRequest* request);
+
+	// 完整请求的长度，含请求之前被忽略的空行
+	size_t consumed(void) const { return skipped_ + header_size_ + body_size_; }
+	// 解析错误对应的应答状态码
+	int error_status(void) const { return error_status_; }
+	/**
+	 * @brief 头部已收齐、正在等待body且客户端要求100-continue，
+	 *        返回true后标记清除，每个请求只返回一次
+	 */
+	bool TakeExpectContinue(void) {
+		bool expect = expect_continue_;
+		expect_continue_ = false;
+		return expect;
+	}
+
+	void reset(void) {
+		skipped_ = 0;
+		header_size_ = 0;
+		body_size_ = 0;
+		error_status_ = 0;
+		expect_continue_ = false;
+	}
+
+private:
+	// 切分请求行与头部，end指向头部末尾的空行之后
+	bool ParseHeaders(const char* begin, const char* end, HttpRequest* request);
+	bool ParseRequestLine(const char* begin, const char* end, HttpRequest* request);
+	Result fail(int status) {
+		error_status_ = status;
+		return kError;
+	}
+
+	size_t max_header_size_;	///< 头部最大长度
+	size_t max_body_size_;		///< body最大长度
+	size_t skipped_;			///< 请求之前忽略的空行字节数
+	size_t header_size_;		///< 头部长度，0表示头部未收齐
+	size_t body_size_;			///< body长度
+	int error_status_;			///< 错误状态码
+	bool expect_continue_;		///< 需要应答100 Continue
+};
+
+/**
+ * @brief http应答增量解析器，客户端每个连接一个
+ * @details
+ * - 头部的查找与切分同 @c HttpRequestParser ，结果是指向缓冲区的视图
+ * - body支持Content-Length、chunked与连接关闭界定三种方式；HEAD请求与1xx/204/304应答没有body
+ * - chunked的数据块到达后逐块解码，记录已解码位置，后续读事件不重复扫描
+ * - 应答处理完后调用者移出 @c consumed 字节并 @c reset
+ */
+class HttpResponseParser {
+public:
+	enum Result {
+		kIncomplete,	///< 数据不足
+		kComplete,		///< 应答完整
+		kError,			///< 应答非法，连接不能继续使用
+	};
+
+	// 默认body最大长度
+	static const size_t kDefaultMaxBodySize = 64 * 1024 * 1024;
+
+	explicit HttpResponseParser(size_t max_header_size = HttpRequestParser::kDefaultMaxHeaderSize,
+								size_t max_body_size = kDefaultMaxBodySize)
+		: max_header_size_(max_header_size),
+		  max_body_size_(max_body_size),
+		  header_size_(0),
+		  body_size_(0),
+		  mode_(kNoBody),
+		  chunk_offset_(0) {}
+
+	/**
+	 * @brief 从缓冲区可读数据开头解析一个应答
+	 *
+	 * @param buf 接收缓冲区
+	 * @param head_request 对应的请求是否为HEAD
+	 * @param response 解析结果，返回kComplete时有效
+	 * @return Result 解析状态
+	 */
+	Result parse(const NetBuffer& buf, bool head_request, HttpClientResponse* response);
+	/**
+	 * @brief 连接已关闭，以连接关闭界定body的应答到此完整
+	 * @return Result 没有未完成的应答返回kIncomplete，应答被截断返回kError
+	 */
+	Result finish(const NetBuffer& buf, HttpClientResponse* response);
+
+	// 完整应答的长度
+	size_t consumed(void) const { return header_size_ + body_size_; }
+
+	void reset(void) {
+		header_size_ = 0;
+		body_size_ = 0;
+		mode_ = kNoBody;
+		chunk_offset_ = 0;
+		decoded_.clear();
+	}
+
+private:
+	// body界定方式
+	enum BodyMode {
+		kNoBody,		///< 没有body
+		kLength,		///< Content-Length
+		kChunked,		///< chunked编码
+		kUntilClose,	///< 连接关闭
+	};
+
+	// 切分状态行与头部
+	bool ParseHeaders(const char* begin, const char* end, HttpClientResponse* response);
+	// 根据头部确定body界定方式
+	bool DetectBody(bool head_request, const HttpClientResponse& response);
+	// 解码新到达的数据块
+	Result ParseChunks(const NetBuffer& buf);
+
+	size_t max_header_size_;	///< 头部最大长度
+	size_t max_body_size_;		///< body最大长度
+	size_t header_size_;		///< 头部长度，0表示头部未收齐
+	size_t body_size_;			///< body在缓冲区中的长度，chunked时为编码后的长度
+	BodyMode mode_;				///< body界定方式
+	size_t chunk_offset_;		///< 已解码的chunked数据长度，相对body开头
+	std::string decoded_;		///< 解码后的chunked body
+};
+
+} // namespace net
+
+} // namespace brsdk
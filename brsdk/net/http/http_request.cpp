@@ -0,0 +1,136 @@
+/**
+ * MIT License
+ *
+ * Copyright © 2021 <Jerry.Yu>.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the “Software”), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * @file http_request.cpp
+ * @brief http请求
+ * @author Jerry.Yu (jerry.yu512@outlook.com)
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright MIT License
+ *
+ */
+#include "http_request.hpp"
+#include <ctype.h>
+#include <strings.h>
+
+namespace brsdk {
+
+namespace net {
+
+namespace {
+
+const char* const kMethodNames[HttpRequest::kMethodCount] = {
+	"INVALID", "GET", "HEAD", "POST", "PUT", "DELETE", "OPTIONS", "PATCH", "CONNECT", "TRACE",
+};
+
+bool equals_ignore_case(const str::StringPiece& a, const str::StringPiece& b) {
+	return a.size() == b.size() && 0 == ::strncasecmp(a.data(), b.data(), a.size());
+}
+
+// raw内的视图换成data中相同偏移处的视图
+str::StringPiece rebase_view(const str::StringPiece& view, const str::StringPiece& raw, const std::string& data) {
+	if (view.empty() || view.data() < raw.data() || view.data() + view.size() > raw.data() + raw.size()) {
+		return view;
+	}
+	return str::StringPiece(data.data() + (view.data() - raw.data()), view.size());
+}
+
+} // namespace
+
+str::StringPiece FindHttpHeader(const std::vector<HttpField>& headers, const str::StringPiece& name) {
+	for (const HttpField& field : headers) {
+		if (equals_ignore_case(field.first, name)) {
+			return field.second;
+		}
+	}
+	return str::StringPiece();
+}
+
+bool HttpHeaderHasToken(const str::StringPiece& value, const str::StringPiece& token) {
+	const char* p = value.data();
+	const char* end = p + value.size();
+	while (p < end) {
+		while (p < end && (*p == ' ' || *p == '\t' || *p == ',')) {
+			++p;
+		}
+		const char* start = p;
+		while (p < end && *p != ',') {
+			++p;
+		}
+		const char* stop = p;
+		while (stop > start && (stop[-1] == ' ' || stop[-1] == '\t')) {
+			--stop;
+		}
+		if (equals_ignore_case(str::StringPiece(start, static_cast<int>(stop - start)), token)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+str::StringPiece HttpRequest::param(const str::StringPiece& name) const {
+	for (const Field& field : params_) {
+		if (field.first == name) {
+			return field.second;
+		}
+	}
+	return str::StringPiece();
+}
+
+void HttpRequest::rebase(const HttpRequest& other, const str::StringPiece& raw, const std::string& data) {
+	*this = other;
+	path_ = rebase_view(path_, raw, data);
+	query_ = rebase_view(query_, raw, data);
+	body_ = rebase_view(body_, raw, data);
+	for (Field& field : headers_) {
+		field.first = rebase_view(field.first, raw, data);
+		field.second = rebase_view(field.second, raw, data);
+	}
+	for (Field& field : params_) {
+		field.first = rebase_view(field.first, raw, data);
+		field.second = rebase_view(field.second, raw, data);
+	}
+}
+
+bool HttpRequest::keep_alive(void) const {
+	str::StringPiece connection = header("Connection");
+	if (version_ == kHttp11) {
+		return !HttpHeaderHasToken(connection, "close");
+	}
+	return HttpHeaderHasToken(connection, "keep-alive");
+}
+
+const char* HttpRequest::MethodString(Method method) {
+	return method > kInvalid && method < kMethodCount ? kMethodNames[method] : kMethodNames[kInvalid];
+}
+
+HttpRequest::Method HttpRequest::ParseMethod(const str::StringPiece& name) {
+	// 方法名区分大小写
+	for (int i = kInvalid + 1; i < kMethodCount; i++) {
+		if (name == kMethodNames[i]) {
+			return static_cast<Method>(i);
+		}
+	}
+	return kInvalid;
+}
+
+} // namespace net
+
+} // namespace brsdk
@@ -0,0 +1,135 @@
+/**
+ * MIT License
+ *
+ * Copyright © 2021 <Jerry.Yu>.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the “Software”), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * @file http_request.hpp
+ * @brief http请求
+ * @author Jerry.Yu (jerry.yu512@outlook.com)
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright MIT License
+ *
+ */
+#pragma once
+
+#include "brsdk/str/string_piece.hpp"
+#include "brsdk/time/timestamp.hpp"
+#include <stddef.h>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace brsdk {
+
+namespace net {
+
+// 头部名称/值视图
+using HttpField = std::pair<str::StringPiece, str::StringPiece>;
+
+// 查找头部，名称不区分大小写，没有时返回空视图
+str::StringPiece FindHttpHeader(const std::vector<HttpField>& headers, const str::StringPiece& name);
+// 逗号分隔的头部值中是否有token，不区分大小写
+bool HttpHeaderHasToken(const str::StringPiece& value, const str::StringPiece& token);
+
+/**
+ * @brief http请求，路径、头部与body都是指向接收缓冲区的视图
+ * @details 视图只在请求处理回调期间有效，需要保留时自行拷贝
+ */
+class HttpRequest {
+public:
+	enum Method {
+		kInvalid,
+		kGet,
+		kHead,
+		kPost,
+		kPut,
+		kDelete,
+		kOptions,
+		kPatch,
+		kConnect,
+		kTrace,
+		kMethodCount,
+	};
+
+	enum Version {
+		kUnknown,
+		kHttp10,
+		kHttp11,
+	};
+
+	using Field = HttpField;
+
+	HttpRequest() : method_(kInvalid), version_(kUnknown) {}
+
+	Method method(void) const { return method_; }
+	const char* method_string(void) const { return MethodString(method_); }
+	Version version(void) const { return version_; }
+	// 不含查询串的路径，未解码
+	const str::StringPiece& path(void) const { return path_; }
+	// '?'之后的查询串，未解码
+	const str::StringPiece& query(void) const { return query_; }
+	const str::StringPiece& body(void) const { return body_; }
+	const std::vector<Field>& headers(void) const { return headers_; }
+	Timestamp receive_time(void) const { return receive_time_; }
+
+	// 查找头部，名称不区分大小写，没有时返回空视图
+	str::StringPiece header(const str::StringPiece& name) const { return FindHttpHeader(headers_, name); }
+	// 路由匹配到的路径参数，没有时返回空视图
+	str::StringPiece param(const str::StringPiece& name) const;
+	// 是否保持连接，HTTP/1.1默认保持，HTTP/1.0需要显式的keep-alive
+	bool keep_alive(void) const;
+
+	// 方法名，非法方法返回"INVALID"
+	static const char* MethodString(Method method);
+	// 解析方法名
+	static Method ParseMethod(const str::StringPiece& name);
+
+	// 清空内容，保留容器容量供下一个请求复用
+	void reset(void) {
+		method_ = kInvalid;
+		version_ = kUnknown;
+		path_.clear();
+		query_.clear();
+		body_.clear();
+		headers_.clear();
+		params_.clear();
+	}
+
+private:
+	friend class HttpRequestParser;
+	friend class HttpRouter;
+	friend class HttpServer;
+	friend class HttpResponseWriter;
+
+	// 拷贝other，指向接收数据raw内的视图改为指向其副本data
+	void rebase(const HttpRequest& other, const str::StringPiece& raw, const std::string& data);
+
+	Method method_;				///< 方法
+	Version version_;			///< 版本
+	str::StringPiece path_;		///< 路径
+	str::StringPiece query_;	///< 查询串
+	str::StringPiece body_;		///< body
+	std::vector<Field> headers_;	///< 头部
+	std::vector<Field> params_;		///< 路径参数
+	Timestamp receive_time_;	///< 接收时间
+};
+
+} // namespace net
+
+} // namespace brsdk
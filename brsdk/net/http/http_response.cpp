@@ -0,0 +1,305 @@
+/**
+ * MIT License
+ *
+ * Copyright © 2021 <Jerry.Yu>.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the “Software”), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * @file http_response.cpp
+ * @brief http应答
+ * @author Jerry.Yu (jerry.yu512@outlook.com)
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright MIT License
+ *
+ */
+#include "http_response.hpp"
+#include <stdio.h>
+#include <time.h>
+#include "brsdk/net/event/connection.hpp"
+#include "brsdk/net/event/event_loop.hpp"
+
+namespace brsdk {
+
+namespace net {
+
+namespace {
+
+// Date头部每秒格式化一次，每个loop线程一份
+const std::string& http_date(void) {
+	static thread_local time_t t_second = 0;
+	static thread_local std::string t_date;
+	time_t now = ::time(nullptr);
+	if (now != t_second) {
+		struct tm tm_time;
+		::gmtime_r(&now, &tm_time);
+		char buf[64];
+		size_t n = ::strftime(buf, sizeof(buf), "Date: %a, %d %b %Y %H:%M:%S GMT\r\n", &tm_time);
+		t_date.assign(buf, n);
+		t_second = now;
+	}
+	return t_date;
+}
+
+void append_number(std::string* out, size_t n) {
+	char buf[32];
+	int len = ::snprintf(buf, sizeof(buf), "%zu", n);
+	out->append(buf, len);
+}
+
+// chunked编码一块
+void append_chunk(std::string* out, const str::StringPiece& data) {
+	char size[32];
+	int len = ::snprintf(size, sizeof(size), "%x\r\n", static_cast<unsigned>(data.size()));
+	out->append(size, len);
+	out->append(data.data(), data.size());
+	out->append("\r\n", 2);
+}
+
+} // namespace
+
+void HttpResponse::AddHeader(const str::StringPiece& name, const str::StringPiece& value) {
+	headers_.append(name.data(), name.size());
+	headers_.append(": ", 2);
+	headers_.append(value.data(), value.size());
+	headers_.append("\r\n", 2);
+}
+
+void HttpResponse::AppendChunk(const str::StringPiece& data) {
+	if (version_ == HttpRequest::kHttp10) {
+		// HTTP/1.0客户端不能解码chunked，整体按Content-Length发送
+		AppendBody(data);
+		return;
+	}
+	chunked_ = true;
+	if (data.empty()) {
+		// 空块表示结束，只在序列化时追加
+		return;
+	}
+	append_chunk(&body_, data);
+}
+
+void HttpResponse::AppendHead(std::string* out, bool stream) const {
+	const char* reason = reason_ ? reason_ : ReasonPhrase(status_);
+	char line[64];
+	int len = ::snprintf(line, sizeof(line), "HTTP/1.%d %d ", version_ == HttpRequest::kHttp10 ? 0 : 1, status_);
+	out->append(line, len);
+	out->append(reason);
+	out->append("\r\n", 2);
+	out->append(http_date());
+	// HTTP/1.0流式发送没有长度，body以关闭连接结束
+	if (!no_body()) {
+		if (chunked_ || (stream && version_ != HttpRequest::kHttp10)) {
+			out->append("Transfer-Encoding: chunked\r\n");
+		} else if (!stream) {
+			out->append("Content-Length: ");
+			append_number(out, body_.size());
+			out->append("\r\n", 2);
+		}
+	}
+	if (close_) {
+		out->append("Connection: close\r\n");
+	} else if (version_ == HttpRequest::kHttp10) {
+		// HTTP/1.0默认关闭，保持连接需要显式应答
+		out->append("Connection: keep-alive\r\n");
+	}
+	out->append(headers_);
+	out->append("\r\n", 2);
+}
+
+void HttpResponse::AppendToBuffer(std::string* out) const {
+	AppendHead(out, false);
+	if (head_ || no_body()) {
+		return;
+	}
+	out->append(body_);
+	if (chunked_) {
+		out->append("0\r\n\r\n", 5);
+	}
+}
+
+HttpResponseWriterPtr HttpResponse::defer(void) {
+	if (!writer_ && conn_) {
+		writer_.reset(new HttpResponseWriter(*conn_, *this));
+	}
+	return writer_;
+}
+
+HttpResponseWriter::HttpResponseWriter(const TcpConnectionPtr& conn, const HttpResponse& response)
+	: loop_(conn->GetLoop()),
+	  conn_(conn),
+	  response_(response),
+	  started_(false),
+	  headers_sent_(false),
+	  finished_(false) {
+	// 副本不再关联连接，避免与writer互相持有
+	response_.conn_ = nullptr;
+	response_.writer_.reset();
+	response_.request_ = nullptr;
+	response_.raw_request_.clear();
+	// 接收缓冲区在处理函数返回后复用，拷贝请求供延迟处理使用
+	if (response.request_) {
+		request_data_.assign(response.raw_request_.data(), response.raw_request_.size());
+		request_.rebase(*response.request_, response.raw_request_, request_data_);
+	}
+}
+
+void HttpResponseWriter::write(const str::StringPiece& data) {
+	if (data.empty()) {
+		return;
+	}
+	if (loop_->IsInLoopThread()) {
+		WriteInLoop(data, false);
+	} else {
+		loop_->RunInLoop(std::bind(&HttpResponseWriter::WriteCopyInLoop, shared_from_this(), data.as_string(), false));
+	}
+}
+
+void HttpResponseWriter::end(const str::StringPiece& data) {
+	if (loop_->IsInLoopThread()) {
+		WriteInLoop(data, true);
+	} else {
+		loop_->RunInLoop(std::bind(&HttpResponseWriter::WriteCopyInLoop, shared_from_this(), data.as_string(), true));
+	}
+}
+
+void HttpResponseWriter::WriteCopyInLoop(const std::string& data, bool finish) {
+	WriteInLoop(str::StringPiece(data), finish);
+}
+
+void HttpResponseWriter::WriteInLoop(const str::StringPiece& data, bool finish) {
+	loop_->AssertInLoopThread();
+	if (finished_) {
+		return;
+	}
+
+	std::string out;
+	if (!headers_sent_) {
+		headers_sent_ = true;
+		if (finish) {
+			// 没有流式写出，按Content-Length一次发送
+			finished_ = true;
+			if (response_.chunked_) {
+				response_.AppendChunk(data);
+			} else {
+				response_.AppendBody(data);
+			}
+			response_.AppendToBuffer(&out);
+			emit(out);
+			return;
+		}
+		if (response_.version_ == HttpRequest::kHttp10) {
+			response_.close_ = true;
+		}
+		response_.AppendHead(&out, true);
+		// 处理函数在defer之前设置的body先发出
+		if (!response_.head_ && !response_.no_body() && !response_.body_.empty()) {
+			if (response_.version_ == HttpRequest::kHttp10 || response_.chunked_) {
+				out.append(response_.body_);
+			} else {
+				append_chunk(&out, response_.body_);
+			}
+		}
+		std::string().swap(response_.body_);
+	}
+
+	bool chunked = response_.version_ != HttpRequest::kHttp10;
+	if (!response_.head_ && !response_.no_body()) {
+		if (!chunked) {
+			out.append(data.data(), data.size());
+		} else if (!data.empty()) {
+			append_chunk(&out, data);
+		}
+		if (chunked && finish) {
+			out.append("0\r\n\r\n", 5);
+		}
+	}
+	finished_ = finish;
+	emit(out);
+}
+
+void HttpResponseWriter::start(const DoneCallback& cb) {
+	loop_->AssertInLoopThread();
+	started_ = true;
+	doneCallback_ = cb;
+	std::string out;
+	out.swap(pending_);
+	emit(out);
+}
+
+void HttpResponseWriter::emit(const std::string& out) {
+	if (!started_) {
+		pending_.append(out);
+		return;
+	}
+	TcpConnectionPtr conn = conn_.lock();
+	if (conn && !out.empty()) {
+		conn->send(out);
+	}
+	if (finished_ && doneCallback_) {
+		DoneCallback cb;
+		cb.swap(doneCallback_);
+		cb(!response_.close_);
+	}
+}
+
+bool HttpClientResponse::keep_alive(void) const {
+	str::StringPiece connection = header("Connection");
+	if (version_ == HttpRequest::kHttp11) {
+		return !HttpHeaderHasToken(connection, "close");
+	}
+	return HttpHeaderHasToken(connection, "keep-alive");
+}
+
+const char* HttpResponse::ReasonPhrase(int status) {
+	switch (status) {
+	case 100: return "Continue";
+	case 101: return "Switching Protocols";
+	case 200: return "OK";
+	case 201: return "Created";
+	case 202: return "Accepted";
+	case 204: return "No Content";
+	case 206: return "Partial Content";
+	case 301: return "Moved Permanently";
+	case 302: return "Found";
+	case 304: return "Not Modified";
+	case 307: return "Temporary Redirect";
+	case 308: return "Permanent Redirect";
+	case 400: return "Bad Request";
+	case 401: return "Unauthorized";
+	case 403: return "Forbidden";
+	case 404: return "Not Found";
+	case 405: return "Method Not Allowed";
+	case 408: return "Request Timeout";
+	case 411: return "Length Required";
+	case 413: return "Payload Too Large";
+	case 414: return "URI Too Long";
+	case 415: return "Unsupported Media Type";
+	case 429: return "Too Many Requests";
+	case 431: return "Request Header Fields Too Large";
+	case 500: return "Internal Server Error";
+	case 501: return "Not Implemented";
+	case 502: return "Bad Gateway";
+	case 503: return "Service Unavailable";
+	case 504: return "Gateway Timeout";
+	case 505: return "HTTP Version Not Supported";
+	default: return "Unknown";
+	}
+}
+
+} // namespace net
+
+} // namespace brsdk
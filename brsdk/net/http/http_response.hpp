@@ -0,0 +1,230 @@
+/**
+ * MIT License
+ *
+ * Copyright © 2021 <Jerry.Yu>.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the “Software”), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * @file http_response.hpp
+ * @brief http应答
+ * @author Jerry.Yu (jerry.yu512@outlook.com)
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright MIT License
+ *
+ */
+#pragma once
+
+#include "brsdk/mix/noncopyable.hpp"
+#include "brsdk/str/string_piece.hpp"
+#include "brsdk/net/event/event_typedef.hpp"
+#include "http_request.hpp"
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace brsdk {
+
+namespace net {
+
+class EventLoop;
+class HttpResponseWriter;
+using HttpResponseWriterPtr = std::shared_ptr<HttpResponseWriter>;
+
+/**
+ * @brief http应答
+ * @details
+ * - 头部直接拼接为文本，序列化时不再逐个格式化
+ * - 默认按Content-Length发送body；调用 @c AppendChunk 后改为chunked编码，每块在追加时即完成编码
+ * - 状态行使用请求的版本；HTTP/1.0不支持chunked，@c AppendChunk 退化为追加body，
+ *   保持连接时显式应答"Connection: keep-alive"
+ * - HEAD请求只发送头部，Content-Length仍为body长度
+ * - 处理函数内调用 @c defer 转为延迟应答，之后由返回的writer流式写出或稍后完成
+ */
+class HttpResponse {
+public:
+	/**
+	 * @brief 构造
+	 *
+	 * @param close 发送后关闭连接
+	 * @param version 请求的版本，决定状态行版本与body的分帧方式
+	 */
+	explicit HttpResponse(bool close, HttpRequest::Version version = HttpRequest::kHttp11)
+		: status_(200), reason_(nullptr), version_(version), close_(close), chunked_(false), head_(false),
+		  conn_(nullptr), request_(nullptr) {}
+
+	/**
+	 * @brief 设置状态码
+	 *
+	 * @param status 状态码
+	 * @param reason 原因短语，为空时使用标准短语，必须是常量字符串
+	 */
+	void set_status(int status, const char* reason = nullptr) {
+		status_ = status;
+		reason_ = reason;
+	}
+	int status(void) const { return status_; }
+	HttpRequest::Version version(void) const { return version_; }
+
+	void set_close_connection(bool on) { close_ = on; }
+	bool close_connection(void) const { return close_; }
+	// 只发送头部
+	void set_head_only(bool on) { head_ = on; }
+
+	void AddHeader(const str::StringPiece& name, const str::StringPiece& value);
+	void set_content_type(const str::StringPiece& type) { AddHeader("Content-Type", type); }
+
+	// 设置body，接管内容
+	void set_body(std::string&& body) { body_ = std::move(body); }
+	void set_body(const str::StringPiece& body) { body_.assign(body.data(), body.size()); }
+	void AppendBody(const str::StringPiece& data) { body_.append(data.data(), data.size()); }
+	const std::string& body(void) const { return body_; }
+
+	// 追加一个chunk，应答改为chunked编码，空数据忽略；HTTP/1.0时直接追加到body
+	void AppendChunk(const str::StringPiece& data);
+	bool chunked(void) const { return chunked_; }
+
+	// 序列化追加到out
+	void AppendToBuffer(std::string* out) const;
+
+	/**
+	 * @brief 转为延迟应答，只能在请求处理函数内调用
+	 * @details 处理函数返回后不再发送本应答，已设置的状态、头部与body转交给writer；
+	 *          该应答完成前同一连接上的后续请求暂不处理，保证应答顺序。
+	 *
+	 *          注意：处理函数参数中的HttpRequest指向接收缓冲区，处理函数返回后立即失效，
+	 *          延迟处理时不能捕获或保存它，必须使用 @c HttpResponseWriter::request 中的拷贝
+	 *
+	 * @return HttpResponseWriterPtr 应答writer，多次调用返回同一个，不在处理函数内时为空
+	 */
+	HttpResponseWriterPtr defer(void);
+
+	// 标准原因短语
+	static const char* ReasonPhrase(int status);
+
+private:
+	friend class HttpServer;
+	friend class HttpResponseWriter;
+
+	// 序列化状态行与头部，stream为true时body长度未知
+	void AppendHead(std::string* out, bool stream) const;
+	// 1xx/204/304没有body
+	bool no_body(void) const { return status_ < 200 || status_ == 204 || status_ == 304; }
+
+	int status_;			///< 状态码
+	const char* reason_;	///< 原因短语
+	HttpRequest::Version version_;	///< 应答版本
+	bool close_;			///< 发送后关闭连接
+	bool chunked_;			///< chunked编码
+	bool head_;				///< 只发送头部
+	std::string headers_;	///< 已拼接的头部
+	std::string body_;		///< body，chunked时为已编码的数据块
+	const TcpConnectionPtr* conn_;	///< 处理函数执行期间所在的连接
+	const HttpRequest* request_;	///< 处理函数执行期间的请求
+	str::StringPiece raw_request_;	///< 请求在接收缓冲区中的原始数据
+	HttpResponseWriterPtr writer_;	///< 延迟应答writer
+};
+
+/**
+ * @brief 延迟应答writer，由 @c HttpResponse::defer 创建
+ * @details
+ * - write/end可以在任意线程调用，数据拷贝后转到连接所属loop发送
+ * - 第一次write时发送头部，之后HTTP/1.1以chunked编码逐块发送，HTTP/1.0没有长度，以关闭连接结束body
+ * - 没有write直接end时按Content-Length一次发送完整应答
+ * - 连接断开后的写入被丢弃；必须调用end，否则该连接上的后续请求不会处理
+ */
+class HttpResponseWriter : noncopyable, public std::enable_shared_from_this<HttpResponseWriter> {
+public:
+	// 应答状态与头部，只在第一次write/end之前修改
+	HttpResponse* response(void) { return &response_; }
+	// 请求的拷贝，视图指向writer持有的数据，writer存活期间一直有效
+	const HttpRequest& request(void) const { return request_; }
+	EventLoop* GetLoop(void) const { return loop_; }
+
+	// 写出一段body，空数据忽略
+	void write(const str::StringPiece& data);
+	// 写出最后一段body并结束应答，结束后的写入被忽略
+	void end(const str::StringPiece& data = str::StringPiece());
+
+private:
+	friend class HttpResponse;
+	friend class HttpServer;
+
+	// 应答结束回调，参数为连接是否可以继续使用
+	using DoneCallback = std::function<void(bool keep_alive)>;
+
+	HttpResponseWriter(const TcpConnectionPtr& conn, const HttpResponse& response);
+
+	void WriteInLoop(const str::StringPiece& data, bool finish);
+	void WriteCopyInLoop(const std::string& data, bool finish);
+	// 之前的应答发送完毕后由服务器调用，开始发送
+	void start(const DoneCallback& cb);
+	// 发送或者暂存输出，结束时回调
+	void emit(const std::string& out);
+
+	EventLoop* loop_;						///< 连接所属loop
+	std::weak_ptr<TcpConnection> conn_;		///< 连接
+	HttpResponse response_;					///< 状态与头部
+	std::string request_data_;				///< 请求原始数据的拷贝
+	HttpRequest request_;					///< 指向request_data_的请求
+	std::string pending_;					///< 开始发送前的输出
+	DoneCallback doneCallback_;				///< 结束回调
+	bool started_;							///< 已开始发送
+	bool headers_sent_;						///< 头部已输出
+	bool finished_;							///< 已结束
+};
+
+/**
+ * @brief 客户端收到的http应答，原因短语、头部与body都是指向接收缓冲区的视图
+ * @details 视图只在应答回调期间有效；chunked编码的body解码到解析器内部，同样只在回调期间有效
+ */
+class HttpClientResponse {
+public:
+	HttpClientResponse() : status_(0), version_(HttpRequest::kUnknown) {}
+
+	int status(void) const { return status_; }
+	HttpRequest::Version version(void) const { return version_; }
+	const str::StringPiece& reason(void) const { return reason_; }
+	const std::vector<HttpField>& headers(void) const { return headers_; }
+	const str::StringPiece& body(void) const { return body_; }
+
+	// 查找头部，名称不区分大小写，没有时返回空视图
+	str::StringPiece header(const str::StringPiece& name) const { return FindHttpHeader(headers_, name); }
+	// 应答之后连接是否可以继续使用
+	bool keep_alive(void) const;
+
+	void reset(void) {
+		status_ = 0;
+		version_ = HttpRequest::kUnknown;
+		reason_.clear();
+		headers_.clear();
+		body_.clear();
+	}
+
+private:
+	friend class HttpResponseParser;
+
+	int status_;					///< 状态码
+	HttpRequest::Version version_;	///< 版本
+	str::StringPiece reason_;		///< 原因短语
+	std::vector<HttpField> headers_;	///< 头部
+	str::StringPiece body_;			///< body
+};
+
+} // namespace net
+
+} // namespace brsdk
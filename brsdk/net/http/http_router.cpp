@@ -0,0 +1,209 @@
+/**
+ * MIT License
+ *
+ * Copyright © 2021 <Jerry.Yu>.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the “Software”), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * @file http_router.cpp
+ * @brief http请求路由
+ * @author Jerry.Yu (jerry.yu512@outlook.com)
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright MIT License
+ *
+ */
+#include "http_router.hpp"
+#include <assert.h>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace brsdk {
+
+namespace net {
+
+namespace {
+
+// 取出下一段，跳过开头的'/'，返回false表示路径已结束
+bool next_segment(const char** pos, const char* end, str::StringPiece* segment) {
+	const char* p = *pos;
+	if (p < end && *p == '/') {
+		++p;
+	}
+	if (p >= end) {
+		*pos = end;
+		return false;
+	}
+	const char* start = p;
+	while (p < end && *p != '/') {
+		++p;
+	}
+	*segment = str::StringPiece(start, static_cast<int>(p - start));
+	*pos = p;
+	return true;
+}
+
+} // namespace
+
+struct HttpRouter::Node {
+	std::vector<std::pair<std::string, std::unique_ptr<Node>>> children;	///< 普通段
+	std::unique_ptr<Node> param;		///< 参数段
+	std::string param_name;				///< 参数名
+	std::unique_ptr<Node> wildcard;		///< 通配段，只能是叶子
+	std::string wildcard_name;			///< 通配参数名
+	HttpHandler handlers[HttpRequest::kMethodCount];	///< 各方法的处理函数
+
+	bool empty(void) const {
+		for (const HttpHandler& handler : handlers) {
+			if (handler) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	// 方法对应的处理函数，HEAD没有注册时使用GET
+	const HttpHandler* handler(HttpRequest::Method method) const {
+		if (handlers[method]) {
+			return &handlers[method];
+		}
+		if (method == HttpRequest::kHead && handlers[HttpRequest::kGet]) {
+			return &handlers[HttpRequest::kGet];
+		}
+		return nullptr;
+	}
+
+	/**
+	 * @brief 逐段匹配路径与方法，失败时弹出本分支写入的参数并回退
+	 * @details 路径匹配但方法未注册时不立即失败，继续尝试参数段与通配段，只记录路径存在
+	 */
+	const HttpHandler* match(const char* pos, const char* end, HttpRequest::Method method,
+							 std::vector<HttpRequest::Field>* params, bool* path_found) const {
+		str::StringPiece segment;
+		const char* next = pos;
+		if (!next_segment(&next, end, &segment)) {
+			if (!empty()) {
+				*path_found = true;
+				const HttpHandler* found = handler(method);
+				if (found) {
+					return found;
+				}
+			}
+			// 通配段可以匹配空的剩余路径
+			return match_wildcard(pos, end, method, params, path_found);
+		}
+
+		for (const auto& child : children) {
+			if (segment == child.first) {
+				const HttpHandler* found = child.second->match(next, end, method, params, path_found);
+				if (found) {
+					return found;
+				}
+				break;
+			}
+		}
+
+		size_t mark = params->size();
+		if (param) {
+			params->emplace_back(param_name, segment);
+			const HttpHandler* found = param->match(next, end, method, params, path_found);
+			if (found) {
+				return found;
+			}
+			params->resize(mark);
+		}
+
+		return match_wildcard(pos, end, method, params, path_found);
+	}
+
+	const HttpHandler* match_wildcard(const char* pos, const char* end, HttpRequest::Method method,
+									  std::vector<HttpRequest::Field>* params, bool* path_found) const {
+		if (!wildcard || wildcard->empty()) {
+			return nullptr;
+		}
+		*path_found = true;
+		const HttpHandler* found = wildcard->handler(method);
+		if (found) {
+			const char* rest = (pos < end && *pos == '/') ? pos + 1 : pos;
+			params->emplace_back(wildcard_name, str::StringPiece(rest, static_cast<int>(end - rest)));
+		}
+		return found;
+	}
+};
+
+HttpRouter::HttpRouter() : root_(new Node) {
+}
+
+HttpRouter::~HttpRouter() = default;
+
+void HttpRouter::add(HttpRequest::Method method, const str::StringPiece& pattern, const HttpHandler& handler) {
+	assert(method > HttpRequest::kInvalid && method < HttpRequest::kMethodCount);
+	Node* node = root_.get();
+	const char* pos = pattern.data();
+	const char* end = pos + pattern.size();
+	str::StringPiece segment;
+	while (next_segment(&pos, end, &segment)) {
+		if (segment[0] == ':') {
+			std::string name(segment.data() + 1, segment.size() - 1);
+			if (!node->param) {
+				node->param.reset(new Node);
+				node->param_name = name;
+			}
+			// 同一位置的参数段只能有一个名字
+			assert(node->param_name == name);
+			node = node->param.get();
+		} else if (segment[0] == '*') {
+			// 通配段必须在末尾
+			assert(pos == end);
+			if (!node->wildcard) {
+				node->wildcard.reset(new Node);
+				node->wildcard_name.assign(segment.data() + 1, segment.size() - 1);
+			}
+			node = node->wildcard.get();
+		} else {
+			Node* child = nullptr;
+			for (auto& item : node->children) {
+				if (segment == item.first) {
+					child = item.second.get();
+					break;
+				}
+			}
+			if (nullptr == child) {
+				child = new Node;
+				node->children.emplace_back(segment.as_string(), std::unique_ptr<Node>(child));
+			}
+			node = child;
+		}
+	}
+	node->handlers[method] = handler;
+}
+
+const HttpHandler* HttpRouter::match(HttpRequest* request, int* status) const {
+	const char* pos = request->path_.data();
+	const char* end = pos + request->path_.size();
+	request->params_.clear();
+	bool path_found = false;
+	const HttpHandler* handler = root_->match(pos, end, request->method_, &request->params_, &path_found);
+	if (nullptr == handler) {
+		*status = path_found ? 405 : 404;
+	}
+	return handler;
+}
+
+} // namespace net
+
+} // namespace brsdk
@@ -0,0 +1,84 @@
+/**
+ * MIT License
+ *
+ * Copyright © 2021 <Jerry.Yu>.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the “Software”), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * @file http_router.hpp
+ * @brief http路由
+ * @author Jerry.Yu (jerry.yu512@outlook.com)
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright MIT License
+ *
+ */
+#pragma once
+
+#include "brsdk/mix/noncopyable.hpp"
+#include "brsdk/str/string_piece.hpp"
+#include "http_request.hpp"
+#include "http_response.hpp"
+#include <functional>
+#include <memory>
+
+namespace brsdk {
+
+namespace net {
+
+// 请求处理函数，在连接所属loop线程调用
+using HttpHandler = std::function<void(const HttpRequest&, HttpResponse*)>;
+
+/**
+ * @brief 按路径分段的前缀树路由
+ * @details
+ * - 模式按'/'分段：普通段精确匹配；":name"匹配任意一段；"*name"只能在末尾，匹配剩余路径(可含'/')
+ * - 优先级：普通段 > 参数段 > 通配段，前者路径或方法匹配失败时回退尝试后者；通配段可以匹配空的剩余路径
+ * - 匹配时逐段比较视图，不分配内存；参数以视图形式写入请求
+ * - HEAD请求没有注册处理函数时使用GET的处理函数
+ * - 必须在服务器启动前注册完毕，之后多个loop并发只读
+ */
+class HttpRouter : noncopyable {
+public:
+	HttpRouter();
+	~HttpRouter();
+
+	void add(HttpRequest::Method method, const str::StringPiece& pattern, const HttpHandler& handler);
+	void get(const str::StringPiece& pattern, const HttpHandler& handler) {
+		add(HttpRequest::kGet, pattern, handler);
+	}
+	void post(const str::StringPiece& pattern, const HttpHandler& handler) {
+		add(HttpRequest::kPost, pattern, handler);
+	}
+
+	/**
+	 * @brief 匹配请求
+	 *
+	 * @param request 请求，匹配成功时写入路径参数
+	 * @param status 匹配失败时的状态码，路径存在但方法未注册为405，否则为404
+	 * @return const HttpHandler* 处理函数，失败返回nullptr
+	 */
+	const HttpHandler* match(HttpRequest* request, int* status) const;
+
+private:
+	struct Node;
+
+	std::unique_ptr<Node> root_;	///< 根节点
+};
+
+} // namespace net
+
+} // namespace brsdk
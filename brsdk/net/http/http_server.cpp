@@ -0,0 +1,212 @@
+/**
+ * MIT License
+ *
+ * Copyright © 2021 <Jerry.Yu>.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the “Software”), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * @file http_server.cpp
+ * @brief HTTP/1.1服务器
+ * @author Jerry.Yu (jerry.yu512@outlook.com)
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright MIT License
+ *
+ */
+#include "http_server.hpp"
+#include "brsdk/net/event/connection.hpp"
+#include "brsdk/net/event/event_loop.hpp"
+#include "http_log.hpp"
+
+namespace brsdk {
+
+namespace net {
+
+using namespace std::placeholders;
+
+namespace {
+
+const char kContinue[] = "HTTP/1.1 100 Continue\r\n\r\n";
+
+// 连接状态，保存在连接的context中
+struct HttpSession {
+	HttpSession(size_t max_header_size, size_t max_body_size)
+		: parser(max_header_size, max_body_size), throttled(false) {}
+
+	HttpRequestParser parser;		///< 请求解析器
+	HttpResponseWriterPtr writer;	///< 未完成的延迟应答
+	bool throttled;					///< 等待延迟应答期间积压过多，已暂停读取
+};
+
+} // namespace
+
+HttpServer::HttpServer(EventLoop* loop, const Address& listen_addr, const std::string& name,
+					   TcpServer::Option option)
+	: server_(loop, listen_addr, name, option),
+	  max_header_size_(HttpRequestParser::kDefaultMaxHeaderSize),
+	  max_body_size_(HttpRequestParser::kDefaultMaxBodySize) {
+	server_.SetConnectionCallback(std::bind(&HttpServer::OnConnection, this, _1));
+	server_.SetMessageCallback(std::bind(&HttpServer::OnMessage, this, _1, _2, _3));
+}
+
+void HttpServer::start(void) {
+	server_.start();
+}
+
+void HttpServer::OnConnection(const TcpConnectionPtr& conn) {
+	if (conn->connected()) {
+		conn->set_context(HttpSession(max_header_size_, max_body_size_));
+	}
+}
+
+void HttpServer::OnMessage(const TcpConnectionPtr& conn, NetBuffer* buf, Timestamp receive_time) {
+	Any* context = conn->context();
+	if (!context->Is<HttpSession>()) {
+		// 已经决定关闭的连接，丢弃后续数据
+		buf->retrieve_all();
+		return;
+	}
+	HttpSession* session = &context->AnyCast<HttpSession>();
+	if (session->writer) {
+		// 延迟应答未完成，后续请求留在缓冲区；积压过多时暂停读取
+		if (!session->throttled && buf->readable_bytes() > max_header_size_ + max_body_size_) {
+			session->throttled = true;
+			conn->ThrottleRead(true);
+		}
+		return;
+	}
+	HttpRequestParser* parser = &session->parser;
+
+	// 请求与应答缓冲区每个loop线程一份，复用容量
+	static thread_local HttpRequest t_request;
+	static thread_local std::string t_output;
+	std::string* out = &t_output;
+	out->clear();
+
+	HttpRequestParser::Result result;
+	while ((result = parser->parse(*buf, &t_request)) == HttpRequestParser::kComplete) {
+		t_request.receive_time_ = receive_time;
+		HttpResponseWriterPtr writer;
+		str::StringPiece raw(buf->peek(), static_cast<int>(parser->consumed()));
+		bool keep_alive = OnRequest(conn, &t_request, raw, out, &writer);
+		buf->retrieve(parser->consumed());
+		parser->reset();
+		if (writer) {
+			// 之前的应答先发出，延迟应答完成后再处理后续请求
+			if (!out->empty()) {
+				conn->send(*out);
+			}
+			session->writer = writer;
+			writer->start(std::bind(&HttpServer::OnDeferredDone, this, std::weak_ptr<TcpConnection>(conn), _1));
+			return;
+		}
+		if (!keep_alive) {
+			conn->send(*out);
+			conn->shutdown();
+			conn->set_context(Any());
+			return;
+		}
+	}
+
+	if (result == HttpRequestParser::kError) {
+		LOG_DEBUG << "HttpServer [" << conn->name() << "] - bad request, status " << parser->error_status();
+		SendError(conn, parser->error_status(), out);
+		return;
+	}
+
+	if (parser->TakeExpectContinue()) {
+		out->append(kContinue, sizeof(kContinue) - 1);
+	}
+	// 流水线上的多个应答一次发送
+	if (!out->empty()) {
+		conn->send(*out);
+	}
+}
+
+void HttpServer::OnDeferredDone(const std::weak_ptr<TcpConnection>& weak_conn, bool keep_alive) {
+	TcpConnectionPtr conn = weak_conn.lock();
+	if (conn) {
+		// 可能在处理函数内同步结束，回到loop后再继续处理后续请求
+		conn->GetLoop()->QueueInLoop(std::bind(&HttpServer::ResumeInLoop, this, weak_conn, keep_alive));
+	}
+}
+
+void HttpServer::ResumeInLoop(const std::weak_ptr<TcpConnection>& weak_conn, bool keep_alive) {
+	TcpConnectionPtr conn = weak_conn.lock();
+	if (!conn || !conn->connected() || !conn->context()->Is<HttpSession>()) {
+		return;
+	}
+	HttpSession* session = &conn->context()->AnyCast<HttpSession>();
+	session->writer.reset();
+	if (session->throttled) {
+		session->throttled = false;
+		conn->ThrottleRead(false);
+	}
+	if (!keep_alive) {
+		conn->shutdown();
+		conn->set_context(Any());
+		return;
+	}
+	// 处理等待期间积压的流水线请求
+	if (conn->input_buffer()->readable_bytes() > 0) {
+		OnMessage(conn, conn->input_buffer(), Timestamp::now());
+	}
+}
+
+bool HttpServer::OnRequest(const TcpConnectionPtr& conn, HttpRequest* request, const str::StringPiece& raw,
+						   std::string* out, HttpResponseWriterPtr* writer) {
+	HttpResponse response(!request->keep_alive(), request->version());
+	response.conn_ = &conn;
+	response.request_ = request;
+	response.raw_request_ = raw;
+	if (request->method() == HttpRequest::kHead) {
+		response.set_head_only(true);
+	}
+
+	int status = 404;
+	const HttpHandler* handler = router_.match(request, &status);
+	if (nullptr == handler && default_handler_) {
+		handler = &default_handler_;
+	}
+	if (handler) {
+		(*handler)(*request, &response);
+	} else {
+		response.set_status(status);
+		response.set_body(str::StringPiece(HttpResponse::ReasonPhrase(status)));
+	}
+
+	if (response.writer_) {
+		// 延迟应答，由writer发送
+		writer->swap(response.writer_);
+		return true;
+	}
+	response.AppendToBuffer(out);
+	return !response.close_connection();
+}
+
+void HttpServer::SendError(const TcpConnectionPtr& conn, int status, std::string* out) {
+	HttpResponse response(true);
+	response.set_status(status);
+	response.set_body(str::StringPiece(HttpResponse::ReasonPhrase(status)));
+	response.AppendToBuffer(out);
+	conn->send(*out);
+	conn->shutdown();
+	conn->set_context(Any());
+}
+
+} // namespace net
+
+} // namespace brsdk
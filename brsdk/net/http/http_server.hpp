@@ -0,0 +1,96 @@
+/**
+ * MIT License
+ *
+ * Copyright © 2021 <Jerry.Yu>.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the “Software”), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * @file http_server.hpp
+ * @brief 事件循环http服务器
+ * @author Jerry.Yu (jerry.yu512@outlook.com)
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright MIT License
+ *
+ */
+#pragma once
+
+#include "brsdk/mix/noncopyable.hpp"
+#include "brsdk/net/event/tcp_server.hpp"
+#include "http_parser.hpp"
+#include "http_request.hpp"
+#include "http_response.hpp"
+#include "http_router.hpp"
+
+namespace brsdk {
+
+namespace net {
+
+/**
+ * @brief 基于TcpServer的HTTP/1.1服务器
+ * @details
+ * - 请求在连接所属的IO loop内解析与处理，处理函数不能阻塞
+ * - 需要等待后端或者流式发送时，处理函数调用 @c HttpResponse::defer 取得writer，
+ *   返回后在任意线程write/end；应答结束前同一连接上的后续请求留在缓冲区，按顺序处理
+ * - 支持keep-alive与流水线：一次读事件内的全部完整请求依次处理，应答合并后一次发送
+ * - 请求解析不拷贝，头部与body都是接收缓冲区的视图
+ * - 解析错误时应答对应的状态码并关闭连接
+ */
+class HttpServer : noncopyable {
+public:
+	HttpServer(EventLoop* loop, const Address& listen_addr, const std::string& name,
+			   TcpServer::Option option = TcpServer::kNoReusePort);
+
+	EventLoop* GetLoop(void) const { return server_.GetLoop(); }
+	// 底层tcp服务器，用于设置线程数、边沿触发等，必须在 @c start 之前设置
+	TcpServer* server(void) { return &server_; }
+	void SetThreadNum(int thread_num) { server_.SetThreadNum(thread_num); }
+
+	// 路由，必须在 @c start 之前注册
+	HttpRouter* router(void) { return &router_; }
+	// 没有匹配路由时的处理函数，为空时应答404/405
+	void SetDefaultHandler(const HttpHandler& handler) { default_handler_ = handler; }
+	// 请求头部与body的长度上限，只影响之后建立的连接
+	void SetLimits(size_t max_header_size, size_t max_body_size) {
+		max_header_size_ = max_header_size;
+		max_body_size_ = max_body_size;
+	}
+
+	void start(void);
+
+private:
+	void OnConnection(const TcpConnectionPtr& conn);
+	void OnMessage(const TcpConnectionPtr& conn, NetBuffer* buf, Timestamp receive_time);
+	// 处理一个请求，raw为请求的原始数据，应答追加到out；转为延迟应答时输出writer，不追加
+	bool OnRequest(const TcpConnectionPtr& conn, HttpRequest* request, const str::StringPiece& raw,
+				   std::string* out, HttpResponseWriterPtr* writer);
+	// 延迟应答结束，可能在处理函数内同步调用
+	void OnDeferredDone(const std::weak_ptr<TcpConnection>& weak_conn, bool keep_alive);
+	// 延迟应答结束后继续处理后续请求
+	void ResumeInLoop(const std::weak_ptr<TcpConnection>& weak_conn, bool keep_alive);
+	// 应答错误状态，发送后关闭连接
+	void SendError(const TcpConnectionPtr& conn, int status, std::string* out);
+
+	TcpServer server_;			///< tcp服务器
+	HttpRouter router_;			///< 路由
+	HttpHandler default_handler_;	///< 默认处理函数
+	size_t max_header_size_;	///< 头部最大长度
+	size_t max_body_size_;		///< body最大长度
+};
+
+} // namespace net
+
+} // namespace brsdk
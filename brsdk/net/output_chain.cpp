@@ -0,0 +1,277 @@
+/**
+ * MIT License
+ *
+ * Copyright © 2021 <Jerry.Yu>.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the “Software”), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * @file output_chain.cpp
+ * @brief 链式发送队列
+ * @author Jerry.Yu (jerry.yu512@outlook.com)
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright MIT License
+ *
+ */
+#include "output_chain.hpp"
+#include <assert.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <unistd.h>
+#include <sys/sendfile.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include "socket/socket_util.hpp"
+#include "event/event_log.hpp"
+
+namespace brsdk {
+
+namespace net {
+
+const size_t OutputChain::kCoalesceSize;
+
+namespace {
+
+// 单次splice搬运的最大长度，与默认管道容量一致
+const size_t kSpliceChunk = 64 * 1024;
+
+bool would_block(int err) {
+	return err == EAGAIN || err == EWOULDBLOCK || err == EINTR;
+}
+
+} // namespace
+
+OutputChain::~OutputChain() {
+	clear();
+}
+
+void OutputChain::append(const void* data, size_t len) {
+	if (0 == len) {
+		return;
+	}
+
+	const char* d = static_cast<const char*>(data);
+	if (!slices_.empty()) {
+		Slice& last = slices_.back();
+		// 队尾数据块独占且较小时直接合并
+		if (last.tail && last.block.use_count() == 1
+			&& last.tail->size() + len <= kCoalesceSize) {
+			last.tail->append(d, len);
+			last.len += len;
+			bytes_ += len;
+			return;
+		}
+	}
+
+	append(std::string(d, len));
+}
+
+void OutputChain::append(std::string&& data) {
+	if (data.empty()) {
+		return;
+	}
+
+	std::shared_ptr<std::string> block = std::make_shared<std::string>(std::move(data));
+	Slice slice;
+	slice.tail = block.get();
+	slice.block = std::move(block);
+	slice.len = slice.block->size();
+	push(std::move(slice));
+}
+
+void OutputChain::append(const Block& block, size_t offset, size_t len) {
+	if (!block || 0 == len) {
+		return;
+	}
+
+	assert(offset + len <= block->size());
+	Slice slice;
+	slice.block = block;
+	slice.offset = offset;
+	slice.len = len;
+	push(std::move(slice));
+}
+
+void OutputChain::append(const str::StringPiece& data, const ReleaseCallback& release) {
+	if (data.size() <= 0) {
+		if (release) {
+			release();
+		}
+		return;
+	}
+
+	Slice slice;
+	slice.data = data.data();
+	slice.len = static_cast<size_t>(data.size());
+	slice.release = release;
+	push(std::move(slice));
+}
+
+void OutputChain::AppendFile(int fd, off_t offset, size_t len, const ReleaseCallback& release) {
+	struct stat st;
+	if (fd < 0 || 0 == len || ::fstat(fd, &st) < 0) {
+		if (release) {
+			release();
+		}
+		return;
+	}
+
+	Slice slice;
+	slice.fd = fd;
+	slice.splice = !S_ISREG(st.st_mode);
+	slice.seekable = !slice.splice || ::lseek(fd, 0, SEEK_CUR) >= 0;
+	slice.offset = static_cast<uint64_t>(offset);
+	slice.len = len;
+	slice.release = release;
+	push(std::move(slice));
+}
+
+void OutputChain::push(Slice&& slice) {
+	bytes_ += slice.len;
+	slices_.push_back(std::move(slice));
+}
+
+ssize_t OutputChain::WriteTo(int fd, int* saved_errno) {
+	if (slices_.empty()) {
+		return 0;
+	}
+
+	ssize_t n = 0;
+	Slice& head = slices_.front();
+	if (head.fd >= 0) {
+		n = head.splice ? SpliceFile(fd, head) : SendFile(fd, head);
+	} else {
+		struct iovec vec[IOV_MAX];
+		int iovcnt = 0;
+		// 聚合连续的内存数据片，遇到文件片段为止
+		for (auto it = slices_.begin(); it != slices_.end() && iovcnt < IOV_MAX && it->fd < 0; ++it) {
+			vec[iovcnt].iov_base = const_cast<char*>(it->peek());
+			vec[iovcnt].iov_len = it->len;
+			iovcnt++;
+		}
+		n = sock_writev(fd, vec, iovcnt);
+	}
+
+	if (n < 0) {
+		// 发送缓冲区满，等待下一次写事件
+		if (would_block(errno)) {
+			return 0;
+		}
+		*saved_errno = errno;
+	} else {
+		retrieve(static_cast<size_t>(n));
+	}
+
+	return n;
+}
+
+ssize_t OutputChain::SendFile(int fd, Slice& head) {
+	off_t offset = static_cast<off_t>(head.offset);
+	ssize_t n = ::sendfile(fd, head.fd, &offset, head.len);
+	if (0 == n) {
+		DropHead();
+	}
+	return n;
+}
+
+ssize_t OutputChain::SpliceFile(int fd, Slice& head) {
+	if (pipe_[0] < 0 && ::pipe2(pipe_, O_NONBLOCK | O_CLOEXEC) < 0) {
+		return -1;
+	}
+
+	// 先把源数据搬进中转管道，再从管道搬到套接字，数据不经过用户态
+	if (piped_ < head.len) {
+		loff_t offset = static_cast<loff_t>(head.offset + piped_);
+		size_t chunk = std::min(head.len - piped_, kSpliceChunk);
+		ssize_t n = ::splice(head.fd, head.seekable ? &offset : nullptr, pipe_[1], nullptr,
+							 chunk, SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+		if (n > 0) {
+			piped_ += static_cast<size_t>(n);
+		} else if (0 == n) {
+			if (0 == piped_) {
+				DropHead();
+				return 0;
+			}
+			// 文件已结束，管道里的数据发送完后不再读取
+			LOG_WARN << "File fd = " << head.fd << " ended early, drop " << head.len - piped_ << " bytes";
+			bytes_ -= head.len - piped_;
+			head.len = piped_;
+		} else if (0 == piped_ || !would_block(errno)) {
+			return -1;
+		}
+	}
+
+	ssize_t n = ::splice(pipe_[0], nullptr, fd, nullptr, piped_, SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+	if (n > 0) {
+		piped_ -= static_cast<size_t>(n);
+	}
+	return n;
+}
+
+void OutputChain::DropHead(void) {
+	Slice& head = slices_.front();
+	LOG_WARN << "File fd = " << head.fd << " ended early, drop " << head.len << " bytes";
+	retrieve(head.len);
+}
+
+void OutputChain::retrieve(size_t len) {
+	while (len > 0 && !slices_.empty()) {
+		Slice& head = slices_.front();
+		if (len < head.len) {
+			head.offset += len;
+			head.len -= len;
+			bytes_ -= len;
+			return;
+		}
+
+		len -= head.len;
+		bytes_ -= head.len;
+		ReleaseCallback release;
+		release.swap(head.release);
+		slices_.pop_front();
+		if (release) {
+			release();
+		}
+	}
+}
+
+void OutputChain::clear(void) {
+	while (!slices_.empty()) {
+		ReleaseCallback release;
+		release.swap(slices_.front().release);
+		slices_.pop_front();
+		if (release) {
+			release();
+		}
+	}
+	bytes_ = 0;
+	// 管道中可能残留未发送的数据
+	ClosePipe();
+}
+
+void OutputChain::ClosePipe(void) {
+	if (pipe_[0] >= 0) {
+		::close(pipe_[0]);
+		::close(pipe_[1]);
+		pipe_[0] = pipe_[1] = -1;
+	}
+	piped_ = 0;
+}
+
+} // namespace net
+
+} // namespace brsdk
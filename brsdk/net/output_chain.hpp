@@ -0,0 +1,143 @@
+/**
+ * MIT License
+ *
+ * Copyright © 2021 <Jerry.Yu>.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the “Software”), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * @file output_chain.hpp
+ * @brief 链式发送队列
+ * @author Jerry.Yu (jerry.yu512@outlook.com)
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright MIT License
+ *
+ */
+#pragma once
+
+#include "brsdk/mix/noncopyable.hpp"
+#include "brsdk/str/string_piece.hpp"
+#include <sys/types.h>
+#include <stdint.h>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace brsdk {
+
+namespace net {
+
+/**
+ * @brief 链式发送队列，由多个数据片组成，发送时一次writev聚合写出
+ * @details
+ * - 自有数据片：引用计数的数据块，可被多个队列共享；小块数据合并到队尾数据块，减少分片
+ * - 借用数据片：只记录指针与长度，数据写完或者队列清空时调用释放回调
+ * - 文件片段：文件描述符与区间，普通文件使用sendfile发送，管道/字符设备等经由内部管道splice发送，
+ *   写完或者队列清空时调用释放回调
+ * - 追加数据不会搬移已入队的数据，大块数据不会因扩容反复拷贝
+ */
+class OutputChain : noncopyable {
+public:
+	// 数据片释放回调
+	using ReleaseCallback = std::function<void()>;
+	// 共享数据块
+	using Block = std::shared_ptr<const std::string>;
+
+	// 小于该长度的数据合并到队尾数据块
+	static const size_t kCoalesceSize = 16 * 1024;
+
+	OutputChain() : bytes_(0), piped_(0) {
+		pipe_[0] = pipe_[1] = -1;
+	}
+	~OutputChain();
+
+	// 待发送字节数
+	size_t readable_bytes(void) const { return bytes_; }
+	// 是否为空
+	bool empty(void) const { return slices_.empty(); }
+	// 数据片数量
+	size_t slices(void) const { return slices_.size(); }
+
+	// 拷贝追加
+	void append(const void* data, size_t len);
+	// 接管字符串
+	void append(std::string&& data);
+	// 追加共享数据块的一段，不拷贝
+	void append(const Block& block, size_t offset, size_t len);
+	// 追加借用数据，发送完成后调用release
+	void append(const str::StringPiece& data, const ReleaseCallback& release);
+	/**
+	 * @brief 追加文件区间，发送完成后调用release，fd在release调用前不能关闭
+	 * @details 不可seek的fd(管道、套接字等)忽略offset，从当前位置读取；
+	 *          读取会阻塞的fd需要保证数据已经就绪，否则阻塞事件循环；
+	 *          文件提前结束时剩余长度被丢弃
+	 *
+	 * @param fd 文件描述符
+	 * @param offset 起始偏移
+	 * @param len 长度
+	 * @param release 释放回调
+	 */
+	void AppendFile(int fd, off_t offset, size_t len, const ReleaseCallback& release = ReleaseCallback());
+
+	/**
+	 * @brief 写出到fd，内存数据片最多聚合IOV_MAX个一次writev，文件片段使用sendfile
+	 *
+	 * @param fd 套接字
+	 * @param saved_errno 写失败时的 @c errno
+	 * @return ssize_t 写出的字节数，发送缓冲区满返回0，失败返回-1
+	 */
+	ssize_t WriteTo(int fd, int* saved_errno);
+
+	// 丢弃前len字节
+	void retrieve(size_t len);
+	// 丢弃全部数据，调用未完成数据片的释放回调
+	void clear(void);
+
+private:
+	struct Slice {
+		Block block;					///< 自有数据块，借用数据与文件片段为空
+		std::string* tail = nullptr;	///< 独占的可合并数据块
+		const char* data = nullptr;		///< 借用数据
+		int fd = -1;					///< 文件描述符，内存数据片为-1
+		bool splice = false;			///< 非普通文件，经由管道splice发送
+		bool seekable = true;			///< 文件可seek，使用offset读取
+		uint64_t offset = 0;			///< 起始偏移
+		size_t len = 0;					///< 剩余长度
+		ReleaseCallback release;		///< 释放回调
+
+		const char* peek(void) const {
+			return (block ? block->data() : data) + offset;
+		}
+	};
+
+	void push(Slice&& slice);
+	// 文件片段写出
+	ssize_t SendFile(int fd, Slice& head);
+	ssize_t SpliceFile(int fd, Slice& head);
+	// 文件提前结束，丢弃队首剩余长度
+	void DropHead(void);
+	void ClosePipe(void);
+
+	std::deque<Slice> slices_;	///< 数据片
+	size_t bytes_;				///< 待发送字节数
+	int pipe_[2];				///< splice中转管道
+	size_t piped_;				///< 已进入中转管道的队首字节数
+};
+
+} // namespace net
+
+} // namespace brsdk
@@ -147,6 +147,10 @@ int sock_bind(int fd, const char *ip, int port) {
 }
 
 int sock_accept(int fd, sock_addr_t &addr) {
+    return sock_accept(fd, addr, 0);
+}
+
+int sock_accept(int fd, sock_addr_t &addr, int flags) {
     struct sockaddr_in *sin4;   ///< ipv4
     struct sockaddr_in6 *sin6;  ///< ipv6
     struct sockaddr_un *un;     ///< unix地址
@@ -171,7 +175,7 @@ int sock_accept(int fd, sock_addr_t &addr) {
         return -1;
     }
 
-    int cli = accept(fd, (struct sockaddr *)&addr, &len);
+    int cli = accept4(fd, (struct sockaddr *)&addr, &len, flags);
 
     if (cli <= 0) {
         return -1;
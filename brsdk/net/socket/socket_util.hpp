@@ -187,6 +187,17 @@ static inline int sock_listen(int fd, int blocklog = 5) { return ::listen(fd, bl
  */
 int sock_accept(int fd, sock_addr_t& addr);
 
+/**
+ * @brief accept4，新套接字直接带上标志，省去额外的fcntl调用
+ *
+ * @param fd 服务器套接字
+ * @param addr 客户端地址
+ * @param flags @c SOCK_NONBLOCK / @c SOCK_CLOEXEC
+ *
+ * @return 小于0异常，accept得到的客户端套接字
+ */
+int sock_accept(int fd, sock_addr_t& addr, int flags);
+
 /**
  * @brief 连接到服务器
  *
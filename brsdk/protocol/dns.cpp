@@ -0,0 +1,356 @@
+/**
+ * MIT License
+ *
+ * Copyright © 2021 <Jerry.Yu>.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the “Software”), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * @file dns.cpp
+ * @brief dns报文编解码
+ * @author Jerry.Yu (jerry.yu512@outlook.com)
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright MIT License
+ *
+ */
+#include "dns.hpp"
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+namespace brsdk {
+
+namespace protocol {
+
+namespace {
+
+// 标签最大长度
+const int kMaxLabel = 63;
+// 问题记录的最小长度：根域名 + 类型 + 类
+const int kMinQuestion = 1 + 4;
+// 资源记录的最小长度：压缩指针 + 类型 + 类 + ttl + 数据长度
+const int kMinRecord = 2 + 10;
+
+/**
+ * @brief 解码域名，不超过len字节
+ * @details 压缩指针需要完整报文才能展开，此处只解码指针之前的标签，
+ *          应答中的记录名通常是指向问题的指针，调用者按问题匹配即可
+ *
+ * @return int 域名在buf中占用的字节数，-1为格式错误
+ */
+int name_decode(const char* buf, int len, char* domain) {
+    const uint8_t* p = reinterpret_cast<const uint8_t*>(buf);
+    int off = 0;
+    int out = 0;
+    domain[0] = '\0';
+    while (off < len) {
+        uint8_t label = p[off];
+        if (0 == label) {
+            return off + 1;
+        }
+        if ((label & 0xC0) == 0xC0) {
+            return off + 2 <= len ? off + 2 : -1;
+        }
+        if (label > kMaxLabel || off + 1 + label > len || out + label + 1 >= BRSDK_DNS_NAME_MAXLEN) {
+            return -1;
+        }
+        if (out > 0) {
+            domain[out++] = '.';
+        }
+        memcpy(domain + out, buf + off + 1, label);
+        out += label;
+        domain[out] = '\0';
+        off += 1 + label;
+    }
+    return -1;
+}
+
+inline void put16(char* p, uint16_t v) {
+    v = htons(v);
+    memcpy(p, &v, 2);
+}
+
+inline void put32(char* p, uint32_t v) {
+    v = htonl(v);
+    memcpy(p, &v, 4);
+}
+
+inline uint16_t get16(const char* p) {
+    uint16_t v;
+    memcpy(&v, p, 2);
+    return ntohs(v);
+}
+
+inline uint32_t get32(const char* p) {
+    uint32_t v;
+    memcpy(&v, p, 4);
+    return ntohl(v);
+}
+
+// 分配count条记录并依次解码，记录数先按剩余长度校验，避免伪造的计数导致大量分配
+int unpack_section(char* buf, int len, int count, int is_question, dns_rr_t** rrs) {
+    *rrs = NULL;
+    if (0 == count) {
+        return 0;
+    }
+    if (count > len / (is_question ? kMinQuestion : kMinRecord)) {
+        return -1;
+    }
+    *rrs = static_cast<dns_rr_t*>(calloc(count, sizeof(dns_rr_t)));
+    if (NULL == *rrs) {
+        return -1;
+    }
+    int off = 0;
+    for (int i = 0; i < count; i++) {
+        int n = dns_rr_unpack(buf + off, len - off, *rrs + i, is_question);
+        if (n < 0) {
+            return -1;
+        }
+        off += n;
+    }
+    return off;
+}
+
+int pack_section(dns_rr_t* rrs, int count, char* buf, int len) {
+    int off = 0;
+    for (int i = 0; i < count; i++) {
+        int n = dns_rr_pack(rrs + i, buf + off, len - off);
+        if (n < 0) {
+            return -1;
+        }
+        off += n;
+    }
+    return off;
+}
+
+} // namespace
+
+int dns_name_encode(const char* domain, char* buf) {
+    // 每个标签前写长度，最后以0结束
+    char* len_pos = buf;
+    char* out = buf + 1;
+    int label = 0;
+    for (const char* p = domain; *p; p++) {
+        if ('.' == *p) {
+            if (0 == label) {
+                return -1;
+            }
+            *len_pos = static_cast<char>(label);
+            len_pos = out++;
+            label = 0;
+            continue;
+        }
+        if (++label > kMaxLabel || out - buf >= BRSDK_DNS_NAME_MAXLEN - 1) {
+            return -1;
+        }
+        *out++ = *p;
+    }
+    if (0 == label) {
+        // 空域名或者以'.'结尾，最后一个长度即结束符
+        *len_pos = 0;
+        return static_cast<int>(out - buf);
+    }
+    *len_pos = static_cast<char>(label);
+    *out++ = 0;
+    return static_cast<int>(out - buf);
+}
+
+int dns_name_decode(const char* buf, char* domain) {
+    return name_decode(buf, BRSDK_DNS_NAME_MAXLEN + 1, domain);
+}
+
+int dns_rr_pack(dns_rr_t* rr, char* buf, int len) {
+    char name[BRSDK_DNS_NAME_MAXLEN + 1];
+    int n = dns_name_encode(rr->name, name);
+    if (n < 0 || len < n + 4) {
+        return -1;
+    }
+    memcpy(buf, name, n);
+    char* p = buf + n;
+    put16(p, rr->rtype);
+    put16(p + 2, rr->rclass);
+    p += 4;
+    // 问题记录没有ttl与数据
+    if (rr->ttl || rr->datalen) {
+        if (len < n + 10 + rr->datalen) {
+            return -1;
+        }
+        put32(p, rr->ttl);
+        put16(p + 4, rr->datalen);
+        p += 6;
+        if (rr->datalen) {
+            memcpy(p, rr->data, rr->datalen);
+            p += rr->datalen;
+        }
+    }
+    return static_cast<int>(p - buf);
+}
+
+int dns_rr_unpack(char* buf, int len, dns_rr_t* rr, int is_question) {
+    int n = name_decode(buf, len, rr->name);
+    if (n < 0 || len < n + 4) {
+        return -1;
+    }
+    char* p = buf + n;
+    rr->rtype = get16(p);
+    rr->rclass = get16(p + 2);
+    p += 4;
+    if (is_question) {
+        return static_cast<int>(p - buf);
+    }
+    if (len < n + 10) {
+        return -1;
+    }
+    rr->ttl = get32(p);
+    rr->datalen = get16(p + 4);
+    p += 6;
+    if (len < n + 10 + rr->datalen) {
+        return -1;
+    }
+    // 数据指向报文缓冲区，不拷贝
+    rr->data = rr->datalen ? p : NULL;
+    p += rr->datalen;
+    return static_cast<int>(p - buf);
+}
+
+int dns_pack(dns_t* dns, char* buf, int len) {
+    if (len < static_cast<int>(sizeof(dnshdr_t))) {
+        return -1;
+    }
+    dnshdr_t hdr = dns->hdr;
+    hdr.transaction_id = htons(hdr.transaction_id);
+    hdr.nquestion = htons(hdr.nquestion);
+    hdr.nanswer = htons(hdr.nanswer);
+    hdr.nauthority = htons(hdr.nauthority);
+    hdr.naddtional = htons(hdr.naddtional);
+    memcpy(buf, &hdr, sizeof(hdr));
+
+    int off = sizeof(dnshdr_t);
+    dns_rr_t* sections[] = {dns->questions, dns->answers, dns->authorities, dns->addtionals};
+    int counts[] = {dns->hdr.nquestion, dns->hdr.nanswer, dns->hdr.nauthority, dns->hdr.naddtional};
+    for (int i = 0; i < 4; i++) {
+        int n = pack_section(sections[i], counts[i], buf + off, len - off);
+        if (n < 0) {
+            return -1;
+        }
+        off += n;
+    }
+    return off;
+}
+
+int dns_unpack(char* buf, int len, dns_t* dns) {
+    memset(dns, 0, sizeof(dns_t));
+    if (len < static_cast<int>(sizeof(dnshdr_t))) {
+        return -1;
+    }
+    memcpy(&dns->hdr, buf, sizeof(dnshdr_t));
+    dns->hdr.transaction_id = ntohs(dns->hdr.transaction_id);
+    dns->hdr.nquestion = ntohs(dns->hdr.nquestion);
+    dns->hdr.nanswer = ntohs(dns->hdr.nanswer);
+    dns->hdr.nauthority = ntohs(dns->hdr.nauthority);
+    dns->hdr.naddtional = ntohs(dns->hdr.naddtional);
+
+    int off = sizeof(dnshdr_t);
+    dns_rr_t** sections[] = {&dns->questions, &dns->answers, &dns->authorities, &dns->addtionals};
+    int counts[] = {dns->hdr.nquestion, dns->hdr.nanswer, dns->hdr.nauthority, dns->hdr.naddtional};
+    for (int i = 0; i < 4; i++) {
+        int n = unpack_section(buf + off, len - off, counts[i], 0 == i, sections[i]);
+        if (n < 0) {
+            dns_free(dns);
+            return -1;
+        }
+        off += n;
+    }
+    return off;
+}
+
+void dns_free(dns_t* dns) {
+    free(dns->questions);
+    free(dns->answers);
+    free(dns->authorities);
+    free(dns->addtionals);
+    dns->questions = NULL;
+    dns->answers = NULL;
+    dns->authorities = NULL;
+    dns->addtionals = NULL;
+}
+
+int dns_query(dns_t* query, dns_t* response, const char* nameserver) {
+    // 应答记录的数据指向该缓冲区，同一线程下一次查询前有效
+    static thread_local char s_buf[1024];
+    int len = dns_pack(query, s_buf, sizeof(s_buf));
+    if (len < 0) {
+        return len;
+    }
+    int sockfd = ::socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+    if (sockfd < 0) {
+        return -1;
+    }
+    struct timeval tv = {5, 0};
+    setsockopt(sockfd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(BRSDK_DNS_PORT);
+    inet_pton(AF_INET, nameserver, &addr.sin_addr);
+
+    int ret = -1;
+    if (sendto(sockfd, s_buf, len, 0, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) == len) {
+        ssize_t n = recvfrom(sockfd, s_buf, sizeof(s_buf), 0, NULL, NULL);
+        if (n > 0) {
+            ret = dns_unpack(s_buf, static_cast<int>(n), response);
+        }
+    }
+    close(sockfd);
+    return ret;
+}
+
+int nslookup(const char* domain, uint32_t* addrs, int naddr, const char* nameserver) {
+    dns_t query;
+    memset(&query, 0, sizeof(query));
+    query.hdr.transaction_id = static_cast<uint16_t>(getpid());
+    query.hdr.qr = BRSDK_DNS_QUERY;
+    query.hdr.rd = 1;
+    query.hdr.nquestion = 1;
+    dns_rr_t question;
+    memset(&question, 0, sizeof(question));
+    strncpy(question.name, domain, sizeof(question.name) - 1);
+    question.rtype = BRSDK_DNS_TYPE_A;
+    question.rclass = BRSDK_DNS_CLASS_IN;
+    query.questions = &question;
+
+    dns_t response;
+    if (dns_query(&query, &response, nameserver) < 0) {
+        return -1;
+    }
+    int count = 0;
+    for (int i = 0; i < response.hdr.nanswer && count < naddr; i++) {
+        dns_rr_t* rr = response.answers + i;
+        if (rr->rtype == BRSDK_DNS_TYPE_A && rr->datalen == 4) {
+            memcpy(addrs + count++, rr->data, 4);
+        }
+    }
+    dns_free(&response);
+    return count;
+}
+
+} // namespace protocol
+
+} // namespace brsdk
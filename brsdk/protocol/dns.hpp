@@ -115,6 +115,7 @@ int dns_name_encode(const char* domain, char* buf);
 int dns_name_decode(const char* buf, char* domain);
 
 int dns_rr_pack(dns_rr_t* rr, char* buf, int len);
+// 解码时记录的data指向buf，不拷贝；压缩指针不展开，name只含指针之前的标签
 int dns_rr_unpack(char* buf, int len, dns_rr_t* rr, int is_question);
 
 int dns_pack(dns_t* dns, char* buf, int len);
@@ -123,6 +124,7 @@ int dns_unpack(char* buf, int len, dns_t* dns);
 void dns_free(dns_t* dns);
 
 // dns_pack -> sendto -> recvfrom -> dns_unpack
+// 阻塞查询，应答记录的data指向线程私有的接收缓冲区，同一线程下一次查询前有效
 int dns_query(dns_t* query, dns_t* response, const char* nameserver = "127.0.1,1");
 
 // domain -> dns_t query; -> dns_query -> dns_t response; -> addrs
@@ -0,0 +1,190 @@
+/**
+ * MIT License
+ *
+ * Copyright © 2021 <Jerry.Yu>.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the “Software”), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * @file scan.cpp
+ * @brief 分隔符查找
+ * @author Jerry.Yu (jerry.yu512@outlook.com)
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright MIT License
+ *
+ */
+#include "scan.hpp"
+#include <string.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && defined(__SSE2__)
+#define BRSDK_SCAN_X86 1
+#include <immintrin.h>
+#endif
+
+namespace brsdk {
+
+namespace str {
+
+namespace {
+
+using FindFunc = const char* (*)(const char*, const char*, const char*, size_t);
+
+// 确认候选位置是否为完整的分隔符
+inline bool match_at(const char* p, const char* delim, size_t len) {
+    return 0 == ::memcmp(p + 1, delim + 1, len - 2);
+}
+
+// 标量实现，也用于向量实现的尾部
+const char* find_scalar(const char* begin, const char* end, const char* delim, size_t len) {
+    const char* last = end - len;
+    const char* p = begin;
+    while (p <= last) {
+        p = static_cast<const char*>(::memchr(p, delim[0], last - p + 1));
+        if (nullptr == p) {
+            return nullptr;
+        }
+        if (p[len - 1] == delim[len - 1] && match_at(p, delim, len)) {
+            return p;
+        }
+        ++p;
+    }
+    return nullptr;
+}
+
+#ifdef BRSDK_SCAN_X86
+
+// 首尾字节同时相等的位置为候选，逐位确认
+const char* find_sse2(const char* begin, const char* end, const char* delim, size_t len) {
+    const __m128i first = _mm_set1_epi8(delim[0]);
+    const __m128i last = _mm_set1_epi8(delim[len - 1]);
+    const char* p = begin;
+    // 保证p + len - 1 + 16不越界
+    for (; end - p >= static_cast<ptrdiff_t>(len - 1 + 16); p += 16) {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + len - 1));
+        unsigned mask = static_cast<unsigned>(
+            _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(a, first), _mm_cmpeq_epi8(b, last))));
+        while (mask) {
+            int i = __builtin_ctz(mask);
+            if (match_at(p + i, delim, len)) {
+                return p + i;
+            }
+            mask &= mask - 1;
+        }
+    }
+    return find_scalar(p, end, delim, len);
+}
+
+__attribute__((target("avx2")))
+const char* find_avx2(const char* begin, const char* end, const char* delim, size_t len) {
+    const __m256i first = _mm256_set1_epi8(delim[0]);
+    const __m256i last = _mm256_set1_epi8(delim[len - 1]);
+    const char* p = begin;
+    for (; end - p >= static_cast<ptrdiff_t>(len - 1 + 32); p += 32) {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + len - 1));
+        unsigned mask = static_cast<unsigned>(
+            _mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(a, first), _mm256_cmpeq_epi8(b, last))));
+        while (mask) {
+            int i = __builtin_ctz(mask);
+            if (match_at(p + i, delim, len)) {
+                return p + i;
+            }
+            mask &= mask - 1;
+        }
+    }
+    return find_sse2(p, end, delim, len);
+}
+
+#endif
+
+// 各实现共用的参数检查，单字节分隔符使用memchr
+template <FindFunc find>
+const char* checked(const char* begin, const char* end, const char* delim, size_t len) {
+    if (0 == len || end - begin < static_cast<ptrdiff_t>(len)) {
+        return nullptr;
+    }
+    // glibc的memchr已经向量化
+    if (1 == len) {
+        return static_cast<const char*>(::memchr(begin, delim[0], end - begin));
+    }
+    return find(begin, end, delim, len);
+}
+
+struct Impl {
+    FindFunc find;
+    const char* name;
+};
+
+bool supported(const char* name) {
+#ifdef BRSDK_SCAN_X86
+    __builtin_cpu_init();
+    if (0 == ::strcmp(name, "avx2")) {
+        return __builtin_cpu_supports("avx2");
+    }
+    return 0 == ::strcmp(name, "sse2") || 0 == ::strcmp(name, "scalar");
+#else
+    return 0 == ::strcmp(name, "scalar");
+#endif
+}
+
+// 按名称取实现，不支持时find为空
+Impl named_impl(const char* name) {
+    if (!supported(name)) {
+        return Impl{nullptr, name};
+    }
+#ifdef BRSDK_SCAN_X86
+    if (0 == ::strcmp(name, "avx2")) {
+        return Impl{&checked<find_avx2>, "avx2"};
+    }
+    if (0 == ::strcmp(name, "sse2")) {
+        return Impl{&checked<find_sse2>, "sse2"};
+    }
+#endif
+    return Impl{&checked<find_scalar>, "scalar"};
+}
+
+Impl select_impl(void) {
+    Impl avx2 = named_impl("avx2");
+    if (avx2.find) {
+        return avx2;
+    }
+    Impl sse2 = named_impl("sse2");
+    return sse2.find ? sse2 : named_impl("scalar");
+}
+
+const Impl& impl(void) {
+    static const Impl s_impl = select_impl();
+    return s_impl;
+}
+
+} // namespace
+
+const char* find_delimiter(const char* begin, const char* end, const char* delim, size_t len) {
+    return impl().find(begin, end, delim, len);
+}
+
+const char* scan_isa(void) {
+    return impl().name;
+}
+
+FindDelimiterFunc find_delimiter_impl(const char* isa) {
+    return named_impl(isa).find;
+}
+
+} // namespace str
+
+} // namespace brsdk
@@ -0,0 +1,70 @@
+/**
+ * MIT License
+ *
+ * Copyright © 2021 <Jerry.Yu>.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the “Software”), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * @file scan.hpp
+ * @brief 分隔符查找
+ * @author Jerry.Yu (jerry.yu512@outlook.com)
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright MIT License
+ *
+ */
+#pragma once
+
+#include <stddef.h>
+
+namespace brsdk {
+
+namespace str {
+
+/**
+ * @brief 在[begin, end)中查找分隔符
+ * @details 单字节分隔符使用memchr；多字节分隔符同时比较首尾字节筛选候选位置，再逐个确认。
+ *          x86上运行时按CPU选择AVX2/SSE2实现，其他平台使用标量实现
+ *
+ * @param begin 起始位置
+ * @param end 结束位置
+ * @param delim 分隔符
+ * @param len 分隔符长度
+ * @return const char* 分隔符位置，未找到返回nullptr
+ */
+const char* find_delimiter(const char* begin, const char* end, const char* delim, size_t len);
+
+// 查找"\r\n"
+inline const char* find_crlf(const char* begin, const char* end) {
+    return find_delimiter(begin, end, "\r\n", 2);
+}
+
+// 查找"\r\n\r\n"
+inline const char* find_crlfcrlf(const char* begin, const char* end) {
+    return find_delimiter(begin, end, "\r\n\r\n", 4);
+}
+
+// 当前使用的实现："avx2"、"sse2"或者"scalar"
+const char* scan_isa(void);
+
+using FindDelimiterFunc = const char* (*)(const char* begin, const char* end, const char* delim, size_t len);
+
+// 按名称取查找实现，行为同find_delimiter，用于对比各实现；当前平台或CPU不支持时返回nullptr
+FindDelimiterFunc find_delimiter_impl(const char* isa);
+
+} // namespace str
+
+} // namespace brsdk
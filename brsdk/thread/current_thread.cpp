@@ -93,15 +93,20 @@ void sleepUsec(int64_t usec) {
 }
 
 std::string stackTrace(bool demangle) {
-    std::string stack;
     const int max_frames = 200;
     void* frame[max_frames];
     int nptrs = ::backtrace(frame, max_frames);
-    char** strings = ::backtrace_symbols(frame, nptrs);
+    // skipping the 0-th, which is this function
+    return nptrs > 1 ? stackTrace(frame + 1, nptrs - 1, demangle) : std::string();
+}
+
+std::string stackTrace(void* const* frames, int count, bool demangle) {
+    std::string stack;
+    char** strings = ::backtrace_symbols(frames, count);
     if (strings) {
         size_t len = 256;
         char* demangled = demangle ? static_cast<char*>(::malloc(len)) : nullptr;
-        for (int i = 1; i < nptrs; ++i)  // skipping the 0-th, which is this function
+        for (int i = 0; i < count; ++i)
         {
             if (demangle) {
                 // https://panthema.net/2008/0901-stacktrace-demangled/
@@ -94,6 +94,16 @@ void sleepUsec(int64_t usec);
  */
 std::string stackTrace(bool demangle);
 
+/**
+ * @brief 格式化已采集的栈帧，可用于其他线程采集的栈
+ * 
+ * @param frames backtrace采集的帧地址
+ * @param count 帧数
+ * @param demangle 是否还原C++符号名
+ * @return std::string 栈信息字符串，每帧一行
+ */
+std::string stackTrace(void* const* frames, int count, bool demangle);
+
 }  // namespace thread
 
 }  // namespace brsdk
@@ -29,6 +29,7 @@
 #pragma once
 #include "brsdk/lock/condition.hpp"
 #include "brsdk/lock/mutex.hpp"
+#include "brsdk/mix/inline_function.hpp"
 #include "brsdk/mix/types.hpp"
 #include "thread.hpp"
 
@@ -42,14 +43,16 @@ namespace thread {
 
 class ThreadPool : noncopyable {
 public:
-    typedef std::function<void()> Task;
+    // 只移动，可捕获unique_ptr，小对象入队不分配内存
+    typedef InlineFunction<void()> Task;
+    typedef std::function<void()> ThreadInitCallback;
 
     explicit ThreadPool(const std::string& nameArg = std::string("ThreadPool"));
     ~ThreadPool();
 
     // Must be called before start().
     void setMaxQueueSize(int maxSize) { maxQueueSize_ = maxSize; }
-    void setThreadInitCallback(const Task& cb) { threadInitCallback_ = cb; }
+    void setThreadInitCallback(const ThreadInitCallback& cb) { threadInitCallback_ = cb; }
 
     void start(int numThreads);
     void stop();
@@ -60,10 +63,7 @@ public:
 
     // Could block if maxQueueSize > 0
     // Call after stop() will return immediately.
-    // There is no move-only version of std::function in C++ as of C++14.
-    // So we don't need to overload a const& and an && versions
-    // as we do in (Bounded)BlockingQueue.
-    // https://stackoverflow.com/a/25408989
+    // Task is move-only, so the task is taken by value and moved into the queue.
     void run(Task f);
 
 private:
@@ -75,7 +75,7 @@ private:
     Condition notEmpty_ GUARDED_BY(mutex_);
     Condition notFull_ GUARDED_BY(mutex_);
     std::string name_;
-    Task threadInitCallback_;
+    ThreadInitCallback threadInitCallback_;
     std::vector<std::unique_ptr<Thread>> threads_;
     std::deque<Task> queue_ GUARDED_BY(mutex_);
     size_t maxQueueSize_;
@@ -0,0 +1,65 @@
+/**
+ * MIT License
+ * 
+ * Copyright © 2021 <wotsen>.
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the “Software”), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * 
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ * 
+ * @file configure.h.in
+ * @brief 编译时环境相关
+ * @author wotsen (astralrovers@outlook.com)
+ * @version 1.0.0
+ * @date 2026-10-17
+ * 
+ * @copyright MIT License
+ * 
+ */
+#pragma once
+
+/// 版本号
+#define BRSDK_VERSION "1.0.0"
+/// 主/次/修订版本号
+#define BRSDK_VERSION_MAJOR 1
+#define BRSDK_VERSION_MINOR 0
+#define BRSDK_VERSION_ALTER 0
+/// 构建版本
+#define BRSDK_VERSION_BUILD 202610170421
+/// 构建时间
+#define BRSDK_BUILD_TIME    "Saturday 2026-10-17 04:21:30 +0000"
+
+/// 平台架构
+#define BRSDK_ARCH "x86_64"
+/// 平台名称
+#define BRSDK_PLAT "linux"
+/// 处理器
+#define BRSDK_PROCESSOR ""
+/// 平台版本
+#define BRSDK_PLAT_VERSION "#1 SMP PREEMPT_DYNAMIC @0"
+/// 系统
+#define BRSDK_OS "Linux-6.18.44-fc-v130-x86_64-with-glibc2.36"
+
+/// 编译发布模式
+#define BRSDK_MODE "release"
+/// 是否是debug版本
+#define BRSDK_DEBUG 0
+
+/// 编译器
+#define BRSDK_COMPILER "gcc"
+
+/// 作者
+#define BRSDK_AUTHOR "wotsen(astralrovers@outlook.com)"
+
+/// 发布者
+#define BRSDK_RELEASE_USER "root"
@@ -55,6 +55,8 @@ SO_LIBS = -lz -lssl -lcrypto -lpthread -ldl -lrt # -lresolv
 
 # 使用poll
 # -DBRSDK_POOL_EN
+# 使用io_uring(内核5.13+，不支持时回退到epoll)，也可运行时设置环境变量BRSDK_POLLER=io_uring
+# -DUSE_IO_URING
 
 DMARCROS := -DLANGUAGE_ZH -DWITH_OPENSSL -DWITH_ZLIB -DUSE_EPOLL -DSOFT_VERSION=\"$(RELEASE_VERSION)\" \
 			-DBUILD_VERSION="\"$(BUILD_VERSION)"\"
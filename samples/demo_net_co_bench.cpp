@@ -0,0 +1,168 @@
+/**
+ * MIT License
+ *
+ * Copyright © 2021 <Jerry.Yu>.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the “Software”), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * @file demo_net_co_bench.cpp
+ * @brief 回显压测，对比回调与协程两种写法的服务端
+ * @author Jerry.Yu (jerry.yu512@outlook.com)
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright MIT License
+ *
+ */
+#include "brsdk/log/logging.hpp"
+#include "brsdk/net/event/co_connection.hpp"
+#include "brsdk/net/event/connection.hpp"
+#include "brsdk/net/event/tcp_server.hpp"
+#include "brsdk/net/event/tcp_client.hpp"
+#include "brsdk/net/event/event_loop.hpp"
+#include "brsdk/thread/thread.hpp"
+#include "brsdk/time/timestamp.hpp"
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace brsdk;
+using namespace brsdk::net;
+
+using std::placeholders::_1;
+using std::placeholders::_2;
+using std::placeholders::_3;
+
+// 回调写法：收到即回显
+static void on_server_message(const TcpConnectionPtr& conn, NetBuffer* buf, Timestamp) {
+	conn->send(buf);
+}
+
+// 协程写法：同步地等数据、写回
+static void co_echo(const TcpConnectionPtr& conn) {
+	NetBuffer* buf = conn->input_buffer();
+	while (co_fill(conn, 1)) {
+		if (!co_write(conn, str::StringPiece(buf->peek(), static_cast<int>(buf->readable_bytes())))) {
+			break;
+		}
+		buf->retrieve_all();
+	}
+}
+
+// 客户端统计收到的字节并回送，形成乒乓
+class PingPongClient {
+public:
+	PingPongClient(EventLoop* loop, const Address& addr, const std::string& message, int64_t* bytes)
+	: client_(loop, addr, "PingPong"), message_(message), bytes_(bytes) {
+		client_.SetConnectionCallback(std::bind(&PingPongClient::OnConnection, this, _1));
+		client_.SetMessageCallback(std::bind(&PingPongClient::OnMessage, this, _1, _2, _3));
+	}
+	void connect(void) { client_.connect(); }
+	void disconnect(void) { client_.disconnect(); }
+	void stop(void) { stopped_ = true; }
+
+private:
+	void OnConnection(const TcpConnectionPtr& conn) {
+		if (conn->connected()) {
+			conn->send(message_);
+		}
+	}
+	void OnMessage(const TcpConnectionPtr& conn, NetBuffer* buf, Timestamp) {
+		*bytes_ += static_cast<int64_t>(buf->readable_bytes());
+		if (stopped_) {
+			buf->retrieve_all();
+		} else {
+			conn->send(buf);
+		}
+	}
+
+	TcpClient client_;
+	std::string message_;
+	int64_t* bytes_;
+	bool stopped_ = false;
+};
+
+static void bench(bool coroutine, int connections, int message_size, int seconds, uint16_t port) {
+	EventLoop server_loop;
+	Address addr("127.0.0.1", port);
+	TcpServer server(&server_loop, addr, "CoBench");
+	if (coroutine) {
+		co_serve(&server, co_echo);
+	} else {
+		server.SetMessageCallback(on_server_message);
+	}
+	server.start();
+
+	int64_t bytes = 0;
+	double elapsed = 0.0;
+	thread::Thread client_thread([&] {
+		EventLoop loop;
+		std::string message(static_cast<size_t>(message_size), 'x');
+		std::vector<std::unique_ptr<PingPongClient>> clients;
+		for (int i = 0; i < connections; i++) {
+			clients.emplace_back(new PingPongClient(&loop, addr, message, &bytes));
+			clients.back()->connect();
+		}
+
+		// 预热一秒后开始统计
+		Timestamp start;
+		loop.RunAfter(1.0, [&] {
+			bytes = 0;
+			start = Timestamp::now();
+		});
+		loop.RunAfter(1.0 + seconds, [&] {
+			elapsed = timeDifference(Timestamp::now(), start);
+			for (auto& c : clients) {
+				c->stop();
+			}
+			loop.RunAfter(0.2, [&] {
+				for (auto& c : clients) {
+					c->disconnect();
+				}
+			});
+			loop.RunAfter(0.5, [&] { loop.quit(); });
+		});
+		loop.loop();
+		clients.clear();
+		server_loop.RunAfter(0.2, [&] { server_loop.quit(); });
+	}, "bench client");
+
+	client_thread.start();
+	server_loop.loop();
+	client_thread.join();
+
+	double messages = static_cast<double>(bytes) / message_size;
+	printf("%-10s conns %4d  msg %6d B  %12.0f msgs/s  %9.2f MiB/s\n",
+		   coroutine ? "coroutine" : "callback", connections, message_size,
+		   messages / elapsed, bytes / elapsed / (1024 * 1024));
+}
+
+// 用法: demo_net_co_bench [连接数] [消息大小] [秒数]
+int main(int argc, char* argv[]) {
+	Logger::setLogLevel(Logger::WARN);
+	::signal(SIGPIPE, SIG_IGN);
+
+	int connections = argc > 1 ? atoi(argv[1]) : 64;
+	int message_size = argc > 2 ? atoi(argv[2]) : 64;
+	int seconds = argc > 3 ? atoi(argv[3]) : 3;
+
+	bench(false, connections, message_size, seconds, 18013);
+	bench(true, connections, message_size, seconds, 18014);
+
+	return 0;
+}
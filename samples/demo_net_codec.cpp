@@ -0,0 +1,269 @@
+/**
+ * MIT License
+ * 
+ * Copyright © 2021 <Jerry.Yu>.
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the “Software”), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * 
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ * 
+ * @file demo_net_codec.cpp
+ * @brief 本地服务器按读事件记录解出的帧，验证分帧编解码的跨读事件帧头、varint溢出、最大帧长与一次读多帧
+ * @author Jerry.Yu (jerry.yu512@outlook.com)
+ * @version 1.0.0
+ * @date 2026-10-17
+ * 
+ * @copyright MIT License
+ * 
+ */
+#include "brsdk/log/logging.hpp"
+#include "brsdk/net/codec.hpp"
+#include "brsdk/net/event/tcp_server.hpp"
+#include "brsdk/net/event/event_loop.hpp"
+#include <arpa/inet.h>
+#include <errno.h>
+#include <netinet/in.h>
+#include <signal.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace brsdk;
+using namespace brsdk::net;
+
+using std::placeholders::_1;
+using std::placeholders::_2;
+using std::placeholders::_3;
+
+static int failures = 0;
+
+static void check(bool ok, const std::string& what) {
+	printf("%-4s %s\n", ok ? "ok" : "FAIL", what.c_str());
+	if (!ok) {
+		failures++;
+	}
+}
+
+/**
+ * @brief 使用一个编解码器的服务器，记录解出的帧、每次读事件解出的帧数与解码错误
+ */
+class CodecServer {
+public:
+	using CodecFactory = std::function<FrameCodec*(const FrameCodec::FrameCallback&)>;
+
+	CodecServer(EventLoop* loop, const Address& addr, const CodecFactory& factory, bool error_callback = true)
+	: addr_(addr), server_(loop, addr, "CodecServer") {
+		codec_.reset(factory(std::bind(&CodecServer::OnFrame, this, _1, _2, _3)));
+		if (error_callback) {
+			codec_->SetErrorCallback([this](const TcpConnectionPtr& conn, FrameCodec::Error error) {
+				errors.push_back(error);
+				conn->ForceClose();
+			});
+		}
+		server_.SetMessageCallback(std::bind(&CodecServer::OnMessage, this, _1, _2, _3));
+		server_.start();
+	}
+
+	const Address& address(void) const { return addr_; }
+	FrameCodec* codec(void) { return codec_.get(); }
+
+	std::vector<std::string> frames;		///< 解出的帧
+	std::vector<size_t> reads;				///< 每次读事件解出的帧数
+	std::vector<FrameCodec::Error> errors;	///< 解码错误
+
+private:
+	void OnFrame(const TcpConnectionPtr&, const str::StringPiece& frame, Timestamp) {
+		frames.push_back(frame.as_string());
+	}
+
+	void OnMessage(const TcpConnectionPtr& conn, NetBuffer* buf, Timestamp receive_time) {
+		size_t before = frames.size();
+		codec_->OnMessage(conn, buf, receive_time);
+		reads.push_back(frames.size() - before);
+	}
+
+	Address addr_;
+	TcpServer server_;
+	std::unique_ptr<FrameCodec> codec_;
+};
+
+// 阻塞连接服务器，服务器已经在监听，不需要事件循环接受连接
+static int dial(const Address& addr) {
+	int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+	struct sockaddr_in sa;
+	::memset(&sa, 0, sizeof(sa));
+	sa.sin_family = AF_INET;
+	sa.sin_port = htons(addr.port());
+	::inet_pton(AF_INET, addr.ip().c_str(), &sa.sin_addr);
+	if (::connect(fd, reinterpret_cast<struct sockaddr*>(&sa), sizeof(sa)) < 0) {
+		::close(fd);
+		return -1;
+	}
+	return fd;
+}
+
+/**
+ * @brief 按间隔依次发送各段数据，每段在服务器上是一次单独的读事件
+ */
+static void send_pieces(EventLoop* loop, int fd, const std::vector<std::string>& pieces) {
+	for (size_t i = 0; i < pieces.size(); i++) {
+		std::string piece = pieces[i];
+		loop->RunAfter(0.05 + 0.03 * i, [fd, piece] {
+			if (::write(fd, piece.data(), piece.size()) != static_cast<ssize_t>(piece.size())) {
+				printf("write failed\n");
+			}
+		});
+	}
+}
+
+static std::string join(const std::vector<size_t>& values) {
+	std::string out;
+	for (size_t value : values) {
+		out += (out.empty() ? "" : ",") + std::to_string(value);
+	}
+	return out;
+}
+
+int main(int argc, char* argv[]) {
+	::signal(SIGPIPE, SIG_IGN);
+	Logger::setLogLevel(Logger::ERROR);
+
+	EventLoop loop;
+	std::vector<int> fds;
+	auto connect = [&](CodecServer& server) {
+		int fd = dial(server.address());
+		fds.push_back(fd);
+		return fd;
+	};
+
+	// 4字节帧头分两次到达，帧体再分一次
+	CodecServer split_length(&loop, Address("127.0.0.1", 19740), [](const FrameCodec::FrameCallback& cb) {
+		return new LengthFieldCodec(4, cb);
+	});
+	{
+		std::string frame;
+		split_length.codec()->encode(std::string(1000, 'x'), &frame);
+		send_pieces(&loop, connect(split_length), {frame.substr(0, 2), frame.substr(2, 100), frame.substr(102)});
+	}
+
+	// 两字节的varint帧头逐字节到达
+	CodecServer split_varint(&loop, Address("127.0.0.1", 19741), [](const FrameCodec::FrameCallback& cb) {
+		return new VarintCodec(cb);
+	});
+	{
+		std::string frame;
+		split_varint.codec()->encode(std::string(300, 'v'), &frame);
+		send_pieces(&loop, connect(split_varint), {frame.substr(0, 1), frame.substr(1, 1), frame.substr(2)});
+	}
+
+	// 一次读事件含多个完整帧与一个不完整帧，不完整帧在下次读事件补全
+	CodecServer multiple(&loop, Address("127.0.0.1", 19742), [](const FrameCodec::FrameCallback& cb) {
+		return new VarintCodec(cb);
+	});
+	{
+		std::string batch;
+		for (int i = 0; i < 5; i++) {
+			multiple.codec()->encode("frame" + std::to_string(i), &batch);
+		}
+		std::string tail;
+		multiple.codec()->encode("tail", &tail);
+		batch.append(tail, 0, 3);
+		send_pieces(&loop, connect(multiple), {batch, tail.substr(3)});
+	}
+
+	// 分隔符跨读事件，一次读事件含多行
+	CodecServer lines(&loop, Address("127.0.0.1", 19743), [](const FrameCodec::FrameCallback& cb) {
+		return new DelimiterCodec("\r\n", cb, 16);
+	});
+	send_pieces(&loop, connect(lines), {"hello\r", "\nworld\r\n\r\nlast\r\n"});
+
+	// varint的最高位一直置位，10字节后仍未结束
+	CodecServer overflow(&loop, Address("127.0.0.1", 19744), [](const FrameCodec::FrameCallback& cb) {
+		return new VarintCodec(cb);
+	});
+	send_pieces(&loop, connect(overflow), {std::string(4, '\x80'), std::string(6, '\x80') + "late"});
+
+	// varint帧头未收全时已经超过最大帧长
+	CodecServer varint_large(&loop, Address("127.0.0.1", 19745), [](const FrameCodec::FrameCallback& cb) {
+		return new VarintCodec(cb, 1000);
+	});
+	send_pieces(&loop, connect(varint_large), {"\xff\x7f"});
+
+	// 帧头声明的长度超过上限，没有错误回调时关闭连接
+	CodecServer too_large(&loop, Address("127.0.0.1", 19746), [](const FrameCodec::FrameCallback& cb) {
+		return new LengthFieldCodec(4, cb, 1024);
+	}, false);
+	int too_large_fd = connect(too_large);
+	{
+		std::string ok;
+		too_large.codec()->encode("fits", &ok);
+		std::string header("\x00\x00\x08\x00", 4);
+		send_pieces(&loop, too_large_fd, {ok + header + std::string(100, 'z')});
+	}
+
+	// 超过最大帧长仍没有分隔符
+	CodecServer long_line(&loop, Address("127.0.0.1", 19747), [](const FrameCodec::FrameCallback& cb) {
+		return new DelimiterCodec("\n", cb, 16);
+	});
+	send_pieces(&loop, connect(long_line), {"short\n" + std::string(10, 'a'), std::string(10, 'b')});
+
+	check(fds.end() == std::find(fds.begin(), fds.end(), -1), "clients connected");
+
+	loop.RunAfter(0.4, [&] {
+		check(split_length.frames.size() == 1 && split_length.frames[0] == std::string(1000, 'x')
+			  && join(split_length.reads) == "0,0,1",
+			  "length header split across reads: frames per read " + join(split_length.reads));
+		check(split_varint.frames.size() == 1 && split_varint.frames[0] == std::string(300, 'v')
+			  && join(split_varint.reads) == "0,0,1",
+			  "varint header split across reads: frames per read " + join(split_varint.reads));
+		check(multiple.frames.size() == 6 && multiple.frames[4] == "frame4" && multiple.frames[5] == "tail"
+			  && join(multiple.reads) == "5,1",
+			  "several frames in one read, partial frame completed later: frames per read " + join(multiple.reads));
+		check(lines.frames.size() == 4 && lines.frames[0] == "hello" && lines.frames[1] == "world"
+			  && lines.frames[2].empty() && lines.frames[3] == "last" && join(lines.reads) == "0,4",
+			  "delimiter split across reads: frames per read " + join(lines.reads));
+		check(overflow.frames.empty() && overflow.errors.size() == 1 && overflow.errors[0] == FrameCodec::kBadHeader
+			  && join(overflow.reads) == "0,0",
+			  "varint longer than 10 bytes rejected as a bad header");
+		check(varint_large.frames.empty() && varint_large.errors.size() == 1
+			  && varint_large.errors[0] == FrameCodec::kFrameTooLarge,
+			  "oversized varint length rejected before the frame arrives");
+		check(long_line.frames.size() == 1 && long_line.frames[0] == "short" && long_line.errors.size() == 1
+			  && long_line.errors[0] == FrameCodec::kFrameTooLarge,
+			  "line longer than max_frame_size rejected");
+
+		// 没有错误回调时连接被关闭，之前的完整帧照常回调
+		char c;
+		ssize_t n = ::recv(too_large_fd, &c, 1, MSG_DONTWAIT);
+		bool closed = 0 == n || (n < 0 && ECONNRESET == errno);
+		check(too_large.frames.size() == 1 && too_large.frames[0] == "fits" && too_large.errors.empty() && closed,
+			  "oversized length header closes the connection by default");
+		loop.quit();
+	});
+	loop.loop();
+
+	for (int fd : fds) {
+		if (fd >= 0) {
+			::close(fd);
+		}
+	}
+
+	printf("%s, %d failure(s)\n", failures ? "FAILED" : "PASSED", failures);
+	return failures ? 1 : 0;
+}
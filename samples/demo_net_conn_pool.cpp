@@ -0,0 +1,226 @@
+/**
+ * MIT License
+ * 
+ * Copyright © 2021 <Jerry.Yu>.
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the “Software”), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * 
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ * 
+ * @file demo_net_conn_pool.cpp
+ * @brief 本地回显服务器，验证连接池的取用与归还、空闲回收、健康检查失败重建与随机退避重连
+ * @author Jerry.Yu (jerry.yu512@outlook.com)
+ * @version 1.0.0
+ * @date 2026-10-17
+ * 
+ * @copyright MIT License
+ * 
+ */
+#include "brsdk/log/logging.hpp"
+#include "brsdk/net/event/connection_pool.hpp"
+#include "brsdk/net/event/connector.hpp"
+#include "brsdk/net/event/tcp_server.hpp"
+#include "brsdk/net/event/event_loop.hpp"
+#include <stdio.h>
+#include <algorithm>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace brsdk;
+using namespace brsdk::net;
+
+using std::placeholders::_1;
+using std::placeholders::_2;
+using std::placeholders::_3;
+
+static int failures = 0;
+
+static void check(bool ok, const std::string& what) {
+	printf("%-4s %s\n", ok ? "ok" : "FAIL", what.c_str());
+	if (!ok) {
+		failures++;
+	}
+}
+
+// 回显服务器，可以关闭后在同一地址重新启动
+class EchoServer {
+public:
+	EchoServer(EventLoop* loop, const Address& addr) : loop_(loop), addr_(addr) {}
+
+	void start(void) {
+		server_.reset(new TcpServer(loop_, addr_, "EchoServer"));
+		server_->SetMessageCallback(std::bind(&EchoServer::OnMessage, this, _1, _2, _3));
+		server_->start();
+	}
+	// 关闭监听与全部连接
+	void stop(void) { server_.reset(); }
+
+private:
+	void OnMessage(const TcpConnectionPtr& conn, NetBuffer* buf, Timestamp) {
+		conn->send(buf->retrieve_all_string());
+	}
+
+	EventLoop* loop_;
+	Address addr_;
+	std::unique_ptr<TcpServer> server_;
+};
+
+// 一个连接池及其连接建立的时间
+struct PoolProbe {
+	std::unique_ptr<TcpConnectionPool> pool;
+	std::vector<Timestamp> ups;	///< 每次连接建立的时间
+};
+
+// 创建连接池并记录连接建立的时间，由调用者启动
+static void make_pool(EventLoop* loop, const Address& server, const std::string& name,
+					  const TcpConnectionPool::Options& options, PoolProbe* probe) {
+	probe->pool.reset(new TcpConnectionPool(loop, server, name, options));
+	probe->pool->SetConnectionCallback([probe](const TcpConnectionPtr& conn) {
+		if (conn->connected()) {
+			probe->ups.push_back(Timestamp::now());
+		}
+	});
+}
+
+int main(int argc, char* argv[]) {
+	Logger::setLogLevel(Logger::ERROR);
+
+	EventLoop loop;
+	Address addr("127.0.0.1", 19710);
+	EchoServer server(&loop, addr);
+	server.start();
+
+	// 退避间隔的随机范围
+	std::set<int> delays;
+	bool in_range = true;
+	for (int i = 0; i < 1000; i++) {
+		int delay = Connector::JitterDelay(400);
+		in_range = in_range && delay >= 200 && delay <= 400;
+		delays.insert(delay);
+	}
+	check(in_range && delays.size() > 50, "jitter delay spread over [200, 400] ms: "
+		  + std::to_string(delays.size()) + " distinct values");
+
+	TcpConnectionPool::Options options;
+	options.min_connections = 1;
+	options.max_connections = 3;
+	options.idle_timeout = 0.5;
+	options.reconnect_min_ms = 100;
+	options.reconnect_max_ms = 400;
+	options.health_check_interval = 0.5;
+
+	TcpConnectionPtr sick;
+	int health_checks = 0;
+	PoolProbe main_probe;
+	make_pool(&loop, addr, "Pool", options, &main_probe);
+	TcpConnectionPool* pool = main_probe.pool.get();
+	pool->SetHealthCheck([&](const TcpConnectionPtr& conn) {
+		health_checks++;
+		return conn != sick;
+	});
+	pool->start();
+
+	// 同时重连的连接池，上游恢复后的重连时间应当错开
+	std::vector<PoolProbe> herd(8);
+	for (size_t i = 0; i < herd.size(); i++) {
+		make_pool(&loop, addr, "Herd" + std::to_string(i), options, &herd[i]);
+		herd[i].pool->start();
+	}
+
+	TcpConnectionPtr first;
+	loop.RunAfter(0.3, [&] {
+		check(pool->size() == 1 && pool->connected_count() == 1, "min_connections established on start");
+		// 唯一的连接已有在途请求，第二次取用仍返回它并在后台扩充
+		first = pool->acquire();
+		TcpConnectionPtr second = pool->acquire();
+		check(first && first == second && pool->size() == 2, "busy pool grows in the background");
+	});
+
+	loop.RunAfter(0.6, [&] {
+		TcpConnectionPtr third = pool->acquire();
+		check(pool->connected_count() == 2 && third && third != first,
+			  "acquire picks the connection with the fewest outstanding requests");
+		TcpConnectionPtr fourth = pool->acquire();
+		check(fourth == third, "ties go to the first idle connection");
+		pool->release(first);
+		pool->release(first);
+		pool->release(third);
+		pool->release(fourth);
+		// 已经不在池中的连接忽略
+		pool->release(TcpConnectionPtr());
+	});
+
+	// 维护定时器每秒一次，空闲超过0.5秒且多于最少连接数的连接被关闭
+	loop.RunAfter(2.3, [&] {
+		check(pool->size() == 1 && pool->connected_count() == 1, "idle connection above min_connections evicted");
+		sick = pool->acquire();
+		pool->release(sick);
+	});
+
+	// 健康检查失败的连接被关闭，同一位置重连
+	size_t ups = 0;
+	loop.RunAfter(3.5, [&] {
+		TcpConnectionPtr conn = pool->acquire();
+		check(health_checks > 0 && conn && conn != sick && !sick->connected() && pool->size() == 1,
+			  "unhealthy connection closed and rebuilt: " + std::to_string(health_checks) + " checks");
+		pool->release(conn);
+		sick.reset();
+
+		// 上游关闭，全部连接池开始退避重连
+		ups = main_probe.ups.size();
+		server.stop();
+	});
+
+	Timestamp restarted;
+	loop.RunAfter(3.8, [&] {
+		check(pool->connected_count() == 0 && !pool->acquire(), "no connection while upstream is down");
+	});
+	loop.RunAfter(4.5, [&] {
+		restarted = Timestamp::now();
+		server.start();
+	});
+
+	loop.RunAfter(5.5, [&] {
+		check(pool->connected_count() == 1 && main_probe.ups.size() == ups + 1, "reconnected after upstream restart");
+
+		int reconnected = 0;
+		Timestamp earliest, latest;
+		for (PoolProbe& probe : herd) {
+			if (probe.pool->connected_count() == 1 && restarted < probe.ups.back()) {
+				reconnected++;
+				Timestamp up = probe.ups.back();
+				if (!earliest.valid() || up < earliest) {
+					earliest = up;
+				}
+				if (!latest.valid() || latest < up) {
+					latest = up;
+				}
+			}
+		}
+		double spread = reconnected > 0 ? timeDifference(latest, earliest) * 1000 : 0;
+		check(reconnected == static_cast<int>(herd.size()) && spread > 10,
+			  std::to_string(reconnected) + " pools reconnected, spread over " + std::to_string(static_cast<int>(spread))
+			  + " ms");
+
+		// 析构时关闭已建立的连接
+		herd.clear();
+		main_probe.pool.reset();
+		loop.quit();
+	});
+	loop.loop();
+
+	printf("%s, %d failure(s)\n", failures ? "FAILED" : "PASSED", failures);
+	return failures ? 1 : 0;
+}
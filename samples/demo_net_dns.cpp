@@ -0,0 +1,356 @@
+/**
+ * MIT License
+ * 
+ * Copyright © 2021 <Jerry.Yu>.
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the “Software”), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * 
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ * 
+ * @file demo_net_dns.cpp
+ * @brief 本地模拟dns服务器，验证解析器的合并、重发、应答校验、否定缓存与A/AAAA合并
+ * @author Jerry.Yu (jerry.yu512@outlook.com)
+ * @version 1.0.0
+ * @date 2026-10-17
+ * 
+ * @copyright MIT License
+ * 
+ */
+#include "brsdk/log/logging.hpp"
+#include "brsdk/net/event/dns_resolver.hpp"
+#include "brsdk/net/event/udp_server.hpp"
+#include "brsdk/net/event/event_loop.hpp"
+#include "brsdk/protocol/dns.hpp"
+#include <stdio.h>
+#include <string.h>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace brsdk;
+using namespace brsdk::net;
+
+using std::placeholders::_1;
+using std::placeholders::_2;
+using std::placeholders::_3;
+
+static int failures = 0;
+
+static void check(bool ok, const std::string& what) {
+	printf("%-4s %s\n", ok ? "ok" : "FAIL", what.c_str());
+	if (!ok) {
+		failures++;
+	}
+}
+
+// 应答中的一条地址记录
+struct Answer {
+	uint16_t type;		///< A/AAAA
+	std::string data;	///< 网络序地址
+};
+
+static Answer ipv4(uint8_t a, uint8_t b, uint8_t c, uint8_t d) {
+	Answer answer;
+	answer.type = BRSDK_DNS_TYPE_A;
+	answer.data.push_back(static_cast<char>(a));
+	answer.data.push_back(static_cast<char>(b));
+	answer.data.push_back(static_cast<char>(c));
+	answer.data.push_back(static_cast<char>(d));
+	return answer;
+}
+
+static Answer ipv6(uint8_t last) {
+	Answer answer;
+	answer.type = BRSDK_DNS_TYPE_AAAA;
+	answer.data.assign(16, '\0');
+	answer.data[0] = 0x20;
+	answer.data[1] = 0x01;
+	answer.data[15] = static_cast<char>(last);
+	return answer;
+}
+
+/**
+ * @brief 模拟的递归解析服务器，按域名构造应答
+ * @details
+ * - www.example.com  A与AAAA都有地址
+ * - slow.test        延迟应答，并发解析应合并为一次查询
+ * - flaky.test       丢弃第一次查询，解析器超时后用新的事务ID重发
+ * - late.test        第一次查询的应答迟到且地址不同，重发的应答稍后到达，迟到的旧应答应被丢弃
+ * - spoof.test       先发送事务ID错误、问题不一致的应答，再发送正确应答
+ * - nx.test          NXDOMAIN
+ * - nodata.test      域名存在但没有地址记录
+ * - fail.test        SERVFAIL，不缓存
+ * - short.test       TTL为1秒
+ * - 其他             不应答
+ */
+class FakeNameServer {
+public:
+	FakeNameServer(EventLoop* loop, const Address& addr)
+	: loop_(loop), server_(loop, addr, "FakeNameServer") {
+		server_.SetMessageCallback(std::bind(&FakeNameServer::OnMessage, this, _1, _2, _3));
+	}
+
+	void start(void) { server_.start(); }
+
+	// 收到的查询数，key为"域名/A"或者"域名/AAAA"
+	int queries(const std::string& key) const {
+		auto it = ids_.find(key);
+		return it == ids_.end() ? 0 : static_cast<int>(it->second.size());
+	}
+	// 收到的查询的事务ID
+	const std::vector<uint16_t>& ids(const std::string& key) { return ids_[key]; }
+
+private:
+	void OnMessage(const str::StringPiece& datagram, const Address& peer, Timestamp) {
+		char buf[512];
+		if (datagram.size() > static_cast<int>(sizeof(buf))) {
+			return;
+		}
+		::memcpy(buf, datagram.data(), datagram.size());
+		protocol::dns_t query;
+		if (protocol::dns_unpack(buf, datagram.size(), &query) < 0) {
+			return;
+		}
+		if (1 == query.hdr.nquestion) {
+			handle(query, peer);
+		}
+		protocol::dns_free(&query);
+	}
+
+	void handle(const protocol::dns_t& query, const Address& peer) {
+		std::string name = query.questions[0].name;
+		uint16_t type = query.questions[0].rtype;
+		uint16_t id = query.hdr.transaction_id;
+		bool v4 = BRSDK_DNS_TYPE_A == type;
+		std::vector<uint16_t>& ids = ids_[name + (v4 ? "/A" : "/AAAA")];
+		ids.push_back(id);
+
+		std::vector<Answer> both;
+		if (v4) {
+			both.push_back(ipv4(10, 0, 0, 1));
+			both.push_back(ipv4(10, 0, 0, 2));
+		} else {
+			both.push_back(ipv6(1));
+		}
+
+		if ("www.example.com" == name) {
+			reply(query, id, name, 0, both, 60, peer, 0);
+		} else if ("slow.test" == name) {
+			reply(query, id, name, 0, both, 60, peer, 0.1);
+		} else if ("flaky.test" == name) {
+			if (ids.size() > 1) {
+				reply(query, id, name, 0, both, 60, peer, 0);
+			}
+		} else if ("late.test" == name) {
+			// 第一次的应答在重发之后、重发的应答之前到达
+			if (1 == ids.size()) {
+				reply(query, id, name, 0, std::vector<Answer>(1, ipv4(10, 9, 9, 9)), 60, peer, 0.25);
+			} else if (v4) {
+				reply(query, id, name, 0, std::vector<Answer>(1, ipv4(10, 0, 0, 5)), 60, peer, 0.1);
+			} else {
+				reply(query, id, name, 0, std::vector<Answer>(), 60, peer, 0.1);
+			}
+		} else if ("spoof.test" == name) {
+			std::vector<Answer> forged(1, ipv4(10, 6, 6, 6));
+			reply(query, static_cast<uint16_t>(id ^ 0x5a5a), name, 0, forged, 60, peer, 0);
+			reply(query, id, "evil.test", 0, forged, 60, peer, 0);
+			reply(query, id, name, 0, v4 ? std::vector<Answer>(1, ipv4(10, 0, 0, 6)) : std::vector<Answer>(),
+				  60, peer, 0);
+		} else if ("nx.test" == name) {
+			reply(query, id, name, 3, std::vector<Answer>(), 0, peer, 0);
+		} else if ("nodata.test" == name) {
+			reply(query, id, name, 0, std::vector<Answer>(), 0, peer, 0);
+		} else if ("fail.test" == name) {
+			reply(query, id, name, 2, std::vector<Answer>(), 0, peer, 0);
+		} else if ("short.test" == name) {
+			reply(query, id, name, 0, v4 ? std::vector<Answer>(1, ipv4(10, 0, 0, 7)) : std::vector<Answer>(),
+				  1, peer, 0);
+		}
+	}
+
+	// 按查询构造应答，id与name可以与查询不同，delay大于0时延迟发送
+	void reply(const protocol::dns_t& query, uint16_t id, const std::string& name, uint8_t rcode,
+			   const std::vector<Answer>& answers, uint32_t ttl, const Address& peer, double delay) {
+		protocol::dns_rr_t question;
+		::memset(&question, 0, sizeof(question));
+		::strncpy(question.name, name.c_str(), sizeof(question.name) - 1);
+		question.rtype = query.questions[0].rtype;
+		question.rclass = BRSDK_DNS_CLASS_IN;
+
+		std::vector<protocol::dns_rr_t> records(answers.size());
+		for (size_t i = 0; i < answers.size(); i++) {
+			records[i] = question;
+			records[i].rtype = answers[i].type;
+			records[i].ttl = ttl;
+			records[i].datalen = static_cast<uint16_t>(answers[i].data.size());
+			records[i].data = const_cast<char*>(answers[i].data.data());
+		}
+
+		protocol::dns_t response;
+		::memset(&response, 0, sizeof(response));
+		response.hdr = query.hdr;
+		response.hdr.transaction_id = id;
+		response.hdr.qr = 1;
+		response.hdr.ra = 1;
+		response.hdr.rcode = rcode;
+		response.hdr.nquestion = 1;
+		response.hdr.nanswer = static_cast<uint16_t>(records.size());
+		response.hdr.nauthority = 0;
+		response.hdr.naddtional = 0;
+		response.questions = &question;
+		response.answers = records.empty() ? nullptr : &records[0];
+
+		char buf[512];
+		int len = protocol::dns_pack(&response, buf, sizeof(buf));
+		if (len <= 0) {
+			return;
+		}
+		std::string message(buf, len);
+		if (delay > 0) {
+			loop_->RunAfter(delay, [this, message, peer] { server_.SendTo(message, peer); });
+		} else {
+			server_.SendTo(message, peer);
+		}
+	}
+
+	EventLoop* loop_;
+	UdpServer server_;
+	std::map<std::string, std::vector<uint16_t>> ids_;	///< 每个问题收到的事务ID
+};
+
+// 一次解析的结果
+struct Result {
+	int calls = 0;
+	DnsResolver::Error error = DnsResolver::kOk;
+	std::vector<Address> addrs;
+};
+
+static std::string describe(const Result& result) {
+	std::string out = DnsResolver::ErrorString(result.error);
+	for (const Address& addr : result.addrs) {
+		out += " " + addr.ipport();
+	}
+	return out;
+}
+
+int main(int argc, char* argv[]) {
+	Logger::setLogLevel(Logger::ERROR);
+
+	EventLoop loop;
+	Address nameserver("127.0.0.1", 19700);
+	FakeNameServer server(&loop, nameserver);
+	server.start();
+
+	DnsResolver::Options options;
+	options.timeout = 0.2;
+	options.attempts = 2;
+	std::unique_ptr<DnsResolver> resolver(new DnsResolver(&loop, nameserver, options));
+
+	std::map<std::string, Result> results;
+	auto resolve = [&](const std::string& tag, const std::string& name, uint16_t port) {
+		resolver->resolve(name, port, [&results, tag](DnsResolver::Error error, const std::vector<Address>& addrs) {
+			Result& result = results[tag];
+			result.calls++;
+			result.error = error;
+			result.addrs = addrs;
+		});
+	};
+
+	loop.RunAfter(0.05, [&] {
+		resolve("www", "www.example.com", 443);
+		for (int i = 0; i < 10; i++) {
+			resolve("slow" + std::to_string(i), i % 2 ? "SLOW.test." : "slow.test", 80);
+		}
+		resolve("flaky", "flaky.test", 80);
+		resolve("late", "late.test", 80);
+		resolve("spoof", "spoof.test", 80);
+		resolve("nx", "nx.test", 80);
+		resolve("nodata", "nodata.test", 80);
+		resolve("fail", "fail.test", 80);
+		resolve("short", "short.test", 80);
+		resolve("silent", "silent.test", 80);
+	});
+
+	uint64_t queries = 0;
+	loop.RunAfter(1.0, [&] {
+		const Result& www = results["www"];
+		check(www.calls == 1 && www.error == DnsResolver::kOk && www.addrs.size() == 3
+			  && www.addrs[0].ipport() == "10.0.0.1:443" && www.addrs[1].ipport() == "10.0.0.2:443"
+			  && www.addrs[2].family() == AF_INET6 && www.addrs[2].port() == 443,
+			  "A/AAAA merged, IPv4 first: " + describe(www));
+
+		int slow = 0;
+		for (int i = 0; i < 10; i++) {
+			const Result& result = results["slow" + std::to_string(i)];
+			slow += result.calls == 1 && result.addrs.size() == 3;
+		}
+		check(slow == 10 && server.queries("slow.test/A") == 1 && server.queries("slow.test/AAAA") == 1
+			  && resolver->coalesced() >= 9,
+			  "10 concurrent lookups coalesced into one query per type");
+
+		const std::vector<uint16_t>& flaky = server.ids("flaky.test/A");
+		check(results["flaky"].error == DnsResolver::kOk && flaky.size() == 2 && flaky[0] != flaky[1],
+			  "dropped query retried with a new transaction id: " + describe(results["flaky"]));
+
+		const Result& late = results["late"];
+		check(late.error == DnsResolver::kOk && late.addrs.size() == 1 && late.addrs[0].ip() == "10.0.0.5",
+			  "late reply to the first transaction id ignored: " + describe(late));
+
+		const Result& spoof = results["spoof"];
+		check(spoof.error == DnsResolver::kOk && spoof.addrs.size() == 1 && spoof.addrs[0].ip() == "10.0.0.6",
+			  "replies with wrong id or question rejected: " + describe(spoof));
+
+		check(results["nx"].error == DnsResolver::kNotFound, "NXDOMAIN: " + describe(results["nx"]));
+		check(results["nodata"].error == DnsResolver::kNotFound, "NODATA: " + describe(results["nodata"]));
+		check(results["fail"].error == DnsResolver::kServerFailure, "SERVFAIL: " + describe(results["fail"]));
+		check(results["silent"].error == DnsResolver::kTimeout && server.queries("silent.test/A") == options.attempts,
+			  "no reply times out after every attempt: " + describe(results["silent"]));
+
+		// 肯定与否定应答都从缓存返回，服务器错误不缓存
+		queries = resolver->queries();
+		resolve("www2", "WWW.Example.com", 8080);
+		resolve("nx2", "nx.test", 80);
+		resolve("nodata2", "nodata.test", 80);
+		check(resolver->queries() == queries, "cached answers sent no query");
+		check(results["www2"].addrs.size() == 3 && results["www2"].addrs[0].ipport() == "10.0.0.1:8080",
+			  "cached answer uses the new port: " + describe(results["www2"]));
+		check(results["nx2"].error == DnsResolver::kNotFound && results["nodata2"].error == DnsResolver::kNotFound,
+			  "NXDOMAIN and NODATA negatively cached");
+		resolve("fail2", "fail.test", 80);
+		check(resolver->queries() == queries + 2, "SERVFAIL not cached");
+	});
+
+	// TTL过期后重新查询
+	loop.RunAfter(2.3, [&] {
+		resolve("short2", "short.test", 80);
+	});
+	loop.RunAfter(2.6, [&] {
+		check(results["short2"].error == DnsResolver::kOk && server.queries("short.test/A") == 2,
+			  "expired answer queried again: " + describe(results["short2"]));
+		printf("queries %llu, cache hits %llu, coalesced %llu\n",
+			   static_cast<unsigned long long>(resolver->queries()),
+			   static_cast<unsigned long long>(resolver->cache_hits()),
+			   static_cast<unsigned long long>(resolver->coalesced()));
+		// 析构时未完成的解析以kCanceled回调
+		resolve("canceled", "silent.test", 80);
+		resolver.reset();
+		check(results["canceled"].calls == 1 && results["canceled"].error == DnsResolver::kCanceled,
+			  "pending lookup completed on destruction: " + describe(results["canceled"]));
+		loop.quit();
+	});
+	loop.loop();
+
+	printf("%s, %d failure(s)\n", failures ? "FAILED" : "PASSED", failures);
+	return failures ? 1 : 0;
+}
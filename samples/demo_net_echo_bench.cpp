@@ -0,0 +1,199 @@
+/**
+ * MIT License
+ * 
+ * Copyright © 2021 <Jerry.Yu>.
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the “Software”), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * 
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ * 
+ * @file demo_net_echo_bench.cpp
+ * @brief 回显服务在epoll与io_uring轮询器下的吞吐对比
+ * @author Jerry.Yu (jerry.yu512@outlook.com)
+ * @version 1.0.0
+ * @date 2026-10-17
+ * 
+ * @copyright MIT License
+ * 
+ */
+#include "brsdk/log/logging.hpp"
+#include "brsdk/net/event/tcp_server.hpp"
+#include "brsdk/net/event/tcp_client.hpp"
+#include "brsdk/net/event/event_loop.hpp"
+#include "brsdk/net/event/poller_uring.hpp"
+#include "brsdk/thread/thread.hpp"
+#include "brsdk/time/timestamp.hpp"
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/resource.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace brsdk;
+using namespace brsdk::net;
+
+using std::placeholders::_1;
+using std::placeholders::_2;
+using std::placeholders::_3;
+
+// 压测参数
+struct BenchOption {
+	int connections = 64;		///< 连接数
+	int message_size = 64;		///< 单次消息大小
+	int seconds = 3;			///< 每种轮询器压测时长
+	int server_threads = 1;		///< 服务端IO线程数
+	bool metrics = false;		///< 输出服务端loop运行指标
+};
+
+static double cpu_seconds(void) {
+	struct rusage usage;
+	::getrusage(RUSAGE_SELF, &usage);
+	return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec
+		 + (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1000000.0;
+}
+
+// 服务端原样回显
+static void on_server_message(const TcpConnectionPtr& conn, NetBuffer* buf, Timestamp) {
+	conn->send(buf);
+}
+
+// 客户端统计收到的字节并回送，形成乒乓
+class PingPongClient {
+public:
+	PingPongClient(EventLoop* loop, const Address& addr, const std::string& message, int64_t* bytes)
+	: client_(loop, addr, "PingPong"), message_(message), bytes_(bytes) {
+		client_.SetConnectionCallback(std::bind(&PingPongClient::OnConnection, this, _1));
+		client_.SetMessageCallback(std::bind(&PingPongClient::OnMessage, this, _1, _2, _3));
+	}
+	void connect(void) { client_.connect(); }
+	void disconnect(void) { client_.disconnect(); }
+	// 停止回送，等待在途数据收完后再断开
+	void stop(void) { stopped_ = true; }
+
+private:
+	void OnConnection(const TcpConnectionPtr& conn) {
+		if (conn->connected()) {
+			conn->send(message_);
+		}
+	}
+	void OnMessage(const TcpConnectionPtr& conn, NetBuffer* buf, Timestamp) {
+		*bytes_ += static_cast<int64_t>(buf->readable_bytes());
+		if (stopped_) {
+			buf->retrieve_all();
+		} else {
+			conn->send(buf);
+		}
+	}
+
+	TcpClient client_;
+	std::string message_;
+	int64_t* bytes_;
+	bool stopped_ = false;
+};
+
+static void bench(const char* poller, bool edge_triggered, const BenchOption& opt, uint16_t port) {
+	// 在创建事件循环前指定轮询器
+	::setenv("BRSDK_POLLER", poller, 1);
+
+	EventLoop server_loop;
+	Address addr("127.0.0.1", port);
+	TcpServer server(&server_loop, addr, "EchoBench");
+	server.SetMessageCallback(on_server_message);
+	server.SetThreadNum(opt.server_threads);
+	server.SetEdgeTriggered(edge_triggered);
+	if (opt.metrics) {
+		server_loop.EnableMetrics();
+		server.SetThreadInitCallback([](EventLoop* loop) { loop->EnableMetrics(); });
+	}
+	server.start();
+
+	int64_t bytes = 0;
+	double elapsed = 0.0;
+	thread::Thread client_thread([&] {
+		EventLoop loop;
+		std::string message(static_cast<size_t>(opt.message_size), 'x');
+		std::vector<std::unique_ptr<PingPongClient>> clients;
+		for (int i = 0; i < opt.connections; i++) {
+			clients.emplace_back(new PingPongClient(&loop, addr, message, &bytes));
+			clients.back()->connect();
+		}
+
+		// 预热一秒后开始统计
+		Timestamp start;
+		loop.RunAfter(1.0, [&] {
+			bytes = 0;
+			start = Timestamp::now();
+		});
+		loop.RunAfter(1.0 + opt.seconds, [&] {
+			elapsed = timeDifference(Timestamp::now(), start);
+			for (auto& c : clients) {
+				c->stop();
+			}
+			loop.RunAfter(0.2, [&] {
+				for (auto& c : clients) {
+					c->disconnect();
+				}
+			});
+			// 等待服务端关闭全部连接
+			loop.RunAfter(0.5, [&] { loop.quit(); });
+		});
+		loop.loop();
+		clients.clear();
+		server_loop.RunAfter(0.2, [&] { server_loop.quit(); });
+	}, "bench client");
+
+	double cpu_start = cpu_seconds();
+	client_thread.start();
+	server_loop.loop();
+	client_thread.join();
+	double cpu = cpu_seconds() - cpu_start;
+
+	double messages = static_cast<double>(bytes) / opt.message_size;
+	std::string name = std::string(poller) + (edge_triggered ? "-et" : "");
+	printf("%-12s conns %4d  msg %6d B  %12.0f msgs/s  %9.2f MiB/s  cpu %6.2f s\n",
+		   name.c_str(), opt.connections, opt.message_size, messages / elapsed,
+		   bytes / elapsed / (1024 * 1024), cpu);
+	if (opt.metrics) {
+		// loop仍在运行，直接跨线程读取
+		std::vector<EventLoop*> loops = server.threadpool()->GetAllLoops();
+		for (size_t i = 0; i < loops.size(); i++) {
+			printf("  loop %zu: %s\n", i, loops[i]->metrics()->ToString().c_str());
+		}
+	}
+}
+
+// 用法: demo_net_echo_bench [连接数] [消息大小] [秒数] [服务端线程数] [输出运行指标0/1]
+int main(int argc, char* argv[]) {
+	Logger::setLogLevel(Logger::WARN);
+	::signal(SIGPIPE, SIG_IGN);
+
+	BenchOption opt;
+	if (argc > 1) opt.connections = atoi(argv[1]);
+	if (argc > 2) opt.message_size = atoi(argv[2]);
+	if (argc > 3) opt.seconds = atoi(argv[3]);
+	if (argc > 4) opt.server_threads = atoi(argv[4]);
+	if (argc > 5) opt.metrics = atoi(argv[5]) != 0;
+
+	bench("epoll", false, opt, 18009);
+	bench("epoll", true, opt, 18010);
+	if (IoUringPoller::IsSupported()) {
+		bench("io_uring", false, opt, 18011);
+		bench("io_uring", true, opt, 18012);
+	} else {
+		printf("io_uring is not supported, skipped\n");
+	}
+
+	return 0;
+}
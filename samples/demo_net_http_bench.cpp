@@ -0,0 +1,204 @@
+/**
+ * MIT License
+ * 
+ * Copyright © 2021 <Jerry.Yu>.
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the “Software”), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * 
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ * 
+ * @file demo_net_http_bench.cpp
+ * @brief HTTP服务器压测，内置keep-alive/流水线负载生成
+ * @author Jerry.Yu (jerry.yu512@outlook.com)
+ * @version 1.0.0
+ * @date 2026-10-17
+ * 
+ * @copyright MIT License
+ * 
+ */
+#include "brsdk/log/logging.hpp"
+#include "brsdk/net/http/http_server.hpp"
+#include "brsdk/net/event/tcp_client.hpp"
+#include "brsdk/net/event/event_loop.hpp"
+#include "brsdk/net/event/loop_metrics.hpp"
+#include "brsdk/str/scan.hpp"
+#include "brsdk/thread/thread.hpp"
+#include "brsdk/time/timestamp.hpp"
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace brsdk;
+using namespace brsdk::net;
+
+using std::placeholders::_1;
+using std::placeholders::_2;
+using std::placeholders::_3;
+
+// 压测参数
+struct BenchOption {
+	int connections = 64;		///< 连接数
+	int pipeline = 1;			///< 每个连接在途请求数
+	int seconds = 3;			///< 压测时长
+	int server_threads = 1;		///< 服务端IO线程数
+	std::string path = "/";		///< 请求路径
+};
+
+// keep-alive客户端，收到应答后立即发送下一个请求，记录每个请求的延迟
+class HttpBenchClient {
+public:
+	HttpBenchClient(EventLoop* loop, const Address& addr, const std::string& request, int pipeline,
+					LatencyHistogram* latency)
+	: client_(loop, addr, "HttpBench"), request_(request), pipeline_(pipeline), latency_(latency) {
+		client_.SetConnectionCallback(std::bind(&HttpBenchClient::OnConnection, this, _1));
+		client_.SetMessageCallback(std::bind(&HttpBenchClient::OnMessage, this, _1, _2, _3));
+	}
+	void connect(void) { client_.connect(); }
+	void disconnect(void) { client_.disconnect(); }
+	// 停止发送新请求
+	void stop(void) { stopped_ = true; }
+	int64_t errors(void) const { return errors_; }
+
+private:
+	void OnConnection(const TcpConnectionPtr& conn) {
+		if (conn->connected()) {
+			for (int i = 0; i < pipeline_; i++) {
+				SendRequest(conn);
+			}
+		}
+	}
+	void SendRequest(const TcpConnectionPtr& conn) {
+		sent_.push_back(Timestamp::now().microSecondsSinceEpoch());
+		conn->send(request_);
+	}
+	void OnMessage(const TcpConnectionPtr& conn, NetBuffer* buf, Timestamp receive_time) {
+		while (!sent_.empty()) {
+			const char* end = buf->find_CRLFCRLF();
+			if (nullptr == end) {
+				break;
+			}
+			// 只处理压测服务端的应答格式，头部一定带Content-Length
+			const char* length = static_cast<const char*>(::memmem(buf->peek(), end - buf->peek(), "Content-Length: ", 16));
+			if (nullptr == length || 0 != ::memcmp(buf->peek() + 9, "200", 3)) {
+				++errors_;
+			}
+			size_t size = static_cast<size_t>(end + 4 - buf->peek()) + (length ? strtoul(length + 16, nullptr, 10) : 0);
+			if (buf->readable_bytes() < size) {
+				break;
+			}
+			buf->retrieve(size);
+			latency_->record(receive_time.microSecondsSinceEpoch() - sent_.front());
+			sent_.pop_front();
+			if (!stopped_) {
+				SendRequest(conn);
+			}
+		}
+	}
+
+	TcpClient client_;
+	std::string request_;
+	int pipeline_;
+	LatencyHistogram* latency_;
+	std::deque<int64_t> sent_;		///< 在途请求的发送时间
+	int64_t errors_ = 0;
+	bool stopped_ = false;
+};
+
+static void bench(const BenchOption& opt, uint16_t port) {
+	EventLoop server_loop;
+	Address addr("127.0.0.1", port);
+	HttpServer server(&server_loop, addr, "HttpBench");
+	server.SetThreadNum(opt.server_threads);
+	server.router()->get("/", [](const HttpRequest&, HttpResponse* resp) {
+		resp->set_content_type("text/plain");
+		resp->set_body(str::StringPiece("Hello, World!"));
+	});
+	server.router()->get("/users/:id", [](const HttpRequest& req, HttpResponse* resp) {
+		std::string body("{\"id\":\"");
+		body.append(req.param("id").data(), req.param("id").size());
+		body.append("\"}");
+		resp->set_content_type("application/json");
+		resp->set_body(std::move(body));
+	});
+	server.start();
+
+	std::string request = "GET " + opt.path + " HTTP/1.1\r\nHost: 127.0.0.1\r\nUser-Agent: bench\r\n\r\n";
+	LatencyHistogram latency;
+	LatencyHistogram::Snapshot start_snapshot;
+	LatencyHistogram::Snapshot end_snapshot;
+	int64_t errors = 0;
+	double elapsed = 0.0;
+	thread::Thread client_thread([&] {
+		EventLoop loop;
+		std::vector<std::unique_ptr<HttpBenchClient>> clients;
+		for (int i = 0; i < opt.connections; i++) {
+			clients.emplace_back(new HttpBenchClient(&loop, addr, request, opt.pipeline, &latency));
+			clients.back()->connect();
+		}
+
+		// 预热一秒后开始统计
+		Timestamp start;
+		loop.RunAfter(1.0, [&] {
+			start_snapshot = latency.snapshot();
+			start = Timestamp::now();
+		});
+		loop.RunAfter(1.0 + opt.seconds, [&] {
+			end_snapshot = latency.snapshot();
+			elapsed = timeDifference(Timestamp::now(), start);
+			for (auto& c : clients) {
+				c->stop();
+			}
+			loop.RunAfter(0.2, [&] {
+				for (auto& c : clients) {
+					errors += c->errors();
+					c->disconnect();
+				}
+			});
+			loop.RunAfter(0.5, [&] { loop.quit(); });
+		});
+		loop.loop();
+		clients.clear();
+		server_loop.RunAfter(0.2, [&] { server_loop.quit(); });
+	}, "bench client");
+
+	client_thread.start();
+	server_loop.loop();
+	client_thread.join();
+
+	LatencyHistogram::Snapshot window = end_snapshot.since(start_snapshot);
+	printf("GET %s  conns %d  pipeline %d  threads %d\n", opt.path.c_str(), opt.connections, opt.pipeline,
+		   opt.server_threads);
+	printf("  %.0f req/s  errors %lld\n", window.count() / elapsed, static_cast<long long>(errors));
+	printf("  latency us: %s\n", window.ToString().c_str());
+}
+
+// 用法: demo_net_http_bench [连接数] [流水线深度] [秒数] [服务端线程数] [路径]
+int main(int argc, char* argv[]) {
+	Logger::setLogLevel(Logger::WARN);
+	::signal(SIGPIPE, SIG_IGN);
+
+	BenchOption opt;
+	if (argc > 1) opt.connections = atoi(argv[1]);
+	if (argc > 2) opt.pipeline = atoi(argv[2]);
+	if (argc > 3) opt.seconds = atoi(argv[3]);
+	if (argc > 4) opt.server_threads = atoi(argv[4]);
+	if (argc > 5) opt.path = argv[5];
+
+	bench(opt, 18080);
+	return 0;
+}
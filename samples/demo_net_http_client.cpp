@@ -0,0 +1,235 @@
+/**
+ * MIT License
+ * 
+ * Copyright © 2021 <Jerry.Yu>.
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the “Software”), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * 
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ * 
+ * @file demo_net_http_client.cpp
+ * @brief 本地http服务器，验证http客户端的连接池、流水线、chunked与HEAD应答、超时、连接被拒绝与空闲回收
+ * @author Jerry.Yu (jerry.yu512@outlook.com)
+ * @version 1.0.0
+ * @date 2026-10-17
+ * 
+ * @copyright MIT License
+ * 
+ */
+#include "brsdk/log/logging.hpp"
+#include "brsdk/net/http/http_client.hpp"
+#include "brsdk/net/http/http_server.hpp"
+#include "brsdk/net/event/tcp_server.hpp"
+#include "brsdk/net/event/event_loop.hpp"
+#include <signal.h>
+#include <stdio.h>
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace brsdk;
+using namespace brsdk::net;
+
+using std::placeholders::_1;
+using std::placeholders::_2;
+using std::placeholders::_3;
+
+static int failures = 0;
+
+static void check(bool ok, const std::string& what) {
+	printf("%-4s %s\n", ok ? "ok" : "FAIL", what.c_str());
+	if (!ok) {
+		failures++;
+	}
+}
+
+/**
+ * @brief 攒批应答的服务器，记录同一连接上同时在途的请求数
+ * @details 收到请求后等待20毫秒再按顺序应答全部在途请求，body为请求目标
+ */
+class BatchServer {
+public:
+	BatchServer(EventLoop* loop, const Address& addr)
+	: loop_(loop), server_(loop, addr, "BatchServer"), flushing_(false), max_outstanding_(0) {
+		server_.SetMessageCallback(std::bind(&BatchServer::OnMessage, this, _1, _2, _3));
+	}
+
+	void start(void) { server_.start(); }
+
+	size_t max_outstanding(void) const { return max_outstanding_; }
+
+private:
+	void OnMessage(const TcpConnectionPtr& conn, NetBuffer* buf, Timestamp) {
+		for (;;) {
+			std::string data(buf->peek(), buf->readable_bytes());
+			size_t end = data.find("\r\n\r\n");
+			if (std::string::npos == end) {
+				break;
+			}
+			// 请求行"GET target HTTP/1.1"
+			size_t begin = data.find(' ') + 1;
+			pending_.push_back(data.substr(begin, data.find(' ', begin) - begin));
+			buf->retrieve(end + 4);
+		}
+		conn_ = conn;
+		max_outstanding_ = std::max(max_outstanding_, pending_.size());
+		if (!flushing_ && !pending_.empty()) {
+			flushing_ = true;
+			loop_->RunAfter(0.02, std::bind(&BatchServer::flush, this));
+		}
+	}
+
+	void flush(void) {
+		flushing_ = false;
+		std::string out;
+		for (const std::string& target : pending_) {
+			out += "HTTP/1.1 200 OK\r\nContent-Length: " + std::to_string(target.size()) + "\r\n\r\n" + target;
+		}
+		pending_.clear();
+		conn_->send(out);
+	}
+
+	EventLoop* loop_;
+	TcpServer server_;
+	TcpConnectionPtr conn_;					///< 最近收到请求的连接
+	std::vector<std::string> pending_;		///< 在途请求的目标
+	bool flushing_;							///< 已安排应答
+	size_t max_outstanding_;				///< 最多同时在途的请求数
+};
+
+int main(int argc, char* argv[]) {
+	::signal(SIGPIPE, SIG_IGN);
+	Logger::setLogLevel(Logger::ERROR);
+
+	EventLoop loop;
+	Address web_addr("127.0.0.1", 19720);
+	HttpServer web(&loop, web_addr, "WebServer");
+	web.router()->get("/users/:id", [](const HttpRequest& request, HttpResponse* response) {
+		response->set_body("user=" + request.param("id").as_string());
+	});
+	web.router()->get("/chunk", [](const HttpRequest&, HttpResponse* response) {
+		response->AppendChunk("hello");
+		response->AppendChunk(" world");
+	});
+	web.start();
+
+	Address batch_addr("127.0.0.1", 19721);
+	BatchServer batch(&loop, batch_addr);
+	batch.start();
+
+	// 接受连接但从不应答
+	Address mute_addr("127.0.0.1", 19722);
+	TcpServer mute(&loop, mute_addr, "MuteServer");
+	mute.SetMessageCallback([](const TcpConnectionPtr&, NetBuffer* buf, Timestamp) { buf->retrieve_all(); });
+	mute.start();
+
+	// 没有监听的地址
+	Address refused_addr("127.0.0.1", 19729);
+
+	std::unique_ptr<HttpClient> client(new HttpClient(&loop, "Client"));
+	client->SetMaxConnections(4);
+	client->SetTimeout(0.3);
+	client->SetIdleTimeout(0.5);
+
+	std::unique_ptr<HttpClient> pipelined(new HttpClient(&loop, "Pipelined"));
+	pipelined->SetMaxConnections(1);
+	pipelined->SetPipelineDepth(16);
+
+	int users_ok = 0;
+	size_t pipelined_ok = 0;
+	size_t pipelined_next = 0;
+	std::string chunk_body;
+	std::string head_result;
+	std::vector<HttpClient::Error> mute_errors;
+	HttpClient::Error refused_error = HttpClient::kOk;
+	Timestamp refused_at;
+	loop.RunAfter(0.05, [&] {
+		for (int i = 0; i < 100; i++) {
+			std::string expected = "user=" + std::to_string(i);
+			client->get(web_addr, "/users/" + std::to_string(i),
+						[&users_ok, expected](HttpClient::Error error, const HttpClientResponse& response) {
+				users_ok += error == HttpClient::kOk && response.status() == 200 && response.body() == expected;
+			});
+		}
+		check(client->connection_count() == 4, "100 requests open max_connections connections");
+
+		client->get(web_addr, "/chunk", [&](HttpClient::Error error, const HttpClientResponse& response) {
+			chunk_body = error == HttpClient::kOk ? response.body().as_string() : "error";
+		});
+		client->request(web_addr, HttpRequest::kHead, "/users/1", str::StringPiece(),
+						[&](HttpClient::Error error, const HttpClientResponse& response) {
+			head_result = std::to_string(error) + " " + std::to_string(response.status()) + " length "
+						  + response.header("content-length").as_string() + " body "
+						  + std::to_string(response.body().size());
+		});
+
+		// 同一连接上最多16个在途请求，应答按发送顺序回调
+		for (size_t i = 0; i < 64; i++) {
+			std::string target = "/n/" + std::to_string(i);
+			pipelined->get(batch_addr, target, [&, i, target](HttpClient::Error error, const HttpClientResponse& response) {
+				pipelined_ok += error == HttpClient::kOk && response.body() == target && i == pipelined_next;
+				pipelined_next++;
+			});
+		}
+
+		for (int i = 0; i < 2; i++) {
+			client->get(mute_addr, "/", [&](HttpClient::Error error, const HttpClientResponse&) {
+				mute_errors.push_back(error);
+			});
+		}
+		client->get(refused_addr, "/", [&](HttpClient::Error error, const HttpClientResponse&) {
+			refused_error = error;
+			refused_at = Timestamp::now();
+		});
+	});
+
+	Timestamp start = Timestamp::now();
+	loop.RunAfter(0.2, [&] {
+		check(refused_error == HttpClient::kConnectFailed && timeDifference(refused_at, start) < 0.2,
+			  "refused connect fails the queued request before its timeout");
+	});
+
+	loop.RunAfter(0.6, [&] {
+		check(users_ok == 100, std::to_string(users_ok) + " of 100 pooled requests answered");
+		check(chunk_body == "hello world", "chunked body decoded: " + chunk_body);
+		check(head_result == "0 200 length 6 body 0", "HEAD response has no body: " + head_result);
+		check(pipelined_ok == 64 && pipelined->connection_count() == 1 && batch.max_outstanding() == 16,
+			  std::to_string(pipelined_ok) + " of 64 pipelined requests in order, at most "
+			  + std::to_string(batch.max_outstanding()) + " in flight");
+		check(mute_errors.size() == 2 && mute_errors[0] == HttpClient::kTimeout && mute_errors[1] == HttpClient::kTimeout,
+			  "unanswered requests time out");
+		check(client->connection_count() == 4, "timed out connections closed, pooled connections kept");
+	});
+
+	// 空闲检查每秒一次，空闲超过0.5秒的连接被关闭
+	int again = -1;
+	loop.RunAfter(2.2, [&] {
+		check(client->connection_count() == 0, "idle connections evicted");
+		client->get(web_addr, "/users/7", [&](HttpClient::Error error, const HttpClientResponse& response) {
+			again = error == HttpClient::kOk && response.body() == "user=7";
+		});
+	});
+
+	loop.RunAfter(2.5, [&] {
+		check(again == 1 && client->connection_count() == 1, "new connection after eviction");
+		// 析构时关闭全部连接，未完成的请求不再回调
+		client.reset();
+		pipelined.reset();
+		loop.quit();
+	});
+	loop.loop();
+
+	printf("%s, %d failure(s)\n", failures ? "FAILED" : "PASSED", failures);
+	return failures ? 1 : 0;
+}
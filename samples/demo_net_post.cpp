@@ -0,0 +1,97 @@
+/**
+ * MIT License
+ * 
+ * Copyright © 2021 <Jerry.Yu>.
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the “Software”), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * 
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ * 
+ * @file demo_net_post.cpp
+ * @brief EventLoop跨线程投递回调性能测试
+ * @author Jerry.Yu (jerry.yu512@outlook.com)
+ * @version 1.0.0
+ * @date 2026-10-17
+ * 
+ * @copyright MIT License
+ * 
+ */
+#include "brsdk/log/logging.hpp"
+#include "brsdk/net/event/event_loop.hpp"
+#include "brsdk/net/event/event_loop_thread.hpp"
+#include "brsdk/lock/countdownlatch.hpp"
+#include "brsdk/time/timestamp.hpp"
+#include <stdio.h>
+#include <stdlib.h>
+#include <thread>
+#include <vector>
+
+using namespace brsdk;
+using namespace brsdk::net;
+
+// 每个生产者线程投递的回调数
+static const int kPostsPerProducer = 200000;
+
+// loop线程内计数，不需要原子操作
+static int64_t g_executed = 0;
+
+static void bench(EventLoop* loop, int producers) {
+	const int64_t total = static_cast<int64_t>(producers) * kPostsPerProducer;
+	CountDownLatch done(1);
+	CountDownLatch ready(producers);
+	CountDownLatch go(1);
+
+	loop->RunInLoop([] { g_executed = 0; });
+
+	std::vector<std::thread> threads;
+	for (int i = 0; i < producers; i++) {
+		threads.emplace_back([&] {
+			ready.countDown();
+			go.wait();
+			for (int k = 0; k < kPostsPerProducer; k++) {
+				loop->QueueInLoop([&done, total] {
+					if (++g_executed == total) {
+						done.countDown();
+					}
+				});
+			}
+		});
+	}
+
+	ready.wait();
+	Timestamp start(Timestamp::now());
+	go.countDown();
+	done.wait();
+	double seconds = timeDifference(Timestamp::now(), start);
+
+	for (auto& t : threads) {
+		t.join();
+	}
+
+	printf("producers %3d  posts %10ld  %8.3f s  %12.0f posts/s\n",
+		   producers, total, seconds, total / seconds);
+}
+
+int main(int argc, char* argv[]) {
+	Logger::setLogLevel(Logger::WARN);
+
+	int max_producers = argc > 1 ? atoi(argv[1]) : 32;
+	EventLoopThread loop_thread;
+	EventLoop* loop = loop_thread.StartLoop();
+
+	for (int producers = 1; producers <= max_producers; producers *= 2) {
+		bench(loop, producers);
+	}
+
+	return 0;
+}
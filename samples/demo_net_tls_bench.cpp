@@ -0,0 +1,170 @@
+/**
+ * MIT License
+ *
+ * Copyright © 2021 <Jerry.Yu>.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the “Software”), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * @file demo_net_tls_bench.cpp
+ * @brief TLS握手压测，对比完整握手与会话恢复
+ * @author Jerry.Yu (jerry.yu512@outlook.com)
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright MIT License
+ *
+ */
+#include "brsdk/log/logging.hpp"
+#include "brsdk/net/event/tls.hpp"
+#include "brsdk/net/event/tcp_server.hpp"
+#include "brsdk/net/event/tcp_client.hpp"
+#include "brsdk/net/event/event_loop.hpp"
+#include "brsdk/thread/thread.hpp"
+#include "brsdk/time/timestamp.hpp"
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace brsdk;
+using namespace brsdk::net;
+
+using std::placeholders::_1;
+using std::placeholders::_2;
+using std::placeholders::_3;
+
+// 压测参数
+struct BenchOption {
+	std::string crt_file;		///< 服务端证书
+	std::string key_file;		///< 服务端私钥
+	int connections = 16;		///< 并发连接数
+	int seconds = 3;			///< 每轮压测时长
+	int server_threads = 1;		///< 服务端IO线程数
+};
+
+// 短连接客户端：握手完成后发送一个字节，收到回显即关闭，关闭后立即重连
+class TlsBenchClient {
+public:
+	TlsBenchClient(EventLoop* loop, const Address& addr, const std::shared_ptr<TlsContext>& ctx)
+	: client_(loop, addr, "TlsBench") {
+		client_.EnableTls(ctx, "localhost");
+		client_.EnableRetry();
+		client_.SetConnectionCallback(std::bind(&TlsBenchClient::OnConnection, this, _1));
+		client_.SetMessageCallback(std::bind(&TlsBenchClient::OnMessage, this, _1, _2, _3));
+	}
+	void connect(void) { client_.connect(); }
+	void disconnect(void) { client_.disconnect(); }
+
+private:
+	void OnConnection(const TcpConnectionPtr& conn) {
+		if (conn->connected()) {
+			conn->send("x", 1);
+		}
+	}
+	void OnMessage(const TcpConnectionPtr& conn, NetBuffer* buf, Timestamp) {
+		buf->retrieve_all();
+		conn->shutdown();
+	}
+
+	TcpClient client_;
+};
+
+static void bench(const BenchOption& opt, uint16_t port, bool resume) {
+	TlsContext::Options server_opt;
+	server_opt.crt_file = opt.crt_file;
+	server_opt.key_file = opt.key_file;
+	std::shared_ptr<TlsContext> server_ctx = TlsContext::NewServer(server_opt);
+	TlsContext::Options client_opt;
+	client_opt.session_cache_size = resume ? 1024 : 0;
+	std::shared_ptr<TlsContext> client_ctx = TlsContext::NewClient(client_opt);
+	if (!server_ctx || !client_ctx) {
+		printf("create tls context failed\n");
+		return;
+	}
+
+	EventLoop server_loop;
+	Address addr("127.0.0.1", port);
+	TcpServer server(&server_loop, addr, "TlsBench");
+	server.SetThreadNum(opt.server_threads);
+	server.EnableTls(server_ctx);
+	server.SetMessageCallback([](const TcpConnectionPtr& conn, NetBuffer* buf, Timestamp) { conn->send(buf); });
+	server.start();
+
+	uint64_t handshakes = 0;
+	uint64_t resumed = 0;
+	double elapsed = 0.0;
+	thread::Thread client_thread([&] {
+		EventLoop loop;
+		std::vector<std::unique_ptr<TlsBenchClient>> clients;
+		for (int i = 0; i < opt.connections; i++) {
+			clients.emplace_back(new TlsBenchClient(&loop, addr, client_ctx));
+			clients.back()->connect();
+		}
+
+		// 预热一秒后开始统计
+		Timestamp start;
+		uint64_t start_handshakes = 0;
+		uint64_t start_resumed = 0;
+		loop.RunAfter(1.0, [&] {
+			start = Timestamp::now();
+			start_handshakes = server_ctx->handshakes();
+			start_resumed = server_ctx->resumed();
+		});
+		loop.RunAfter(1.0 + opt.seconds, [&] {
+			elapsed = timeDifference(Timestamp::now(), start);
+			handshakes = server_ctx->handshakes() - start_handshakes;
+			resumed = server_ctx->resumed() - start_resumed;
+			for (auto& c : clients) {
+				c->disconnect();
+			}
+			loop.RunAfter(0.5, [&] { loop.quit(); });
+		});
+		loop.loop();
+		clients.clear();
+		server_loop.RunAfter(0.2, [&] { server_loop.quit(); });
+	}, "bench client");
+
+	client_thread.start();
+	server_loop.loop();
+	client_thread.join();
+
+	printf("%s  conns %d  threads %d\n", resume ? "resumption" : "full handshake", opt.connections,
+		   opt.server_threads);
+	printf("  %.0f handshakes/s  resumed %.1f%%\n", handshakes / elapsed,
+		   handshakes > 0 ? 100.0 * resumed / handshakes : 0.0);
+}
+
+// 用法: demo_net_tls_bench 证书 私钥 [连接数] [秒数] [服务端线程数]
+int main(int argc, char* argv[]) {
+	Logger::setLogLevel(Logger::WARN);
+	::signal(SIGPIPE, SIG_IGN);
+
+	if (argc < 3) {
+		printf("usage: %s crt_file key_file [connections] [seconds] [server_threads]\n", argv[0]);
+		return 1;
+	}
+	BenchOption opt;
+	opt.crt_file = argv[1];
+	opt.key_file = argv[2];
+	if (argc > 3) opt.connections = atoi(argv[3]);
+	if (argc > 4) opt.seconds = atoi(argv[4]);
+	if (argc > 5) opt.server_threads = atoi(argv[5]);
+
+	bench(opt, 18443, false);
+	bench(opt, 18444, true);
+	return 0;
+}
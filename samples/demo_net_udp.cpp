@@ -0,0 +1,162 @@
+/**
+ * MIT License
+ * 
+ * Copyright © 2021 <Jerry.Yu>.
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the “Software”), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * 
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ * 
+ * @file demo_net_udp.cpp
+ * @brief udp回显服务，对比逐个收发、批量收发与GRO/GSO的吞吐
+ * @author Jerry.Yu (jerry.yu512@outlook.com)
+ * @version 1.0.0
+ * @date 2026-10-17
+ * 
+ * @copyright MIT License
+ * 
+ */
+#include "brsdk/log/logging.hpp"
+#include "brsdk/net/event/udp_server.hpp"
+#include "brsdk/net/event/udp_client.hpp"
+#include "brsdk/net/event/event_loop.hpp"
+#include "brsdk/net/event/event_loop_thread.hpp"
+#include "brsdk/lock/countdownlatch.hpp"
+#include <stdio.h>
+#include <stdlib.h>
+#include <memory>
+#include <string>
+
+using namespace brsdk;
+using namespace brsdk::net;
+
+using std::placeholders::_1;
+using std::placeholders::_2;
+using std::placeholders::_3;
+
+// 压测参数
+struct BenchOption {
+	size_t batch = 32;			///< 每批数据报数
+	bool offload = false;		///< GRO/GSO
+	int message_size = 64;		///< 数据报大小
+	int window = 256;			///< 在途数据报数
+	double seconds = 2;			///< 压测时长
+};
+
+// 客户端保持固定数量的在途数据报，每收到一个回显补发一个
+class PingPongClient {
+public:
+	PingPongClient(EventLoop* loop, const Address& addr, const BenchOption& option)
+	: loop_(loop), client_(loop, addr, "PingPong"), message_(option.message_size, 'u'),
+	  window_(option.window), inflight_(0), received_(0) {
+		client_.SetBatchSize(option.batch);
+		client_.SetDatagramSize(message_.size());
+		if (option.offload) {
+			client_.SetSegmentationOffload(true);
+		}
+		client_.SetMessageCallback(std::bind(&PingPongClient::OnMessage, this, _1, _2, _3));
+	}
+
+	void start(void) {
+		client_.start();
+		loop_->RunInLoop(std::bind(&PingPongClient::fill, this));
+		// 丢包后补齐在途数据报
+		loop_->RunEvery(0.05, std::bind(&PingPongClient::fill, this));
+	}
+
+	int64_t received(void) const { return received_; }
+
+private:
+	void OnMessage(const str::StringPiece& datagram, const Address&, Timestamp) {
+		received_++;
+		inflight_--;
+		client_.send(message_.data(), message_.size());
+		inflight_++;
+	}
+
+	void fill(void) {
+		if (inflight_ < window_ / 2) {
+			inflight_ = 0;
+		}
+		for (; inflight_ < window_; inflight_++) {
+			client_.send(message_.data(), message_.size());
+		}
+	}
+
+	EventLoop* loop_;
+	UdpClient client_;
+	std::string message_;
+	int window_;
+	int inflight_;
+	int64_t received_;
+};
+
+static void run(const BenchOption& option, uint16_t port) {
+	Address addr("127.0.0.1", port);
+	EventLoopThread server_thread;
+	EventLoop* server_loop = server_thread.StartLoop();
+	std::unique_ptr<UdpServer> server;
+	CountDownLatch started(1);
+
+	server_loop->RunInLoop([&] {
+		server.reset(new UdpServer(server_loop, addr, "UdpEcho"));
+		server->SetBatchSize(option.batch);
+		server->SetDatagramSize(option.message_size);
+		if (option.offload) {
+			server->SetSegmentationOffload(true);
+		}
+		// 回显在本批数据报处理完后一次发出
+		server->SetMessageCallback([&](const str::StringPiece& datagram, const Address& peer, Timestamp) {
+			server->SendTo(datagram, peer);
+		});
+		server->start();
+		started.countDown();
+	});
+	started.wait();
+
+	EventLoop loop;
+	PingPongClient client(&loop, addr, option);
+	client.start();
+	loop.RunAfter(option.seconds, std::bind(&EventLoop::quit, &loop));
+	loop.loop();
+
+	printf("batch %3zu offload %d size %5d: %10.0f msg/s\n", option.batch, option.offload,
+		   option.message_size, client.received() / option.seconds);
+
+	CountDownLatch stopped(1);
+	server_loop->RunInLoop([&] {
+		server.reset();
+		stopped.countDown();
+	});
+	stopped.wait();
+}
+
+int main(int argc, char* argv[]) {
+	Logger::setLogLevel(Logger::WARN);
+
+	BenchOption option;
+	if (argc > 1) {
+		option.message_size = atoi(argv[1]);
+	}
+
+	// 每批1个即逐个recvmsg/sendmsg
+	uint16_t port = 19600;
+	option.batch = 1;
+	run(option, port++);
+	option.batch = 32;
+	run(option, port++);
+	option.offload = true;
+	run(option, port++);
+
+	return 0;
+}
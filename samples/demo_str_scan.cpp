@@ -0,0 +1,228 @@
+/**
+ * MIT License
+ * 
+ * Copyright © 2021 <Jerry.Yu>.
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the “Software”), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * 
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ * 
+ * @file demo_str_scan.cpp
+ * @brief 分隔符查找各实现与std::search对比，以及NetBuffer续查位置在取出、前置与交换后的规则
+ * @author Jerry.Yu (jerry.yu512@outlook.com)
+ * @version 1.0.0
+ * @date 2026-10-17
+ * 
+ * @copyright MIT License
+ * 
+ */
+#include "brsdk/net/buffer.hpp"
+#include "brsdk/str/scan.hpp"
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace brsdk;
+using namespace brsdk::net;
+
+static int failures = 0;
+
+static void check(bool ok, const std::string& what) {
+	printf("%-4s %s\n", ok ? "ok" : "FAIL", what.c_str());
+	if (!ok) {
+		failures++;
+	}
+}
+
+static const char* reference(const char* begin, const char* end, const char* delim, size_t len) {
+	if (0 == len) {
+		return nullptr;
+	}
+	const char* found = std::search(begin, end, delim, delim + len);
+	return found == end ? nullptr : found;
+}
+
+// 在缓冲区可读数据中查找，与std::search对比
+static bool same(const NetBuffer& buf, const char* found, const char* delim, size_t len) {
+	return found == reference(buf.peek(), buf.begin_write(), delim, len);
+}
+
+static const char* const kDelims[] = {
+	"\r\n", "\r\n\r\n", "\n", "aa", "ab", "aab", "--b--", "\r\n\r\na", "0123456789abcdef0123456789abcdefX",
+};
+
+// 字符集很小的随机数据，分隔符与部分匹配频繁出现
+static void fill_random(std::mt19937* rng, char* data, size_t size) {
+	static const char kAlphabet[] = "\r\nab-0";
+	for (size_t i = 0; i < size; i++) {
+		data[i] = kAlphabet[(*rng)() % (sizeof(kAlphabet) - 1)];
+	}
+}
+
+// 随机长度、随机起止位置与各种分隔符，每次查找的数据单独分配，越界读取可由ASan发现
+static void compare_impl(const char* isa, std::mt19937* rng) {
+	str::FindDelimiterFunc find = str::find_delimiter_impl(isa);
+	if (nullptr == find) {
+		printf("skip %s: not supported\n", isa);
+		return;
+	}
+	long mismatches = 0;
+	long found = 0;
+	const long rounds = 200000;
+	for (long round = 0; round < rounds; round++) {
+		size_t size = (*rng)() % 300;
+		std::vector<char> data(size);
+		fill_random(rng, data.data(), size);
+		const char* delim = kDelims[(*rng)() % (sizeof(kDelims) / sizeof(kDelims[0]))];
+		size_t len = ::strlen(delim);
+		// 偶尔把分隔符放在末尾，覆盖向量循环之后的尾部
+		if (size >= len && 0 == (*rng)() % 4) {
+			::memcpy(data.data() + size - len, delim, len);
+		}
+		size_t from = size ? (*rng)() % (size + 1) : 0;
+		size_t to = from + (size > from ? (*rng)() % (size - from + 1) : 0);
+		const char* begin = data.data() + from;
+		const char* end = data.data() + to;
+		const char* expected = reference(begin, end, delim, len);
+		mismatches += find(begin, end, delim, len) != expected;
+		found += nullptr != expected;
+	}
+	check(0 == mismatches, std::string(isa) + " matches std::search in " + std::to_string(rounds) + " random searches, "
+		  + std::to_string(found) + " found");
+}
+
+// 随机追加、取出、前置、交换与换分隔符，每次查找都与std::search对比
+static void fuzz_cursor(std::mt19937* rng) {
+	NetBuffer buf;
+	NetBuffer other;
+	long mismatches = 0;
+	const long rounds = 200000;
+	for (long round = 0; round < rounds; round++) {
+		char data[64];
+		switch ((*rng)() % 8) {
+		case 0:
+		case 1:
+		case 2: {
+			size_t size = 1 + (*rng)() % sizeof(data);
+			fill_random(rng, data, size);
+			buf.append(data, size);
+			break;
+		}
+		case 3:
+			buf.retrieve((*rng)() % (buf.readable_bytes() + 1));
+			break;
+		case 4:
+			if (buf.prependable_bytes() >= 2) {
+				buf.prepend("\r\n", 2);
+			}
+			break;
+		case 5:
+			buf.swap(other);
+			break;
+		default:
+			break;
+		}
+		int which = (*rng)() % 3;
+		const char* delim = 0 == which ? "\r\n" : (1 == which ? "\r\n\r\n" : "\n");
+		const char* found = 0 == which ? buf.find_CRLF() : (1 == which ? buf.find_CRLFCRLF() : buf.find_EOL());
+		mismatches += !same(buf, found, delim, ::strlen(delim));
+		if (found && 0 == (*rng)() % 2) {
+			buf.retrieve_untill(found + ::strlen(delim));
+		}
+		if (buf.readable_bytes() > 4096) {
+			buf.retrieve_all();
+		}
+	}
+	check(0 == mismatches, "cursor matches std::search across " + std::to_string(rounds) + " random buffer operations");
+}
+
+int main(int argc, char* argv[]) {
+	printf("isa %s\n", str::scan_isa());
+	check(nullptr != str::find_delimiter_impl(str::scan_isa()) && nullptr != str::find_delimiter_impl("scalar")
+		  && nullptr == str::find_delimiter_impl("neon"),
+		  "selected and scalar implementations available, unknown ones rejected");
+
+	std::mt19937 rng(20261017);
+	compare_impl("scalar", &rng);
+	compare_impl("sse2", &rng);
+	compare_impl("avx2", &rng);
+
+	// 未找到时记录已查过的位置，追加后只查新数据，跨越两次追加的分隔符仍能找到
+	{
+		NetBuffer buf;
+		buf.append(std::string(100, 'a') + "\r");
+		bool first = nullptr == buf.find_CRLF();
+		buf.append("\n");
+		const char* found = buf.find_CRLF();
+		check(first && found == buf.peek() + 100, "delimiter split across appends found");
+	}
+
+	// 取出后续查位置随可读数据前移
+	{
+		NetBuffer buf;
+		buf.append(std::string(50, 'a') + "\r\n" + std::string(50, 'b'));
+		buf.retrieve_untill(buf.find_CRLF() + 2);
+		bool none = nullptr == buf.find_CRLF();
+		buf.retrieve(20);
+		buf.append("\r\n");
+		check(none && same(buf, buf.find_CRLF(), "\r\n", 2) && buf.find_CRLF() == buf.peek() + 30,
+			  "retrieve shifts the cursor with the readable data");
+
+		buf.append(std::string(10, 'c'));
+		buf.retrieve(31);
+		check(same(buf, buf.find_CRLF(), "\r\n", 2), "retrieve past the cursor restarts at the new head");
+	}
+
+	// 前置的数据在已查过的位置之前，续查位置清零
+	{
+		NetBuffer buf;
+		buf.append(std::string(40, 'a'));
+		buf.retrieve(4);
+		bool none = nullptr == buf.find_CRLF();
+		buf.prepend("\r\n", 2);
+		check(none && buf.find_CRLF() == buf.peek(), "prepend resets the cursor");
+	}
+
+	// 续查位置随数据一起交换
+	{
+		NetBuffer scanned;
+		scanned.append(std::string(64, 'a'));
+		bool none = nullptr == scanned.find_CRLF();
+		NetBuffer fresh;
+		fresh.append("\r\nxyz");
+		scanned.swap(fresh);
+		check(none && scanned.find_CRLF() == scanned.peek() && nullptr == fresh.find_CRLF(),
+			  "swap exchanges the cursor with the data");
+		fresh.append("\r\n");
+		check(fresh.find_CRLF() == fresh.peek() + 64, "swapped cursor resumes on its own data");
+	}
+
+	// 换用不同的分隔符从头查找
+	{
+		NetBuffer buf;
+		buf.append("a\nb\r\n");
+		const char* crlf = buf.find_CRLF();
+		const char* eol = buf.find_EOL();
+		const char* crlfcrlf = buf.find_CRLFCRLF();
+		check(crlf == buf.peek() + 3 && eol == buf.peek() + 1 && nullptr == crlfcrlf,
+			  "another delimiter searches from the head");
+	}
+
+	fuzz_cursor(&rng);
+
+	printf("%s, %d failure(s)\n", failures ? "FAILED" : "PASSED", failures);
+	return failures ? 1 : 0;
+}